@@ -1,20 +1,31 @@
+#include <format>
 #include <iostream>
 
 #include "app/application.h"
 #include "core/engine.h"
+#include "core/static_bus.h"
 #include "input/keyboard.h"
 #include "input/mouse.h"
 #include "platform/window.h"
 
 using namespace hecate;
 
-class HecateApplication :
-	public Application,
-	public MessageHandler<input::Keyboard::OnKeyPressed>,
-	//public MessageHandler<input::Mouse::OnMoved>,
-	public MessageHandler<input::Mouse::OnScroll>,
-	public MessageHandler<input::Mouse::OnButtonPressed>,
-	public MessageHandler<input::Mouse::OnDoubleClick>
+class HecateApplication;
+
+// the input events are routed directly to the application, without going through the dynamic handler lists
+using AppBus = StaticBus<
+	MessageList<
+		input::Keyboard::OnKeyPressed,
+		//input::Mouse::OnMoved,
+		input::Mouse::OnScroll,
+		input::Mouse::OnButtonPressed,
+		input::Mouse::OnDoubleClick
+	>,
+	HecateApplication
+>;
+
+class HecateApplication final :
+	public Application
 {
 public:
 	HecateApplication():
@@ -24,6 +35,10 @@ public:
 
 	bool init() override {
 		g_Log << "Initializing application";
+
+		AppBus::bind(this);
+		subscribe<&input::Keyboard::OnKeyPressed::key>(&m_CloseOnEscape, input::Keyboard::e_Key::escape);
+
 		return true;
 	}
 
@@ -32,12 +47,12 @@ public:
 
 	void shutdown() override {
 		g_Log << "Application shutting down";
+
+		AppBus::unbind(this);
+		unsubscribe<&input::Keyboard::OnKeyPressed::key>(&m_CloseOnEscape, input::Keyboard::e_Key::escape);
 	}
 
 	void operator()(const input::Keyboard::OnKeyPressed& kp) {
-		if (kp.key == input::Keyboard::e_Key::escape)
-			kp.win->close();
-
 		g_Log << "Key pressed: " << kp.key;
 	}
 
@@ -56,6 +71,17 @@ public:
 	void operator()(const input::Mouse::OnDoubleClick& dc) {
 		g_Log << "Double " << dc.m_Button;
 	}
+
+private:
+	// only receives escape key presses
+	struct CloseOnEscape {
+		void operator()(const input::Keyboard::OnKeyPressed& kp) {
+			if (kp.win)
+				kp.win->close();
+			else
+				Engine::instance().stop(); // replayed input has no window
+		}
+	} m_CloseOnEscape;
 };
 
 int main() {
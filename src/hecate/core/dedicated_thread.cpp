@@ -0,0 +1,95 @@
+#include "dedicated_thread.h"
+#include "system.h"
+#include "logger.h"
+#include "profiler.h"
+
+#include <chrono>
+#include <exception>
+#include <utility>
+
+namespace hecate {
+	DedicatedThread::DedicatedThread(
+		System*       system,
+		ErrorCallback on_error
+	):
+		m_System (system),
+		m_OnError(std::move(on_error)),
+		m_Thread ([this](std::stop_token token) { run(token); })
+	{
+	}
+
+	DedicatedThread::~DedicatedThread() {
+		request_stop();
+		join();
+	}
+
+	void DedicatedThread::request_stop() {
+		m_Thread.request_stop();
+	}
+
+	void DedicatedThread::join() {
+		if (m_Thread.joinable())
+			m_Thread.join();
+	}
+
+	System* DedicatedThread::get_system() const noexcept {
+		return m_System;
+	}
+
+	std::thread::id DedicatedThread::get_id() const noexcept {
+		return m_Thread.get_id();
+	}
+
+	void DedicatedThread::run(std::stop_token token) {
+		using Clock = std::chrono::steady_clock;
+
+		Profiler::instance().set_thread_name(m_System->get_name());
+
+		const char*  zone_name = Profiler::instance().intern(m_System->get_name());
+		const double tick_rate = m_System->get_tick_rate();
+		const auto   period    = (tick_rate > 0) ?
+			std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / tick_rate)) :
+			Clock::duration::zero();
+
+		auto next_tick = Clock::now();
+
+		while (!token.stop_requested()) {
+			try {
+				HECATE_PROFILE_SCOPE(zone_name);
+
+				m_System->get_mailbox().drain();
+				m_System->update();
+			}
+			catch (const std::exception& ex) {
+				g_LogError << "Exception in dedicated update of " << m_System->get_name() << ": " << ex.what();
+
+				if (m_OnError)
+					m_OnError();
+
+				break;
+			}
+			catch (...) {
+				g_LogError << "Unknown exception in dedicated update of " << m_System->get_name();
+
+				if (m_OnError)
+					m_OnError();
+
+				break;
+			}
+
+			if (period == Clock::duration::zero())
+				continue;
+
+			next_tick += period;
+
+			// don't try to catch up after a long stall
+			auto now = Clock::now();
+			if (next_tick < now)
+				next_tick = now;
+
+			// sleep until the next tick, or until a stop is requested
+			std::unique_lock lock(m_Mutex);
+			m_Condition.wait_until(lock, token, next_tick, [] { return false; });
+		}
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+namespace hecate {
+	class System;
+
+	/*
+	*	Updates a single System on its own thread at the system's tick rate, independent of the frame rate
+	*
+	*	The mailbox of the system is drained right before every update. After a stall the missed ticks
+	*	are skipped instead of caught up. Between ticks the thread waits with its stop token, so a stop
+	*	request wakes it right away. If update() throws the thread exits and the error callback is
+	*	invoked from it.
+	*/
+	class DedicatedThread {
+	public:
+		using ErrorCallback = std::function<void()>;
+
+		explicit DedicatedThread(
+			System*       system,
+			ErrorCallback on_error = {}
+		); // starts right away
+		~DedicatedThread(); // requests a stop and joins
+
+		DedicatedThread             (const DedicatedThread&) = delete;
+		DedicatedThread& operator = (const DedicatedThread&) = delete;
+		DedicatedThread             (DedicatedThread&&)      = delete;
+		DedicatedThread& operator = (DedicatedThread&&)      = delete;
+
+		void request_stop(); // doesn't wait
+		void join();         // waits until the current update (if any) has finished
+
+		[[nodiscard]] System*         get_system() const noexcept;
+		[[nodiscard]] std::thread::id get_id()     const noexcept;
+
+	private:
+		void run(std::stop_token token);
+
+		System*                     m_System = nullptr;
+		ErrorCallback               m_OnError;
+		std::mutex                  m_Mutex;
+		std::condition_variable_any m_Condition;
+		std::jthread                m_Thread; // last, so everything else exists by the time it starts
+	};
+}
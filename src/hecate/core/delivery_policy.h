@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+
+namespace hecate {
+	enum class e_Delivery {
+		immediate,  // every broadcast calls the handlers right away (default)
+		latest,     // only the last message of a frame is delivered
+		accumulate, // messages within a frame are merged via DeliveryPolicy<T>::accumulate
+		bounded     // queued up to DeliveryPolicy<T>::k_Capacity per frame, the oldest are dropped beyond that
+	};
+
+	/*
+	*	Per message type delivery policy; specialize this next to the message type to coalesce
+	*	high-frequency events into (at most) a few deliveries per frame
+	*
+	*		template <>
+	*		struct DeliveryPolicy<OnMoved> {
+	*			static constexpr e_Delivery k_Delivery = e_Delivery::accumulate;
+	*
+	*			static void accumulate(OnMoved& pending, const OnMoved& message);
+	*		};
+	*
+	*	Anything other than immediate is delivered on the main thread at the start of the next frame,
+	*	together with the posted messages (see dispatch_posted_messages).
+	*
+	*	[NOTE] the specialization must be visible wherever the message is broadcast
+	*/
+	template <typename T>
+	struct DeliveryPolicy {
+		static constexpr e_Delivery k_Delivery = e_Delivery::immediate;
+	};
+}
@@ -1,16 +1,104 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <optional>
 #include <vector>
+#include <memory>
 #include <mutex>
-#include <functional>
+
+#include <concurrentqueue/moodycamel/concurrentqueue.h>
+
+#include "snapshot_cell.h"
+#include "../executor.h"
+#include "../../util/function.h"
 
 namespace hecate::core::detail {
+	using DispatchPosted = void(*)();
+
+	void register_posted_queue(DispatchPosted fn); // called once per message type, on the first post
+
+	template <auto t_Extract>
+	class TopicIndex;
+
+	template <typename t_Handler>
+	inline constexpr bool k_IsTopicIndex = false;
+
+	template <auto t_Extract>
+	inline constexpr bool k_IsTopicIndex<TopicIndex<t_Extract>> = true;
+
+	// Shared between a handler with an executor and the deliveries that were handed to that executor;
+	// closed on detach, which also waits for deliveries that are running at that moment
+	class DeliveryGate {
+	public:
+		template <typename t_Fn>
+		void run(const t_Fn& fn); // calls fn unless the gate was closed
+
+		void close(); // deliveries that are in progress on the calling thread itself are not waited for
+
+	private:
+		struct Running {
+			const DeliveryGate* m_Gate;
+			const Running*      m_Previous;
+		};
+
+		std::atomic<bool>     m_Open     = true;
+		std::atomic<uint32_t> m_InFlight = 0;
+
+		static thread_local const Running* t_Running; // innermost delivery on this thread
+	};
+
+	// non-owning {object, thunk} pair; calls (*object)(message)
+	template <typename t_Message>
+	struct MessageDelegate {
+		using Thunk = void(*)(void* object, const t_Message& message);
+
+		void* m_Object = nullptr;
+		Thunk m_Thunk  = nullptr;
+
+		template <typename t_Handler>
+		static MessageDelegate bind(t_Handler* handler, e_HandlerExceptions exceptions);
+
+		void operator()(const t_Message& message) const;
+
+	private:
+		template <typename t_Handler> static void invoke         (void* object, const t_Message& message);
+		template <typename t_Handler> static void invoke_trapped (void* object, const t_Message& message);
+		template <typename t_Handler> static void invoke_measured(void* object, const t_Message& message); // see message_stats.h
+	};
+
 	// A MessageHandler is either
 	//   1. an object with a callable operator that takes the message 
 	//   2. a lambda that takes the message
 	//   3. a global function that takes the message
 	//   
 	// NOTE the current implementation doesn't allow for simple detachment of lambdas
+	//
+	// Handlers are stored as {object, thunk} pairs in a contiguous array, so calling one is a single indirect
+	// call. Exceptions propagate unless the handler was attached with e_HandlerExceptions::trap, in which case
+	// the thunk also catches and logs them. Handlers that need state of their own (those with an executor)
+	// point to a util::Function that is owned by the handler list.
+	// With HECATE_MESSAGE_STATS the thunks also time the handler and count its exceptions (see message_stats.h).
+	//
+	// The list of handlers is published as an immutable, reference-counted snapshot (see SnapshotCell);
+	// attaching and detaching build a new snapshot (copy-on-write), broadcasting only reads one, so a
+	// broadcast doesn't lock, allocate or write to shared memory.
+	//
+	// NOTE handlers may detach themselves (or attach others) during a broadcast; the change takes effect
+	//      from the next broadcast onwards
+	// NOTE a broadcast that is in progress on another thread may still call a handler that was just detached
+	//
+	// Posted messages go into a lock-free multi-producer queue and are dispatched in batches by
+	// dispatch_posted_messages(); messages from a single thread keep their order, across threads there is
+	// no ordering guarantee.
+	//
+	// Message types with a DeliveryPolicy other than immediate are coalesced into m_Pending/m_Bounded instead,
+	// and delivered together with the posted messages.
+	//
+	// Handlers attached with an executor don't run inside broadcast(); the message is copied and the call
+	// is handed to the executor. Deliveries that are still pending when the handler is detached are dropped,
+	// and detach waits for deliveries that are running on other threads (see DeliveryGate), so the handler
+	// can be destroyed right after.
 
 	template <typename t_Message>
 	class MediatorQueue {
@@ -20,21 +108,57 @@ namespace hecate::core::detail {
 	public:
 		static MediatorQueue& instance();
 
-		template <typename t_Handler> void attach(t_Handler* h);
+		template <typename t_Handler> void attach(t_Handler* h, Executor executor, e_HandlerExceptions exceptions);
 		template <typename t_Handler> void detach(t_Handler* h);
 
 		void detach_all();
+		void on_detach_all(void (*fn)()); // fn is called after every detach_all(), f.e. a TopicIndex drops its subscriptions
 
 		void broadcast(const t_Message& message);
+		void post(t_Message&& message);
+		void coalesce(const t_Message& message); // according to DeliveryPolicy<t_Message>
+
+		size_t get_num_handlers() const;
+
+		static bool has_handlers() noexcept; // doesn't go through instance()
 
 	private:
-		using Mutex     = std::mutex;
-		using LockGuard = std::lock_guard<Mutex>;
-		using Handler   = std::function<void(const t_Message&)>;
+		using Mutex        = std::mutex;
+		using LockGuard    = std::lock_guard<Mutex>;
+		using Handler      = MessageDelegate<t_Message>;
+		using OwnedHandler = util::Function<void(const t_Message&)>;
+		using GatePtr      = std::shared_ptr<DeliveryGate>;
+
+		struct HandlerList {
+			std::vector<Handler>                       m_Handlers;
+			std::vector<std::shared_ptr<OwnedHandler>> m_Owned; // targets of the handlers that own their state
+
+			// only used by attach/detach (so they're not part of the snapshot that is actually used)
+			std::vector<void*>     m_SourcePtrs;
+			std::vector<GatePtr>   m_Gates;          // per handler, only set for handlers with an executor
+			std::vector<void(*)()> m_DetachAllHooks; // kept by detach_all
+		};
+
+		static constexpr size_t k_DispatchBatchSize = 64;
+
+		void dispatch(const t_Message* messages, size_t count);
+		void deliver (const t_Message* messages, size_t count); // static route + dispatch
+
+		static void dispatch_posted(); // main thread only
+
+		SnapshotCell<HandlerList, MediatorQueue> m_HandlerList;
+
+		inline static std::atomic<size_t> s_NumHandlers = 0; // follows m_HandlerList
+
+		moodycamel::ConcurrentQueue<t_Message> m_Posted;
+		std::vector<t_Message>                 m_DispatchBuffer; // only used by dispatch_posted
 
-		Mutex m_Mutex;
-		std::vector<Handler> m_Handlers;
-		std::vector<void*>   m_SourcePtrs;
+		// coalesced delivery
+		Mutex                    m_CoalesceMutex;
+		std::optional<t_Message> m_Pending;      // latest, accumulate
+		std::vector<t_Message>   m_Bounded;      // ring buffer
+		size_t                   m_BoundedHead  = 0;
+		size_t                   m_BoundedCount = 0;
 	};
 }
 
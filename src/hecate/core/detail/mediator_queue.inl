@@ -1,10 +1,115 @@
 #pragma once
 
 #include "mediator_queue.h"
+#include "static_route.h"
+#include "../delivery_policy.h"
 #include "../logger.h"
+#include "../message_stats.h"
+#include "../metrics.h"
+#include "../profiler.h"
 #include "../../util/algorithm.h"
+#include "../../util/type_name.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
 
 namespace hecate::core::detail {
+	template <typename T>
+	template <typename H>
+	MessageDelegate<T> MessageDelegate<T>::bind(H* handler, e_HandlerExceptions exceptions) {
+		MessageDelegate result;
+
+		result.m_Object = handler;
+		result.m_Thunk  = (exceptions == e_HandlerExceptions::trap) ?
+			&invoke_trapped<H> :
+			&invoke<H>;
+
+		return result;
+	}
+
+	template <typename T>
+	void MessageDelegate<T>::operator()(const T& message) const {
+		m_Thunk(m_Object, message);
+	}
+
+	template <typename T>
+	template <typename H>
+	void MessageDelegate<T>::invoke(void* object, const T& message) {
+		if constexpr (k_MessageStats)
+			invoke_measured<H>(object, message);
+		else
+			(*static_cast<H*>(object))(message);
+	}
+
+	template <typename T>
+	template <typename H>
+	void MessageDelegate<T>::invoke_trapped(void* object, const T& message) {
+		try {
+			invoke<H>(object, message);
+		}
+		catch (std::exception& ex) {
+			g_LogWarning << "Handler exception: " << ex.what();
+		}
+		catch (...) {
+			g_LogWarning << "Handler exception [unspecified]";
+		}
+	}
+
+	template <typename T>
+	template <typename H>
+	void MessageDelegate<T>::invoke_measured(void* object, const T& message) {
+		// handlers with an executor only hand off the message here and a TopicIndex passes it on to its
+		// subscribers; the actual handlers are counted and timed when they run
+		constexpr bool k_Forwarding =
+			std::is_same_v<H, util::Function<void(const T&)>> ||
+			k_IsTopicIndex<H>;
+
+		if constexpr (k_Forwarding) {
+			(*static_cast<H*>(object))(message);
+			return;
+		}
+
+		const auto& counters = get_message_counters<T>();
+
+		counters.m_HandlerCalls.add();
+
+		try {
+			if (is_handler_timing_enabled()) {
+				HandlerTimer timer(get_handler_latency<T>(*static_cast<H*>(object)));
+				(*static_cast<H*>(object))(message);
+			}
+			else
+				(*static_cast<H*>(object))(message);
+		}
+		catch (...) {
+			counters.m_Exceptions.add();
+			throw;
+		}
+	}
+
+	template <typename F>
+	void DeliveryGate::run(const F& fn) {
+		// [NOTE] m_InFlight is raised before m_Open is checked, and close() clears m_Open before it looks at
+		//        m_InFlight; so either this delivery sees the gate closed, or close() waits for it
+		m_InFlight.fetch_add(1);
+
+		struct Leave {
+			~Leave() {
+				t_Running = m_Running.m_Previous;
+				m_Gate->m_InFlight.fetch_sub(1, std::memory_order_release);
+			}
+
+			DeliveryGate* m_Gate;
+			Running       m_Running;
+		} leave { this, { this, t_Running } };
+
+		t_Running = &leave.m_Running;
+
+		if (m_Open.load())
+			fn();
+	}
+
 	template <typename T>
 	MediatorQueue<T>& MediatorQueue<T>::instance() {
 		static MediatorQueue mq; // This ends up creating a specific queue for each template instance
@@ -13,61 +118,276 @@ namespace hecate::core::detail {
 
 	template <typename T>
 	template <typename H>
-	void MediatorQueue<T>::attach(H* handler) {
-		LockGuard guard(m_Mutex);
+	void MediatorQueue<T>::attach(
+		H*                  handler,
+		Executor            executor,
+		e_HandlerExceptions exceptions
+	) {
+		Handler target = Handler::bind(handler, exceptions);
 
-		m_Handlers.push_back([handler](const T& message) {
-			try {
-				(*handler)(message);
-			}
-			catch (std::exception& ex) {
-				g_LogWarning << "Handler exception: " << ex.what();
+		m_HandlerList.modify([&](HandlerList& list) {
+			if (executor.is_immediate()) {
+				list.m_Handlers.push_back(target);
+				list.m_Gates.push_back(nullptr);
 			}
-			catch (...) {
-				g_LogWarning << "Handler exception [unspecified]";
+			else {
+				auto gate  = std::make_shared<DeliveryGate>();
+				auto owned = std::make_shared<OwnedHandler>([target, gate, executor](const T& message) {
+					executor.execute([target, gate, message] {
+						gate->run([&] { target(message); });
+					});
+				});
+
+				list.m_Handlers.push_back(Handler::bind(owned.get(), e_HandlerExceptions::propagate));
+				list.m_Owned.push_back(std::move(owned));
+				list.m_Gates.push_back(std::move(gate));
 			}
+
+			list.m_SourcePtrs.push_back(handler);
+
+			s_NumHandlers.store(list.m_Handlers.size(), std::memory_order_relaxed);
 		});
-		m_SourcePtrs.push_back(handler);
 	}
 
 	template <typename T>
 	template <typename H>
 	void MediatorQueue<T>::detach(H* handler) {
-		LockGuard guard(m_Mutex);
+		GatePtr gate;
 
-		auto it = util::find(m_SourcePtrs, handler);
+		m_HandlerList.modify([handler, &gate](HandlerList& list) {
+			auto it = util::find(list.m_SourcePtrs, handler);
 
-		if (it != std::end(m_SourcePtrs)) {
-			size_t idx = std::distance(std::cbegin(m_SourcePtrs), it);
+			if (it == std::end(list.m_SourcePtrs)) {
+				g_LogWarning << "Tried to remove an unregistered handler";
+				return;
+			}
 
-			m_SourcePtrs.erase(it);
-			m_Handlers.erase(std::begin(m_Handlers) + idx);
-		}
-		else
-			g_LogWarning << "Tried to remove an unregistered handler";
+			size_t idx = std::distance(std::cbegin(list.m_SourcePtrs), it);
+
+			if (list.m_Gates[idx]) {
+				gate = std::move(list.m_Gates[idx]);
+
+				std::erase_if(list.m_Owned, [object = list.m_Handlers[idx].m_Object](const auto& owned) {
+					return owned.get() == object;
+				});
+			}
+
+			list.m_SourcePtrs.erase(it);
+			list.m_Gates.erase(std::begin(list.m_Gates) + idx);
+			list.m_Handlers.erase(std::begin(list.m_Handlers) + idx);
+
+			s_NumHandlers.store(list.m_Handlers.size(), std::memory_order_relaxed);
+		});
+
+		// [NOTE] outside of the lock, a running delivery may attach or detach handlers itself
+		if (gate)
+			gate->close();
 	}
 
 	template <typename T>
 	void MediatorQueue<T>::detach_all() {
-		LockGuard guard(m_Mutex);
+		std::vector<GatePtr>   gates;
+		std::vector<void(*)()> hooks;
+
+		m_HandlerList.modify([&](HandlerList& list) {
+			gates = std::move(list.m_Gates);
+			hooks = list.m_DetachAllHooks;
+
+			list = HandlerList();
+			list.m_DetachAllHooks = hooks;
 
-		m_SourcePtrs.clear();
-		m_Handlers.clear();
+			s_NumHandlers.store(0, std::memory_order_relaxed);
+		});
+
+		for (auto& gate : gates)
+			if (gate)
+				gate->close();
+
+		for (auto fn : hooks)
+			fn();
+	}
+
+	template <typename T>
+	void MediatorQueue<T>::on_detach_all(void (*fn)()) {
+		m_HandlerList.modify([fn](HandlerList& list) {
+			list.m_DetachAllHooks.push_back(fn);
+		});
 	}
 
 	template <typename T>
 	void MediatorQueue<T>::broadcast(const T& message) {
-		decltype(m_Handlers) local_copy;
+		dispatch(&message, 1);
+	}
 
-		{
-			LockGuard guard(m_Mutex);
-			local_copy = m_Handlers;
+	template <typename T>
+	void MediatorQueue<T>::post(T&& message) {
+		static const bool registered = (register_posted_queue(&MediatorQueue::dispatch_posted), true);
+		(void)registered;
+
+		m_Posted.enqueue(std::move(message));
+	}
+
+	template <typename T>
+	void MediatorQueue<T>::dispatch(const T* messages, size_t count) {
+#if HECATE_PROFILING
+		static const char* zone_name = Profiler::instance().intern("broadcast " + util::get_type_name<T>());
+#endif
+		HECATE_PROFILE_SCOPE(zone_name);
+
+		// the snapshot is immutable, so handlers can safely attach/detach (typically removing themselves)
+		// while we're iterating
+		typename decltype(m_HandlerList)::Reader list(m_HandlerList);
+
+		if constexpr (k_MessageStats)
+			get_message_counters<T>().m_Broadcasts.add(count);
+
+		for (size_t i = 0; i < count; ++i)
+			for (const auto& handler : list->m_Handlers)
+				handler(messages[i]);
+	}
+
+	template <typename T>
+	void MediatorQueue<T>::coalesce(const T& message) {
+		constexpr auto k_Delivery = DeliveryPolicy<T>::k_Delivery;
+
+		static_assert(k_Delivery != e_Delivery::immediate);
+		static const bool registered = (register_posted_queue(&MediatorQueue::dispatch_posted), true);
+		(void)registered;
+
+		LockGuard guard(m_CoalesceMutex);
+
+		if constexpr (k_Delivery == e_Delivery::latest)
+			m_Pending = message;
+
+		else if constexpr (k_Delivery == e_Delivery::accumulate) {
+			if (m_Pending)
+				DeliveryPolicy<T>::accumulate(*m_Pending, message);
+			else
+				m_Pending = message;
+		}
+
+		else if constexpr (k_Delivery == e_Delivery::bounded) {
+			constexpr size_t k_Capacity = DeliveryPolicy<T>::k_Capacity;
+			static_assert(k_Capacity > 0);
+
+			if (m_BoundedCount == k_Capacity) {
+				static const auto num_dropped = Metrics::instance().get_counter("messages.dropped." + util::get_type_name<T>());
+				num_dropped.add();
+
+				// overwrite the oldest one
+				m_Bounded[m_BoundedHead] = message;
+				m_BoundedHead = (m_BoundedHead + 1) % k_Capacity;
+			}
+			else {
+				// the ring only grows while it fills up for the first time, so messages don't need a default constructor
+				size_t idx = (m_BoundedHead + m_BoundedCount) % k_Capacity;
+
+				if (idx < m_Bounded.size())
+					m_Bounded[idx] = message;
+				else
+					m_Bounded.push_back(message);
+
+				++m_BoundedCount;
+			}
 		}
+	}
+
+	template <typename T>
+	void MediatorQueue<T>::deliver(const T* messages, size_t count) {
+		bool routed = false;
 
-		// by using a local copy of the list we allow
-		// handlers to mutate the set (typically by removing 
-		// themselves from the set)
-		for (const auto& handler : local_copy)
-			handler(message);
+		for (size_t i = 0; i < count; ++i)
+			routed = StaticRoute<T>::dispatch(messages[i]);
+
+		if (!routed || has_handlers())
+			dispatch(messages, count);
+	}
+
+	template <typename T>
+	void MediatorQueue<T>::dispatch_posted() {
+		constexpr auto k_Delivery = DeliveryPolicy<T>::k_Delivery;
+
+		auto& mq = instance();
+
+		if constexpr (k_Delivery == e_Delivery::latest || k_Delivery == e_Delivery::accumulate) {
+			std::optional<T> pending;
+
+			{
+				LockGuard guard(mq.m_CoalesceMutex);
+				pending.swap(mq.m_Pending);
+			}
+
+			if (pending)
+				mq.deliver(&*pending, 1);
+
+			return;
+		}
+
+		// the buffer is kept between frames; with a nested dispatch (a handler calling
+		// dispatch_posted_messages) fall back to a temporary one
+		std::vector<T>  nested;
+		std::vector<T>& buffer = mq.m_DispatchBuffer.empty() ? mq.m_DispatchBuffer : nested;
+
+		if constexpr (k_Delivery == e_Delivery::bounded) {
+			{
+				LockGuard guard(mq.m_CoalesceMutex);
+
+				for (size_t i = 0; i < mq.m_BoundedCount; ++i)
+					buffer.push_back(mq.m_Bounded[(mq.m_BoundedHead + i) % DeliveryPolicy<T>::k_Capacity]);
+
+				mq.m_BoundedHead  = 0;
+				mq.m_BoundedCount = 0;
+			}
+
+			try {
+				mq.deliver(buffer.data(), buffer.size());
+			}
+			catch (...) {
+				buffer.clear();
+				throw;
+			}
+		}
+		else {
+			// only dispatch what was queued up to now; messages posted by handlers are delivered next time
+			size_t remaining = mq.m_Posted.size_approx();
+
+			if (remaining == 0)
+				return;
+
+			// [NOTE] dequeued into a back_inserter instead of a pre-sized buffer, so messages only need to be movable
+			buffer.reserve(k_DispatchBatchSize);
+
+			try {
+				while (remaining > 0) {
+					size_t count = mq.m_Posted.try_dequeue_bulk(std::back_inserter(buffer), std::min(remaining, k_DispatchBatchSize));
+
+					if (count == 0)
+						break;
+
+					mq.deliver(buffer.data(), count);
+					remaining -= count;
+
+					buffer.clear();
+				}
+			}
+			catch (...) {
+				buffer.clear(); // the rest of the batch is lost
+				throw;
+			}
+		}
+
+		buffer.clear(); // keeps the capacity
+	}
+
+	template <typename T>
+	bool MediatorQueue<T>::has_handlers() noexcept {
+		return s_NumHandlers.load(std::memory_order_relaxed) != 0;
+	}
+
+	template <typename T>
+	size_t MediatorQueue<T>::get_num_handlers() const {
+		return m_HandlerList.inspect([](const HandlerList& list) {
+			return list.m_Handlers.size();
+		});
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hecate::core::detail {
+	// A value that is published as immutable, reference-counted snapshots; modify() copies the current value,
+	// changes it under a lock and publishes the result, reading goes through a Reader.
+	//
+	// Every thread caches the snapshot it last used and only refreshes it when the version changes, so
+	// reading doesn't lock, allocate or write to shared memory. A Reader pins the snapshot for as long as it
+	// exists, including when a nested Reader on the same thread picks up a newer one.
+	//
+	// NOTE t_Owner only serves to give each cell its own thread-local cache, so use one cell per owner type
+
+	template <typename t_Value, typename t_Owner>
+	class SnapshotCell {
+	public:
+		class Reader {
+		public:
+			explicit Reader(SnapshotCell& cell);
+			~Reader();
+
+			Reader             (const Reader&) = delete;
+			Reader& operator = (const Reader&) = delete;
+			Reader             (Reader&&)      = delete;
+			Reader& operator = (Reader&&)      = delete;
+
+			const t_Value& operator *  () const noexcept;
+			const t_Value* operator -> () const noexcept;
+
+		private:
+			const t_Value* m_Value = nullptr;
+		};
+
+		SnapshotCell();
+
+		template <typename t_Fn> void modify (t_Fn&& fn);       // fn(t_Value&) is called under the lock
+		template <typename t_Fn> auto inspect(t_Fn&& fn) const; // fn(const t_Value&) is called under the lock
+
+	private:
+		using SnapshotPtr = std::shared_ptr<const t_Value>;
+
+		struct ThreadCache {
+			SnapshotPtr              m_Snapshot;
+			uint64_t                 m_Version = 0;
+			uint32_t                 m_Depth   = 0; // nested readers on this thread
+			std::vector<SnapshotPtr> m_Retired;     // replaced while an outer reader was still using them
+		};
+
+		const t_Value& acquire();
+
+		mutable std::mutex    m_Mutex;
+		SnapshotPtr           m_Snapshot; // guarded by m_Mutex
+		std::atomic<uint64_t> m_Version = 1;
+
+		static thread_local ThreadCache t_Cache;
+	};
+}
+
+#include "snapshot_cell.inl"
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "snapshot_cell.h"
+
+#include <utility>
+
+namespace hecate::core::detail {
+	template <typename V, typename O>
+	thread_local typename SnapshotCell<V, O>::ThreadCache SnapshotCell<V, O>::t_Cache;
+
+	template <typename V, typename O>
+	SnapshotCell<V, O>::Reader::Reader(SnapshotCell& cell):
+		m_Value(&cell.acquire())
+	{
+		++t_Cache.m_Depth;
+	}
+
+	template <typename V, typename O>
+	SnapshotCell<V, O>::Reader::~Reader() {
+		auto& cache = t_Cache;
+
+		if (--cache.m_Depth == 0)
+			cache.m_Retired.clear();
+	}
+
+	template <typename V, typename O>
+	const V& SnapshotCell<V, O>::Reader::operator * () const noexcept {
+		return *m_Value;
+	}
+
+	template <typename V, typename O>
+	const V* SnapshotCell<V, O>::Reader::operator -> () const noexcept {
+		return m_Value;
+	}
+
+	template <typename V, typename O>
+	SnapshotCell<V, O>::SnapshotCell():
+		m_Snapshot(std::make_shared<const V>())
+	{
+	}
+
+	template <typename V, typename O>
+	template <typename t_Fn>
+	void SnapshotCell<V, O>::modify(t_Fn&& fn) {
+		std::lock_guard guard(m_Mutex);
+
+		V value = *m_Snapshot;
+		fn(value);
+
+		m_Snapshot = std::make_shared<const V>(std::move(value));
+		m_Version.fetch_add(1, std::memory_order_release);
+	}
+
+	template <typename V, typename O>
+	template <typename t_Fn>
+	auto SnapshotCell<V, O>::inspect(t_Fn&& fn) const {
+		std::lock_guard guard(m_Mutex);
+		return fn(*m_Snapshot);
+	}
+
+	template <typename V, typename O>
+	const V& SnapshotCell<V, O>::acquire() {
+		auto& cache = t_Cache;
+
+		// fast path; nothing changed since this thread last looked
+		if (cache.m_Version == m_Version.load(std::memory_order_acquire)) [[likely]]
+			return *cache.m_Snapshot;
+
+		SnapshotPtr previous;
+
+		{
+			std::lock_guard guard(m_Mutex);
+
+			previous         = std::move(cache.m_Snapshot);
+			cache.m_Snapshot = m_Snapshot;
+			cache.m_Version  = m_Version.load(std::memory_order_relaxed);
+		}
+
+		// an outer reader on this thread may still be using the previous snapshot
+		if (cache.m_Depth > 0 && previous)
+			cache.m_Retired.push_back(std::move(previous));
+
+		return *cache.m_Snapshot;
+	}
+}
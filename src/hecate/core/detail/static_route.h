@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <stdexcept>
+
+namespace hecate::core::detail {
+	// Per message type hook for a StaticBus; broadcast() calls the installed function (if any) before the
+	// dynamically attached handlers. Only a single bus can route a particular message type.
+	template <typename t_Message>
+	class StaticRoute {
+	public:
+		using Fn = void(*)(const t_Message&);
+
+		static bool dispatch(const t_Message& message); // false if no route is installed
+
+		static void install  (Fn fn); // throws if a different route is already installed
+		static void uninstall(Fn fn);
+
+	private:
+		inline static std::atomic<Fn> s_Route = nullptr;
+	};
+
+	template <typename T>
+	bool StaticRoute<T>::dispatch(const T& message) {
+		Fn fn = s_Route.load(std::memory_order_acquire);
+
+		if (!fn)
+			return false;
+
+		fn(message);
+
+		return true;
+	}
+
+	template <typename T>
+	void StaticRoute<T>::install(Fn fn) {
+		Fn expected = nullptr;
+
+		if (!s_Route.compare_exchange_strong(expected, fn, std::memory_order_acq_rel) && (expected != fn))
+			throw std::logic_error("Message type is already routed through a different StaticBus");
+	}
+
+	template <typename T>
+	void StaticRoute<T>::uninstall(Fn fn) {
+		Fn expected = fn;
+		s_Route.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+
+#include "mediator_queue.h"
+#include "snapshot_cell.h"
+#include "topic_traits.h"
+#include "../../util/flat_map.h"
+
+namespace hecate::core::detail {
+	// Handlers subscribed to a particular key, where the key is extracted from the message by t_Extract
+	//
+	// The index itself is attached to the MediatorQueue of the message type as a regular handler (while it
+	// has subscriptions), and forwards each message only to the handlers registered for its key. Like the
+	// MediatorQueue, the index is published as immutable snapshots so dispatching doesn't lock.
+	// Detaching all handlers of the message type also drops every subscription.
+	//
+	// NOTE the keys are searched linearly, which is fine for the expected (small) number of distinct keys
+
+	template <auto t_Extract>
+	class TopicIndex {
+	private:
+		TopicIndex();
+
+	public:
+		using Message = TopicMessage<t_Extract>;
+		using Key     = TopicKey<t_Extract>;
+
+		static TopicIndex& instance();
+
+		template <typename t_Handler> void subscribe  (t_Handler* h, const Key& key, e_HandlerExceptions exceptions);
+		template <typename t_Handler> void unsubscribe(t_Handler* h, const Key& key);
+
+		void operator()(const Message& message);
+
+		size_t get_num_subscriptions() const;
+
+	private:
+		using Handler = MessageDelegate<Message>;
+
+		struct Subscriptions {
+			util::FlatMap<Key, std::vector<Handler>> m_Handlers;
+			size_t                                   m_Count = 0;
+		};
+
+		void clear(); // after MediatorQueue::detach_all, which already removed the index itself
+
+		SnapshotCell<Subscriptions, TopicIndex> m_Subscriptions;
+	};
+}
+
+#include "topic_index.inl"
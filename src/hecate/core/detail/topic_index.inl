@@ -0,0 +1,100 @@
+#pragma once
+
+#include "topic_index.h"
+#include "../logger.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace hecate::core::detail {
+	template <auto E>
+	TopicIndex<E>::TopicIndex() {
+		MediatorQueue<Message>::instance().on_detach_all([] {
+			instance().clear();
+		});
+	}
+
+	template <auto E>
+	TopicIndex<E>& TopicIndex<E>::instance() {
+		static TopicIndex ti;
+		return ti;
+	}
+
+	template <auto E>
+	template <typename H>
+	void TopicIndex<E>::subscribe(
+		H*                  handler,
+		const Key&          key,
+		e_HandlerExceptions exceptions
+	) {
+		m_Subscriptions.modify([&](Subscriptions& subs) {
+			if (auto* handlers = subs.m_Handlers[key])
+				handlers->push_back(Handler::bind(handler, exceptions));
+			else
+				subs.m_Handlers.assign(key, std::vector<Handler>{ Handler::bind(handler, exceptions) });
+
+			// [NOTE] this is done while holding the lock, so that it can't be reordered with a concurrent unsubscribe
+			if (subs.m_Count++ == 0)
+				MediatorQueue<Message>::instance().attach(this, Executor::immediate(), e_HandlerExceptions::propagate);
+		});
+	}
+
+	template <auto E>
+	template <typename H>
+	void TopicIndex<E>::unsubscribe(
+		H*         handler,
+		const Key& key
+	) {
+		bool found = false;
+
+		m_Subscriptions.modify([&](Subscriptions& subs) {
+			auto* handlers = subs.m_Handlers[key];
+
+			if (!handlers)
+				return;
+
+			auto it = std::find_if(std::begin(*handlers), std::end(*handlers), [handler](const Handler& h) {
+				return h.m_Object == handler;
+			});
+
+			if (it == std::end(*handlers))
+				return;
+
+			handlers->erase(it);
+
+			if (handlers->empty())
+				subs.m_Handlers.erase(key);
+
+			found = true;
+
+			if (--subs.m_Count == 0)
+				MediatorQueue<Message>::instance().detach(this);
+		});
+
+		if (!found)
+			g_LogWarning << "Tried to unsubscribe an unregistered handler";
+	}
+
+	template <auto E>
+	void TopicIndex<E>::operator()(const Message& message) {
+		typename decltype(m_Subscriptions)::Reader subs(m_Subscriptions);
+
+		if (const auto* handlers = subs->m_Handlers[std::invoke(E, message)])
+			for (const auto& handler : *handlers)
+				handler(message);
+	}
+
+	template <auto E>
+	void TopicIndex<E>::clear() {
+		m_Subscriptions.modify([](Subscriptions& subs) {
+			subs = Subscriptions();
+		});
+	}
+
+	template <auto E>
+	size_t TopicIndex<E>::get_num_subscriptions() const {
+		return m_Subscriptions.inspect([](const Subscriptions& subs) {
+			return subs.m_Count;
+		});
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <functional>
+#include <type_traits>
+
+namespace hecate::core::detail {
+	// deduces the message type from a key extractor; a data member pointer, a function taking the message,
+	// or a captureless lambda taking the message
+	template <typename F>
+	struct TopicTraits:
+		TopicTraits<decltype(&F::operator())>
+	{
+	};
+
+	template <typename K, typename M>
+	struct TopicTraits<K M::*> {
+		using Message = M;
+	};
+
+	template <typename R, typename M>
+	struct TopicTraits<R(*)(const M&)> {
+		using Message = M;
+	};
+
+	template <typename R, typename M>
+	struct TopicTraits<R(*)(const M&) noexcept> {
+		using Message = M;
+	};
+
+	template <typename R, typename C, typename M>
+	struct TopicTraits<R(C::*)(const M&) const> {
+		using Message = M;
+	};
+
+	template <typename R, typename C, typename M>
+	struct TopicTraits<R(C::*)(const M&) const noexcept> {
+		using Message = M;
+	};
+
+	template <auto t_Extract>
+	using TopicMessage = typename TopicTraits<decltype(t_Extract)>::Message;
+
+	template <auto t_Extract>
+	using TopicKey = std::remove_cvref_t<std::invoke_result_t<decltype(t_Extract), const TopicMessage<t_Extract>&>>;
+}
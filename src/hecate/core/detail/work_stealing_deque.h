@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hecate::core::detail {
+	// Chase-Lev work stealing deque, based on
+	//     "Correct and Efficient Work-Stealing for Weak Memory Models" (Le, Pop, Cohen, Nardelli 2013)
+	//
+	// The owning thread pushes and pops at the bottom (LIFO, cache friendly),
+	// any other thread may steal from the top (FIFO, oldest/largest work first)
+	//
+	// [NOTE] only pointers are stored, ownership of the pointees is up to the caller
+	// [NOTE] the buffer grows as needed; retired buffers are kept alive until destruction
+	//        because a concurrent thief may still be reading from them
+	//
+	template <typename T>
+	class WorkStealingDeque {
+	public:
+		explicit WorkStealingDeque(size_t initial_capacity = 1024); // must be a power of 2
+		~WorkStealingDeque();
+
+		WorkStealingDeque             (const WorkStealingDeque&) = delete;
+		WorkStealingDeque& operator = (const WorkStealingDeque&) = delete;
+		WorkStealingDeque             (WorkStealingDeque&&)      = delete;
+		WorkStealingDeque& operator = (WorkStealingDeque&&)      = delete;
+
+		void push(T* item); // owner thread only
+		T*   pop();         // owner thread only; returns nullptr if empty
+		T*   steal();       // any thread; returns nullptr if empty or if another thread won the race
+
+		[[nodiscard]] bool   is_empty() const noexcept;
+		[[nodiscard]] size_t size()     const noexcept; // approximate when called concurrently
+
+	private:
+		struct Buffer {
+			explicit Buffer(size_t capacity);
+
+			T*   get(int64_t index) const noexcept;
+			void put(int64_t index, T* item) noexcept;
+
+			Buffer* grow(int64_t bottom, int64_t top) const;
+
+			size_t                             m_Capacity;
+			size_t                             m_Mask;
+			std::unique_ptr<std::atomic<T*>[]> m_Slots;
+		};
+
+		static constexpr size_t k_CacheLineSize = 64;
+
+		alignas(k_CacheLineSize) std::atomic<int64_t> m_Top    = 0;
+		alignas(k_CacheLineSize) std::atomic<int64_t> m_Bottom = 0;
+		alignas(k_CacheLineSize) std::atomic<Buffer*> m_Buffer = nullptr;
+
+		std::vector<std::unique_ptr<Buffer>> m_Buffers; // current + retired buffers (owner thread only)
+	};
+}
+
+#include "work_stealing_deque.inl"
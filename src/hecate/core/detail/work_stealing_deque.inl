@@ -0,0 +1,138 @@
+#pragma once
+
+#include "work_stealing_deque.h"
+
+#include <cassert>
+
+namespace hecate::core::detail {
+	template <typename T>
+	WorkStealingDeque<T>::Buffer::Buffer(size_t capacity):
+		m_Capacity(capacity),
+		m_Mask    (capacity - 1),
+		m_Slots   (std::make_unique<std::atomic<T*>[]>(capacity))
+	{
+		assert((capacity & m_Mask) == 0); // power of 2
+	}
+
+	template <typename T>
+	T* WorkStealingDeque<T>::Buffer::get(int64_t index) const noexcept {
+		return m_Slots[static_cast<size_t>(index) & m_Mask].load(std::memory_order_relaxed);
+	}
+
+	template <typename T>
+	void WorkStealingDeque<T>::Buffer::put(int64_t index, T* item) noexcept {
+		m_Slots[static_cast<size_t>(index) & m_Mask].store(item, std::memory_order_relaxed);
+	}
+
+	template <typename T>
+	typename WorkStealingDeque<T>::Buffer* WorkStealingDeque<T>::Buffer::grow(
+		int64_t bottom,
+		int64_t top
+	) const {
+		auto* result = new Buffer(m_Capacity * 2);
+
+		for (int64_t i = top; i != bottom; ++i)
+			result->put(i, get(i));
+
+		return result;
+	}
+
+	template <typename T>
+	WorkStealingDeque<T>::WorkStealingDeque(size_t initial_capacity) {
+		m_Buffers.push_back(std::make_unique<Buffer>(initial_capacity));
+		m_Buffer.store(m_Buffers.back().get(), std::memory_order_relaxed);
+	}
+
+	template <typename T>
+	WorkStealingDeque<T>::~WorkStealingDeque() {
+	}
+
+	template <typename T>
+	void WorkStealingDeque<T>::push(T* item) {
+		int64_t b   = m_Bottom.load(std::memory_order_relaxed);
+		int64_t t   = m_Top   .load(std::memory_order_acquire);
+		Buffer* buf = m_Buffer.load(std::memory_order_relaxed);
+
+		if (b - t > static_cast<int64_t>(buf->m_Capacity) - 1) {
+			buf = buf->grow(b, t);
+			m_Buffers.emplace_back(buf);
+			m_Buffer.store(buf, std::memory_order_release);
+		}
+
+		buf->put(b, item);
+
+		// [NOTE] the original uses a release fence + relaxed store; a release store is equivalent
+		//        here and is understood by thread sanitizers
+		m_Bottom.store(b + 1, std::memory_order_release);
+	}
+
+	template <typename T>
+	T* WorkStealingDeque<T>::pop() {
+		int64_t b   = m_Bottom.load(std::memory_order_relaxed) - 1;
+		Buffer* buf = m_Buffer.load(std::memory_order_relaxed);
+
+		m_Bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		int64_t t = m_Top.load(std::memory_order_relaxed);
+
+		if (t > b) {
+			// deque was already empty
+			m_Bottom.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		T* result = buf->get(b);
+
+		if (t == b) {
+			// last item; race against thieves for it
+			if (!m_Top.compare_exchange_strong(
+				t,
+				t + 1,
+				std::memory_order_seq_cst,
+				std::memory_order_relaxed
+			))
+				result = nullptr;
+
+			m_Bottom.store(b + 1, std::memory_order_relaxed);
+		}
+
+		return result;
+	}
+
+	template <typename T>
+	T* WorkStealingDeque<T>::steal() {
+		int64_t t = m_Top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t b = m_Bottom.load(std::memory_order_acquire);
+
+		if (t >= b)
+			return nullptr;
+
+		Buffer* buf    = m_Buffer.load(std::memory_order_acquire);
+		T*      result = buf->get(t);
+
+		if (!m_Top.compare_exchange_strong(
+			t,
+			t + 1,
+			std::memory_order_seq_cst,
+			std::memory_order_relaxed
+		))
+			return nullptr; // lost the race to the owner or another thief
+
+		return result;
+	}
+
+	template <typename T>
+	bool WorkStealingDeque<T>::is_empty() const noexcept {
+		return size() == 0;
+	}
+
+	template <typename T>
+	size_t WorkStealingDeque<T>::size() const noexcept {
+		int64_t b = m_Bottom.load(std::memory_order_relaxed);
+		int64_t t = m_Top   .load(std::memory_order_relaxed);
+
+		return (b > t) ? static_cast<size_t>(b - t) : 0;
+	}
+}
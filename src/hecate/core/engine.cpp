@@ -1,6 +1,10 @@
 #include "engine.h"
 #include "logger.h"
+#include "logger/binary_log.h"
 #include "logger/log_sink.h"
+#include "logger/rotating_log_file.h"
+#include "message_stats.h"
+#include "system_startup.h"
 #include "../util/algorithm.h"
 #include "../dependencies.h"
 
@@ -12,12 +16,16 @@
 #include <stdexcept>
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <chrono>
+#include <mutex>
 
 namespace {
-	static constexpr const char* k_SettingsFilename = "hecate.json";
+	static constexpr const char* k_SettingsFilename  = "hecate.json";
+	static constexpr const char* k_EngineSettingsKey = "Engine";
 
 	bool is_satisfied(
-		hecate::System*           s,
+		hecate::System*                 s,
 		const std::vector<std::string>& already_initialized
 	) {
 		using hecate::util::contains;
@@ -48,41 +56,376 @@ namespace hecate {
 	void Engine::start() {
 		m_Running = true;
 
+		Profiler::instance().set_thread_name("Main");
+
 		// if the global logger only has 1 sink, it logs *only* to 'hecate.log'
 		if (Logger::instance().getNumSinks() < 2)
 			Logger::instance().add(core::logger::makeStdOutSink());
 
+		m_Scheduler  = std::make_unique<Scheduler>();
+		m_FrameTasks = std::make_unique<Scheduler::TaskGroup>(*m_Scheduler);
+
+		g_Log << "Started scheduler with " << m_Scheduler->get_num_workers() << " workers";
+
 		start_libraries();
 		start_systems();
+		start_dedicated_threads();
+
+		m_FramePacer.set_target_rate       (m_TargetFrameRate);
+		m_FramePacer.set_mode              (to_frame_pacer_mode(m_TimestepMode));
+		m_FramePacer.set_max_catch_up_steps(m_MaxCatchUpSteps);
+
+		g_Log << "Frame pacing: " << m_TargetFrameRate << " Hz, " << m_FramePacer.get_mode() << " timestep";
+
+		if constexpr (core::detail::k_MessageStats)
+			set_handler_timing(m_HandlerTiming);
+
+		Logger::setMinCategory(core::logger::to_log_category(m_LogLevel));
+
+		// [NOTE] the settings are only known at this point; the default log file is reconfigured in
+		//        place, so no line misses it and any other sinks stay as they are
+		if (auto file = Logger::instance().getLogFile()) {
+			auto config = file->get_config();
+
+			config.m_MaxFileSize  = static_cast<size_t>(m_LogMaxFileSize) << 20;
+			config.m_MaxFiles     = m_LogMaxFiles;
+			config.m_MaxFileAge   = std::chrono::seconds(m_LogMaxFileAge);
+			config.m_SyncInterval = std::chrono::milliseconds(m_LogSyncInterval);
+
+			file->configure(std::move(config));
+		}
+
+		if (!m_LogBinaryFile.empty()) {
+			try {
+				Logger::instance().add(core::logger::makeBinaryFileSink(m_LogBinaryFile));
+			}
+			catch (const std::runtime_error& err) {
+				g_LogWarning << err.what() << " (" << m_LogBinaryFile << ")";
+			}
+		}
+
+		if (m_LogAsync) {
+			auto overflow = core::logger::to_log_overflow(m_LogOverflow);
+
+			Logger::instance().startAsync(m_LogQueueSize, overflow);
+			Logger::installCrashHandler();
+
+			g_Log << "Asynchronous logging, queue of " << m_LogQueueSize << " records, " << overflow << " on overflow";
+		}
+
+		size_t   num_steps       = 1;
+		uint64_t frame           = 0;
+		double   last_stats_time = Platform::get_absolute_time();
+
+		static const auto frame_bytes       = Metrics::instance().get_gauge  ("memory.frame_bytes");
+		static const auto frame_allocations = Metrics::instance().get_counter("memory.frame_allocations");
+
+		if (!m_MetricsFile.empty()) {
+			m_MetricsOut.open(m_MetricsFile, std::ios::app);
+
+			if (!m_MetricsOut)
+				g_LogWarning << "Failed to open metrics file " << m_MetricsFile;
+		}
+
+		m_FramePacer.start();
 
 		while (m_Running) {
-			for (auto& system : m_Systems)
-				//if (!system->m_DedicatedThread)
-					system->update();
+			HECATE_PROFILE_SCOPE("Frame");
+
+			resume_coroutines();
+
+			{
+				HECATE_PROFILE_SCOPE("Posted messages");
+				dispatch_posted_messages();
+				m_MainMailbox.drain();
+			}
+
+			// with a fixed timestep we may need to catch up by running multiple updates in a single frame
+			for (size_t step = 0; (step < num_steps) && m_Running; ++step) {
+				if (m_FrameGraphDirty)
+					build_frame_graph();
+
+				// updates all systems and the application, running independent ones at the same time
+				m_FrameGraph.execute(*m_Scheduler);
+			}
+
+			// join everything that was forked off during this frame (the main thread helps out while waiting)
+			{
+				HECATE_PROFILE_SCOPE("Frame tasks");
+				m_FrameTasks->wait();
+			}
+
+			// all frame work has been joined, so per-frame memory can be released
+			frame_bytes.set(static_cast<double>(m_FrameAllocator.get_bytes_allocated()));
+			frame_allocations.add(m_FrameAllocator.get_num_allocations());
+
+			m_FrameAllocator.reset();
+
+			{
+				HECATE_PROFILE_SCOPE("Frame pacing");
+				num_steps = m_FramePacer.end_frame();
+			}
+
+			update_metrics(++frame);
 
-			if (m_Application)
-				m_Application->update();
+			if (m_FrameStatsInterval > 0) {
+				double now = Platform::get_absolute_time();
+
+				if (now - last_stats_time >= m_FrameStatsInterval) {
+					g_LogDebug << "Frame statistics: " << m_FramePacer.get_statistics();
+					g_LogDebug << "Frame memory: " << m_FrameAllocator.get_capacity() << " bytes in " << m_FrameAllocator.get_num_arenas() << " arenas";
+					last_stats_time = now;
+				}
+			}
 		}
 
+		g_Log << "Frame statistics: " << m_FramePacer.get_statistics();
+
+		m_MetricsOut.close();
+
+		stop_dedicated_threads();
 		stop_systems();
 		stop_libraries();
+
+		if (!m_TraceFile.empty()) {
+			if (Profiler::instance().write_chrome_trace(m_TraceFile))
+				g_Log << "Wrote profiling trace to " << m_TraceFile;
+			else
+				g_LogWarning << "Failed to write profiling trace to " << m_TraceFile;
+		}
+
+		if constexpr (core::detail::k_MessageStats) {
+			if (!m_MessageStatsFile.empty()) {
+				if (write_message_statistics(m_MessageStatsFile))
+					g_Log << "Wrote message statistics to " << m_MessageStatsFile;
+				else
+					g_LogWarning << "Failed to write message statistics to " << m_MessageStatsFile;
+			}
+		}
+
+		m_FrameTasks.reset();
+		m_Scheduler.reset();
+
+		// with the workers gone nothing can resume the remaining coroutines anymore, so it's safe to destroy them
+		m_NextFrame.clear();
+
+		if (!m_Coroutines.empty()) {
+			g_LogWarning << "Destroying " << m_Coroutines.size() << " unfinished coroutine(s)";
+			m_Coroutines.clear();
+		}
+
+		if (uint64_t num_dropped = Logger::instance().getNumDropped())
+			g_LogWarning << "Dropped " << num_dropped << " log lines";
+
+		Logger::instance().stopAsync();
+		core::logger::BinaryLog::instance().close();
 	}
 
 	void Engine::stop() {
 		m_Running = false;
 	}
 
+	Scheduler& Engine::get_scheduler() {
+		if (!m_Scheduler)
+			throw std::runtime_error("Scheduler is only available while the engine is running");
+
+		return *m_Scheduler;
+	}
+
+	Scheduler::TaskGroup& Engine::get_frame_tasks() {
+		if (!m_FrameTasks)
+			throw std::runtime_error("Frame tasks are only available while the engine is running");
+
+		return *m_FrameTasks;
+	}
+
+	Mailbox& Engine::get_main_mailbox() noexcept {
+		return m_MainMailbox;
+	}
+
+	FrameAllocator& Engine::get_frame_allocator() noexcept {
+		return m_FrameAllocator;
+	}
+
+	std::pmr::memory_resource* Engine::get_frame_resource() {
+		return m_FrameAllocator.get_resource();
+	}
+
+	double Engine::get_delta_time() const noexcept {
+		return m_FramePacer.get_delta_time();
+	}
+
+	FramePacer::Statistics Engine::get_frame_statistics() const {
+		return m_FramePacer.get_statistics();
+	}
+
+	const std::deque<Metrics::Snapshot>& Engine::get_metrics_history() const noexcept {
+		return m_MetricsSnapshots;
+	}
+
+	void Engine::write_metrics(std::ostream& os) const {
+		for (const auto& snapshot : m_MetricsSnapshots) {
+			Metrics::write_json(os, snapshot);
+			os << '\n';
+		}
+	}
+
+	void Engine::spawn(Task<> task) {
+		task.start();
+
+		if (task.is_ready()) {
+			try {
+				task.get();
+			}
+			catch (const std::exception& ex) {
+				g_LogError << "Exception in coroutine: " << ex.what();
+			}
+			catch (...) {
+				g_LogError << "Unknown exception in coroutine";
+			}
+
+			return;
+		}
+
+		std::lock_guard guard(m_CoroutineMutex);
+		m_Coroutines.push_back(std::move(task));
+	}
+
+	ResumeOnQueue Engine::next_frame() {
+		return resume_on(m_NextFrame);
+	}
+
+	ResumeOnScheduler Engine::resume_on_worker() {
+		return resume_on(get_scheduler());
+	}
+
+	void Engine::resume_coroutines() {
+		HECATE_PROFILE_SCOPE("Resume coroutines");
+
+		m_NextFrame.resume_all();
+
+		// clean up whatever has completed
+		std::lock_guard guard(m_CoroutineMutex);
+
+		std::erase_if(m_Coroutines, [](Task<>& task) {
+			if (!task.is_ready())
+				return false;
+
+			try {
+				task.get();
+			}
+			catch (const std::exception& ex) {
+				g_LogError << "Exception in coroutine: " << ex.what();
+			}
+			catch (...) {
+				g_LogError << "Unknown exception in coroutine";
+			}
+
+			return true;
+		});
+	}
+
+	void Engine::update_metrics(uint64_t frame) {
+		static const auto frame_time = Metrics::instance().get_histogram("engine.frame_time_us");
+		static const auto frames     = Metrics::instance().get_counter  ("engine.frames");
+
+		frames.add();
+		frame_time.record(static_cast<uint64_t>(m_FramePacer.get_delta_time() * 1e6));
+
+		if ((m_MetricsInterval == 0) || (frame % m_MetricsInterval != 0))
+			return;
+
+		HECATE_PROFILE_SCOPE("Metrics snapshot");
+
+		auto snapshot = Metrics::instance().take_snapshot(frame, Platform::get_absolute_time());
+
+		if (m_MetricsOut.is_open()) {
+			Metrics::write_json(m_MetricsOut, snapshot);
+			m_MetricsOut << '\n';
+		}
+
+		if (m_MetricsToLog) {
+			std::stringstream sstr;
+			Metrics::write_json(sstr, snapshot);
+
+			g_LogDebug << "Metrics: " << sstr.str();
+		}
+
+		m_MetricsSnapshots.push_back(std::move(snapshot));
+
+		while (m_MetricsSnapshots.size() > m_MetricsHistory)
+			m_MetricsSnapshots.pop_front();
+	}
+
 	void Engine::start_libraries() {
 	}
 
 	void Engine::stop_libraries() {
 	}
 
+	void Engine::start_dedicated_threads() {
+		for (const auto& ptr : m_Systems)
+			if (ptr->has_dedicated_thread()) {
+				g_Log << "Starting dedicated thread for " << ptr->get_name() << " (" << ptr->get_tick_rate() << " Hz)";
+
+				m_DedicatedThreads.push_back(std::make_unique<DedicatedThread>(ptr.get(), [this] { stop(); }));
+			}
+	}
+
+	void Engine::stop_dedicated_threads() {
+		// request all of them first so they can wind down at the same time
+		for (auto& thread : m_DedicatedThreads)
+			thread->request_stop();
+
+		m_DedicatedThreads.clear(); // joins
+	}
+
+	void Engine::build_frame_graph() {
+		std::vector<System*> systems;
+
+		// systems with a dedicated thread are updated on that thread instead
+		for (const auto& ptr : m_Systems)
+			if (!ptr->has_dedicated_thread())
+				systems.push_back(ptr.get());
+
+		m_FrameGraph.build(systems, m_Application.get());
+		m_FrameGraphDirty = false;
+
+		std::stringstream sstr;
+		sstr << m_FrameGraph;
+
+		g_LogDebug << "Frame graph:\n" << sstr.str();
+	}
+
 	void Engine::save_settings() {
 		using namespace nlohmann;
 
 		json settings;
 
+		// engine-level settings
+		settings[k_EngineSettingsKey] = {
+			{ "target_frame_rate",    m_TargetFrameRate },
+			{ "timestep_mode",        m_TimestepMode },
+			{ "max_catch_up_steps",   m_MaxCatchUpSteps },
+			{ "frame_stats_interval", m_FrameStatsInterval },
+			{ "trace_file",           m_TraceFile },
+			{ "metrics_interval",     m_MetricsInterval },
+			{ "metrics_history",      m_MetricsHistory },
+			{ "metrics_file",         m_MetricsFile },
+			{ "metrics_log",          m_MetricsToLog },
+			{ "message_stats_file",   m_MessageStatsFile },
+			{ "handler_timing",       m_HandlerTiming },
+			{ "log_level",            m_LogLevel },
+			{ "log_async",            m_LogAsync },
+			{ "log_queue_size",       m_LogQueueSize },
+			{ "log_overflow",         m_LogOverflow },
+			{ "log_binary_file",      m_LogBinaryFile },
+			{ "log_max_file_size",    m_LogMaxFileSize },
+			{ "log_max_files",        m_LogMaxFiles },
+			{ "log_max_file_age",     m_LogMaxFileAge },
+			{ "log_sync_interval",    m_LogSyncInterval }
+		};
+
 		// traverse and consolidate settings from all systems and the current application
 
 		if (m_Application) {
@@ -140,6 +483,31 @@ namespace hecate {
 			json settings;
 			in >> settings;
 
+			if (auto it = settings.find(k_EngineSettingsKey); it != settings.end()) {
+				m_TargetFrameRate    = it->value("target_frame_rate",    m_TargetFrameRate);
+				m_TimestepMode       = it->value("timestep_mode",        m_TimestepMode);
+				m_MaxCatchUpSteps    = it->value("max_catch_up_steps",   m_MaxCatchUpSteps);
+				m_FrameStatsInterval = it->value("frame_stats_interval", m_FrameStatsInterval);
+				m_TraceFile          = it->value("trace_file",           m_TraceFile);
+				m_MetricsInterval    = it->value("metrics_interval",     m_MetricsInterval);
+				m_MetricsHistory     = it->value("metrics_history",      m_MetricsHistory);
+				m_MetricsFile        = it->value("metrics_file",         m_MetricsFile);
+				m_MetricsToLog       = it->value("metrics_log",          m_MetricsToLog);
+				m_MessageStatsFile   = it->value("message_stats_file",   m_MessageStatsFile);
+				m_HandlerTiming      = it->value("handler_timing",       m_HandlerTiming);
+				m_LogLevel           = it->value("log_level",            m_LogLevel);
+				m_LogAsync           = it->value("log_async",            m_LogAsync);
+				m_LogQueueSize       = it->value("log_queue_size",       m_LogQueueSize);
+				m_LogOverflow        = it->value("log_overflow",         m_LogOverflow);
+				m_LogBinaryFile      = it->value("log_binary_file",      m_LogBinaryFile);
+				m_LogMaxFileSize     = it->value("log_max_file_size",    m_LogMaxFileSize);
+				m_LogMaxFiles        = it->value("log_max_files",        m_LogMaxFiles);
+				m_LogMaxFileAge      = it->value("log_max_file_age",     m_LogMaxFileAge);
+				m_LogSyncInterval    = it->value("log_sync_interval",    m_LogSyncInterval);
+			}
+			else
+				g_Log << "No engine settings, using default frame pacing";
+
 			for (const auto& ptr : m_Systems) {
 				auto it = settings.find(ptr->get_name());
 
@@ -172,67 +540,25 @@ namespace hecate {
 		// first try and load subsystem settings
 		load_settings();
 
-		// start subsystem initialization; keep track of (satisfied) dependencies and store the order
-		{
-			size_t current_pass_count      = 0; // number of systems initialized at the beginning of a pass
-			size_t num_systems_initialized = 0;
-			size_t num_systems             = m_Systems.size();
-
-			auto it = std::begin(m_Systems);
+		// initialize subsystems in dependency order, independent ones at the same time (see SystemStartup)
+		std::vector<System*> systems;
 
-			while (it != std::end(m_Systems)) {
-				      auto* current_system = it->get();
-				const auto& sytem_name     = current_system->get_name();
-
-				bool already_initialized = util::contains(m_InitOrder, sytem_name);
-
-				if (
-					(!already_initialized) &&
-					(is_satisfied(current_system, m_InitOrder))
-				) {
-					current_system->m_Engine = this;
-
-					if (!current_system->init())
-						throw std::runtime_error("Failed to start subsystem");
-					
-					m_InitOrder.push_back(sytem_name);
-
-					++num_systems_initialized;
-				}
-
-				++it;
-
-				// if we reached the end, see if we're actually done (or that we've stalled)
-				if (it == std::end(m_Systems)) {
-					it = std::begin(m_Systems);
-
-					if (num_systems_initialized == current_pass_count) {
-						// we've stalled, figure out which systems failed to initialize
-						g_Log << "Stalled during system initialization";
-
-						for (const auto& ptr : m_Systems)
-							if (!util::contains(m_InitOrder, sytem_name)) {
-								// try to be specific about what's missing
-								std::stringstream sstr;
-
-								sstr << "\tFailed to initialize: " << sytem_name << ", missing dependencies ";
-
-								for (const auto& dep : ptr->get_dependencies())
-									if (!util::contains(m_InitOrder, dep))
-										sstr << "'" << dep << "' ";
+		for (const auto& ptr : m_Systems) {
+			ptr->m_Engine = this;
+			systems.push_back(ptr.get());
+		}
 
-								g_Log << sstr.str();
-							}
+		SystemStartup startup;
+		startup.run(systems, *m_Scheduler); // systems that did start are shut down again if this throws
 
-						throw std::runtime_error("Stalled during system initialization");
-					}
+		for (const auto* s : startup.get_init_order())
+			m_InitOrder.push_back(s->get_name());
 
-					if (num_systems_initialized == num_systems)
-						break; // all systems were initialized
+		{
+			std::stringstream sstr;
+			sstr << startup;
 
-					current_pass_count = num_systems_initialized;
-				}
-			}
+			g_Log << sstr.str();
 		}
 
 		// finally, start the application
@@ -263,17 +589,9 @@ namespace hecate {
 			if (jt == std::end(m_Systems))
 				// somehow the system was initialized and later removed
 				g_Log << "Cannot shutdown system: " << *it;
-			else {
-				//m_DedicatedSync = false;
+			else
+				// dedicated threads have already been joined at this point
 				broadcast(RequestShutdown{ (*jt).get() });
-
-				/*// busy wait until the system was shut down
-				while (!m_DedicatedSync) {
-					using namespace std::chrono_literals;
-					std::this_thread::sleep_for(16ms);
-					std::this_thread::yield();
-				}*/
-			}
 		}
 
 		save_settings();
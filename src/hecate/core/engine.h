@@ -4,9 +4,20 @@
 #include <vector>
 #include <memory>
 #include <thread>
-#include <condition_variable>
+#include <mutex>
+#include <deque>
+#include <fstream>
 
 #include "system.h"
+#include "dedicated_thread.h"
+#include "scheduler.h"
+#include "frame_graph.h"
+#include "frame_allocator.h"
+#include "executor.h"
+#include "frame_pacer.h"
+#include "metrics.h"
+#include "profiler.h"
+#include "task.h"
 #include "../app/application.h"
 #include "../util/typemap.h"
 
@@ -49,6 +60,28 @@ namespace hecate {
 		template <c_Application T, typename... tArgs>
 		void set_application(tArgs... args);
 
+		// only available while the engine is running
+		Scheduler&            get_scheduler();
+		Scheduler::TaskGroup& get_frame_tasks(); // tasks added to this group are joined at the end of the current frame
+
+		Mailbox& get_main_mailbox() noexcept; // drained on the main thread at the start of every frame
+
+		// scratch memory that is released all at once at the end of every frame (see FrameAllocator)
+		FrameAllocator&            get_frame_allocator() noexcept;
+		std::pmr::memory_resource* get_frame_resource(); // for the calling thread, f.e. for std::pmr containers
+
+		double                 get_delta_time() const noexcept; // seconds; fixed when using a fixed timestep
+		FramePacer::Statistics get_frame_statistics() const;
+
+		// periodic snapshots of the metrics registry (main thread only)
+		const std::deque<Metrics::Snapshot>& get_metrics_history() const noexcept;
+		void                                 write_metrics(std::ostream& os) const; // one JSON object per line
+
+		// coroutine support; spawned tasks are owned by the engine until they complete (exceptions are logged)
+		void              spawn(Task<> task); // starts right away, on the calling thread
+		ResumeOnQueue     next_frame();       // co_await to continue on the main thread at the start of the next frame
+		ResumeOnScheduler resume_on_worker(); // co_await to continue on the scheduler
+
 	private:
 		void start_libraries();
 		void stop_libraries();
@@ -59,16 +92,63 @@ namespace hecate {
 		void start_systems(); // loads settings, figures out in which order to resolve dependencies
 		void stop_systems();  // saves settings, cleans up subsystems in reverse init order
 
-		std::atomic_bool m_Running = false;
+		void start_dedicated_threads(); // for systems that opted in, after all systems are initialized
+		void stop_dedicated_threads();  // blocks until all dedicated updates have finished
+
+		void build_frame_graph();
+
+		void resume_coroutines(); // once per frame, on the main thread
 
-		std::mutex                m_SystemMutex;
-		std::condition_variable   m_SystemCondition;
+		void update_metrics(uint64_t frame); // once per frame, on the main thread
+
+		std::atomic_bool m_Running = false;
 
-		std::vector<SystemPtr>    m_Systems;
-		std::vector<std::jthread> m_DedicatedThreads;
-		bool                      m_DedicatedSync = false;
-		util::TypeMap             m_SystemMap;
-		ApplicationPtr            m_Application;
+		std::unique_ptr<Scheduler>            m_Scheduler;
+		std::unique_ptr<Scheduler::TaskGroup> m_FrameTasks;
+		FrameGraph                            m_FrameGraph;
+		bool                                  m_FrameGraphDirty = true; // rebuilt when systems are added or removed
+		FrameAllocator                        m_FrameAllocator;
+		Mailbox                               m_MainMailbox;
+
+		ResumeQueue         m_NextFrame;
+		std::mutex          m_CoroutineMutex;
+		std::vector<Task<>> m_Coroutines;
+
+		// frame pacing, configured via the 'Engine' section in the settings
+		FramePacer  m_FramePacer;
+		double      m_TargetFrameRate    = 60.0;       // 0 for unlimited
+		std::string m_TimestepMode       = "variable"; // "variable" or "fixed"
+		uint32_t    m_MaxCatchUpSteps    = 4;          // fixed timestep only
+		double      m_FrameStatsInterval = 10.0;       // seconds between frame statistics in the log, 0 to disable
+
+		std::string m_TraceFile;               // if set, a Chrome trace of the recorded profiling zones is written here on shutdown
+		std::string m_MessageStatsFile;        // if set, the message statistics are written here on shutdown (see message_stats.h)
+		bool        m_HandlerTiming    = false; // measure handler latencies for the message statistics
+
+		// logging, also configured via the 'Engine' section
+		std::string m_LogLevel        = "debug"; // minimum category that is logged: "debug", "info", "warning", "error" or "fatal"
+		bool        m_LogAsync        = true;    // write the log from a background thread
+		uint32_t    m_LogQueueSize    = 8192;    // records, rounded up to a power of 2
+		std::string m_LogOverflow     = "block"; // "block", "drop" or "drop_oldest" when the queue is full
+		std::string m_LogBinaryFile;             // if set, everything is also written to this binary log (decode with hecate-logdecode)
+		uint32_t    m_LogMaxFileSize  = 64;      // MiB, hecate.log is rotated beyond this; 0 for no limit
+		uint32_t    m_LogMaxFiles     = 5;       // rotated log files that are kept
+		uint32_t    m_LogMaxFileAge   = 0;       // seconds before hecate.log is rotated, 0 to disable
+		uint32_t    m_LogSyncInterval = 1000;    // milliseconds between msyncs of the rotating log file
+
+		// metrics, also configured via the 'Engine' section
+		uint32_t    m_MetricsInterval = 60;    // frames between snapshots, 0 to disable
+		uint32_t    m_MetricsHistory  = 120;   // number of snapshots kept in memory
+		std::string m_MetricsFile;             // if set, every snapshot is appended here as a line of JSON
+		bool        m_MetricsToLog    = false; // if set, every snapshot is also logged
+
+		std::deque<Metrics::Snapshot> m_MetricsSnapshots;
+		std::ofstream                 m_MetricsOut;
+
+		std::vector<SystemPtr>                        m_Systems;
+		std::vector<std::unique_ptr<DedicatedThread>> m_DedicatedThreads;
+		util::TypeMap                                 m_SystemMap;
+		ApplicationPtr                                m_Application;
 
 		std::vector<std::string> m_InitOrder; // so that cleanup can be done in reverse
 	};
@@ -18,6 +18,8 @@ namespace hecate {
 		m_SystemMap.insert(result);
 		m_Systems.push_back(std::move(system));
 
+		m_FrameGraphDirty = true;
+
 		return result;
 	}
 
@@ -32,6 +34,8 @@ namespace hecate {
 			);
 
 			m_SystemMap.remove(system);
+
+			m_FrameGraphDirty = true;
 		}
 		else
 			throw std::runtime_error("Cannot remove subsystem that is not added to the engine");
@@ -53,5 +57,7 @@ namespace hecate {
 			m_Application = std::make_unique<T>(std::forward<tArgs...>(args...));
 		else
 			m_Application = std::make_unique<T>();
+
+		m_FrameGraphDirty = true;
 	}
 }
\ No newline at end of file
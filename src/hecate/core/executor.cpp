@@ -0,0 +1,66 @@
+#include "executor.h"
+#include "logger.h"
+#include "scheduler.h"
+
+namespace hecate {
+	void Mailbox::push(Job job) {
+		m_Jobs.enqueue(std::move(job));
+	}
+
+	size_t Mailbox::drain() {
+		// only run what was queued up to now; jobs queued by these jobs run during the next drain
+		size_t remaining = m_Jobs.size_approx();
+		size_t count     = 0;
+
+		Job job;
+
+		while ((count < remaining) && m_Jobs.try_dequeue(job)) {
+			try {
+				job();
+			}
+			catch (const std::exception& ex) {
+				g_LogWarning << "Mailbox job exception: " << ex.what();
+			}
+			catch (...) {
+				g_LogWarning << "Mailbox job exception [unspecified]";
+			}
+
+			++count;
+		}
+
+		return count;
+	}
+
+	size_t Mailbox::size_approx() const {
+		return m_Jobs.size_approx();
+	}
+
+	Executor Executor::immediate() noexcept {
+		return Executor();
+	}
+
+	Executor Executor::on(Mailbox& mailbox) noexcept {
+		Executor result;
+		result.m_Mailbox = &mailbox;
+		return result;
+	}
+
+	Executor Executor::on(Scheduler& scheduler) noexcept {
+		Executor result;
+		result.m_Scheduler = &scheduler;
+		return result;
+	}
+
+	bool Executor::is_immediate() const noexcept {
+		return !m_Mailbox && !m_Scheduler;
+	}
+
+	void Executor::execute(Mailbox::Job job) const {
+		if (m_Mailbox)
+			m_Mailbox->push(std::move(job));
+		else if (m_Scheduler)
+			m_Scheduler->submit(std::move(job));
+		else
+			job();
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+
+#include <concurrentqueue/moodycamel/concurrentqueue.h>
+
+#include "../util/function.h"
+
+namespace hecate {
+	class Scheduler;
+
+	/*
+	*	Multi-producer queue of jobs that are executed by a single owner
+	*
+	*	Anything can push into a mailbox (lock-free); the owner runs the queued jobs at a point
+	*	of its choosing with drain(). The engine owns one for the main thread, and every System
+	*	has one that is drained right before its update, on whatever thread runs that update.
+	*/
+	class Mailbox {
+	public:
+		using Job = util::Function<void()>;
+
+		Mailbox() = default;
+
+		Mailbox             (const Mailbox&) = delete;
+		Mailbox& operator = (const Mailbox&) = delete;
+		Mailbox             (Mailbox&&)      = delete;
+		Mailbox& operator = (Mailbox&&)      = delete;
+
+		void push(Job job);
+
+		size_t drain(); // runs the jobs that were queued so far, returns how many were run
+
+		[[nodiscard]] size_t size_approx() const;
+
+	private:
+		moodycamel::ConcurrentQueue<Job> m_Jobs;
+	};
+
+	/*
+	*	Where something should run; either immediately on the calling thread, via a Mailbox,
+	*	or as a task on a Scheduler (any worker)
+	*
+	*	[NOTE] this is a non-owning handle; the mailbox or scheduler must outlive it
+	*/
+	class Executor {
+	public:
+		static Executor immediate() noexcept;
+		static Executor on(Mailbox& mailbox) noexcept;
+		static Executor on(Scheduler& scheduler) noexcept;
+
+		[[nodiscard]] bool is_immediate() const noexcept;
+
+		void execute(Mailbox::Job job) const;
+
+	private:
+		Executor() = default;
+
+		Mailbox*   m_Mailbox   = nullptr;
+		Scheduler* m_Scheduler = nullptr;
+	};
+}
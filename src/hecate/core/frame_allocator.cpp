@@ -0,0 +1,102 @@
+#include "frame_allocator.h"
+
+namespace {
+	std::atomic<uint64_t> g_NextFrameAllocatorID = 1;
+
+	struct CachedArena {
+		uint64_t                       m_OwnerID = 0;
+		hecate::util::LinearAllocator* m_Arena   = nullptr;
+	};
+
+	thread_local CachedArena t_CachedArena;
+}
+
+namespace hecate {
+	FrameAllocator::FrameAllocator(size_t initial_size_per_thread):
+		m_InitialSize(initial_size_per_thread),
+		m_ID         (g_NextFrameAllocatorID.fetch_add(1, std::memory_order_relaxed))
+	{
+	}
+
+	std::pmr::memory_resource* FrameAllocator::get_resource() {
+		return get_arena();
+	}
+
+	void FrameAllocator::reset() {
+		std::lock_guard guard(m_Mutex);
+
+		for (auto& arena : m_Arenas)
+			arena.m_Allocator->reset();
+	}
+
+	size_t FrameAllocator::get_bytes_allocated() const {
+		std::lock_guard guard(m_Mutex);
+
+		size_t result = 0;
+
+		for (const auto& arena : m_Arenas)
+			result += arena.m_Allocator->get_bytes_allocated();
+
+		return result;
+	}
+
+	size_t FrameAllocator::get_num_allocations() const {
+		std::lock_guard guard(m_Mutex);
+
+		size_t result = 0;
+
+		for (const auto& arena : m_Arenas)
+			result += arena.m_Allocator->get_num_allocations();
+
+		return result;
+	}
+
+	size_t FrameAllocator::get_capacity() const {
+		std::lock_guard guard(m_Mutex);
+
+		size_t result = 0;
+
+		for (const auto& arena : m_Arenas)
+			result += arena.m_Allocator->get_capacity();
+
+		return result;
+	}
+
+	size_t FrameAllocator::get_num_arenas() const {
+		std::lock_guard guard(m_Mutex);
+
+		return m_Arenas.size();
+	}
+
+	util::LinearAllocator* FrameAllocator::get_arena() {
+		// fast path; the thread already has an arena from this allocator
+		if (t_CachedArena.m_OwnerID == m_ID)
+			return t_CachedArena.m_Arena;
+
+		return find_or_create_arena();
+	}
+
+	util::LinearAllocator* FrameAllocator::find_or_create_arena() {
+		const auto this_thread = std::this_thread::get_id();
+
+		util::LinearAllocator* result = nullptr;
+
+		{
+			std::lock_guard guard(m_Mutex);
+
+			// the cache may have been pointing at a different allocator in the meantime
+			for (const auto& arena : m_Arenas)
+				if (arena.m_Thread == this_thread)
+					result = arena.m_Allocator.get();
+
+			if (!result) {
+				m_Arenas.push_back(Arena{ this_thread, std::make_unique<util::LinearAllocator>(m_InitialSize) });
+				result = m_Arenas.back().m_Allocator.get();
+			}
+		}
+
+		t_CachedArena = CachedArena{ m_ID, result };
+
+		return result;
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "../util/linear_allocator.h"
+
+namespace hecate {
+	/*
+	*	Per-frame scratch memory, one linear arena per thread
+	*
+	*	Allocations come from the arena of the calling thread (created on first use), so there is
+	*	no contention between workers. Everything is released at once when the engine resets the
+	*	allocator at the end of the frame; nothing allocated here may be used after that.
+	*
+	*	[NOTE] only use this from work that is part of the frame (frame graph updates, frame tasks);
+	*	       dedicated threads and detached tasks can still be running while the reset happens
+	*/
+	class FrameAllocator {
+	public:
+		explicit FrameAllocator(size_t initial_size_per_thread = util::LinearAllocator::k_DefaultChunkSize);
+
+		FrameAllocator             (const FrameAllocator&) = delete;
+		FrameAllocator& operator = (const FrameAllocator&) = delete;
+		FrameAllocator             (FrameAllocator&&)      = delete;
+		FrameAllocator& operator = (FrameAllocator&&)      = delete;
+
+		std::pmr::memory_resource* get_resource(); // the arena for the calling thread
+
+		template <typename T, typename... t_Args>
+		T* create(t_Args&&... args); // destructors are not called
+
+		template <typename T>
+		requires std::is_trivially_destructible_v<T>
+		std::span<T> create_array(size_t count);
+
+		void reset(); // must not be called while other threads are allocating
+
+		[[nodiscard]] size_t get_bytes_allocated() const; // summed over all threads, since the last reset
+		[[nodiscard]] size_t get_num_allocations() const; // summed over all threads, since the last reset
+		[[nodiscard]] size_t get_capacity()        const;
+		[[nodiscard]] size_t get_num_arenas()      const;
+
+	private:
+		struct Arena {
+			std::thread::id                        m_Thread;
+			std::unique_ptr<util::LinearAllocator> m_Allocator;
+		};
+
+		util::LinearAllocator* get_arena();
+		util::LinearAllocator* find_or_create_arena();
+
+		size_t   m_InitialSize = 0;
+		uint64_t m_ID          = 0; // distinguishes instances in the thread-local lookup
+
+		mutable std::mutex m_Mutex;
+		std::vector<Arena> m_Arenas;
+	};
+}
+
+#include "frame_allocator.inl"
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "frame_allocator.h"
+
+namespace hecate {
+	template <typename T, typename... t_Args>
+	T* FrameAllocator::create(t_Args&&... args) {
+		return get_arena()->create<T>(std::forward<t_Args>(args)...);
+	}
+
+	template <typename T>
+	requires std::is_trivially_destructible_v<T>
+	std::span<T> FrameAllocator::create_array(size_t count) {
+		return get_arena()->create_array<T>(count);
+	}
+}
@@ -0,0 +1,320 @@
+#include "frame_graph.h"
+#include "system.h"
+#include "logger.h"
+#include "profiler.h"
+#include "../util/algorithm.h"
+
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace hecate {
+	void FrameGraph::build(
+		const std::vector<System*>& systems,
+		System*                     application
+	) {
+		clear();
+
+		for (auto* s : systems) {
+			auto& node = m_Nodes.emplace_back();
+
+			node.m_System      = s;
+			node.m_ProfileName = Profiler::instance().intern(s->get_name());
+			node.m_MainThread  = s->is_main_thread_only();
+		}
+
+		auto find_node = [this](const std::string& name) -> size_t {
+			for (size_t i = 0; i < m_Nodes.size(); ++i)
+				if (m_Nodes[i].m_System->get_name() == name)
+					return i;
+
+			return m_Nodes.size();
+		};
+
+		// dependency edges
+		for (size_t i = 0; i < m_Nodes.size(); ++i)
+			for (const auto& dep : m_Nodes[i].m_System->get_dependencies()) {
+				size_t j = find_node(dep);
+
+				if (j < m_Nodes.size())
+					add_edge(j, i);
+			}
+
+		// resource edges, in registration order
+		{
+			struct ResourceState {
+				size_t              m_LastWriter = ~size_t(0);
+				std::vector<size_t> m_Readers;   // since the last write
+			};
+
+			std::unordered_map<std::string, ResourceState> resources;
+
+			for (size_t i = 0; i < m_Nodes.size(); ++i)
+				for (const auto& access : m_Nodes[i].m_System->get_resource_access()) {
+					auto& state = resources[access.m_Resource];
+
+					if (state.m_LastWriter != ~size_t(0))
+						add_edge(state.m_LastWriter, i);
+
+					if (access.m_Write) {
+						for (auto reader : state.m_Readers)
+							add_edge(reader, i);
+
+						state.m_Readers.clear();
+						state.m_LastWriter = i;
+					}
+					else
+						state.m_Readers.push_back(i);
+				}
+		}
+
+		// the application goes last and stays on the main thread
+		if (application) {
+			size_t app_idx = m_Nodes.size();
+
+			auto& node = m_Nodes.emplace_back();
+
+			node.m_System      = application;
+			node.m_ProfileName = Profiler::instance().intern(application->get_name());
+			node.m_MainThread  = true;
+
+			for (size_t i = 0; i < app_idx; ++i)
+				add_edge(i, app_idx);
+		}
+
+		for (size_t i = 0; i < m_Nodes.size(); ++i)
+			if (m_Nodes[i].m_NumPredecessors == 0)
+				m_Roots.push_back(i);
+
+		check_for_cycles();
+
+		m_Pending = std::make_unique<std::atomic<size_t>[]>(m_Nodes.size());
+	}
+
+	void FrameGraph::clear() {
+		m_Nodes.clear();
+		m_Roots.clear();
+		m_Pending.reset();
+	}
+
+	void FrameGraph::execute(Scheduler& scheduler) {
+		const size_t num_nodes = m_Nodes.size();
+
+		if (num_nodes == 0)
+			return;
+
+		for (size_t i = 0; i < num_nodes; ++i)
+			m_Pending[i].store(m_Nodes[i].m_NumPredecessors, std::memory_order_relaxed);
+
+		m_NumCompleted.store(0, std::memory_order_relaxed);
+
+		Scheduler::TaskGroup group(scheduler);
+		m_Group = &group;
+
+		for (auto idx : m_Roots)
+			schedule(idx, scheduler);
+
+		// the main thread handles the main-thread-only nodes, and helps out with the rest
+		while (m_NumCompleted.load(std::memory_order_acquire) < num_nodes) {
+			size_t idx = num_nodes;
+
+			{
+				std::lock_guard guard(m_MainThreadMutex);
+
+				if (!m_MainThreadReady.empty()) {
+					idx = m_MainThreadReady.back();
+					m_MainThreadReady.pop_back();
+				}
+			}
+
+			if (idx < num_nodes)
+				run(idx, scheduler);
+			else if (!scheduler.try_execute_one())
+				std::this_thread::yield();
+		}
+
+		group.wait();
+		m_Group = nullptr;
+
+		if (m_Exception) {
+			auto ex = m_Exception;
+			m_Exception = nullptr;
+
+			std::rethrow_exception(ex);
+		}
+	}
+
+	size_t FrameGraph::get_num_nodes() const noexcept {
+		return m_Nodes.size();
+	}
+
+	std::vector<const System*> FrameGraph::get_critical_path() const {
+		// longest path through the DAG, weighted by the last measured durations
+		// (nodes are processed in topological order)
+		const size_t num_nodes = m_Nodes.size();
+
+		std::vector<size_t>   in_degree  (num_nodes);
+		std::vector<Duration> finish_time(num_nodes);
+		std::vector<size_t>   previous   (num_nodes, num_nodes);
+		std::vector<size_t>   ready      = m_Roots;
+
+		for (size_t i = 0; i < num_nodes; ++i)
+			in_degree[i] = m_Nodes[i].m_NumPredecessors;
+
+		size_t last = num_nodes;
+
+		while (!ready.empty()) {
+			size_t idx = ready.back();
+			ready.pop_back();
+
+			finish_time[idx] += m_Nodes[idx].m_LastDuration;
+
+			if ((last == num_nodes) || (finish_time[idx] > finish_time[last]))
+				last = idx;
+
+			for (auto succ : m_Nodes[idx].m_Successors) {
+				if (finish_time[idx] > finish_time[succ]) {
+					finish_time[succ] = finish_time[idx];
+					previous   [succ] = idx;
+				}
+
+				if (--in_degree[succ] == 0)
+					ready.push_back(succ);
+			}
+		}
+
+		std::vector<const System*> result;
+
+		for (size_t idx = last; idx < num_nodes; idx = previous[idx])
+			result.insert(result.begin(), m_Nodes[idx].m_System);
+
+		return result;
+	}
+
+	FrameGraph::Duration FrameGraph::get_critical_path_duration() const {
+		Duration result = {};
+
+		for (const auto* s : get_critical_path())
+			for (const auto& node : m_Nodes)
+				if (node.m_System == s)
+					result += node.m_LastDuration;
+
+		return result;
+	}
+
+	FrameGraph::Duration FrameGraph::get_total_duration() const {
+		Duration result = {};
+
+		for (const auto& node : m_Nodes)
+			result += node.m_LastDuration;
+
+		return result;
+	}
+
+	void FrameGraph::add_edge(size_t from, size_t to) {
+		if (from == to)
+			return;
+
+		auto& successors = m_Nodes[from].m_Successors;
+
+		if (!util::contains(successors, to)) {
+			successors.push_back(to);
+			++m_Nodes[to].m_NumPredecessors;
+		}
+	}
+
+	void FrameGraph::check_for_cycles() const {
+		// Kahn's algorithm; whatever doesn't get visited is part of (or blocked by) a cycle
+		const size_t num_nodes = m_Nodes.size();
+
+		std::vector<size_t> in_degree(num_nodes);
+		std::vector<size_t> ready = m_Roots;
+		size_t              num_visited = 0;
+
+		for (size_t i = 0; i < num_nodes; ++i)
+			in_degree[i] = m_Nodes[i].m_NumPredecessors;
+
+		while (!ready.empty()) {
+			size_t idx = ready.back();
+			ready.pop_back();
+
+			++num_visited;
+
+			for (auto succ : m_Nodes[idx].m_Successors)
+				if (--in_degree[succ] == 0)
+					ready.push_back(succ);
+		}
+
+		if (num_visited != num_nodes) {
+			std::stringstream sstr;
+
+			sstr << "Cyclic update ordering between:";
+
+			for (size_t i = 0; i < num_nodes; ++i)
+				if (in_degree[i] > 0)
+					sstr << " '" << m_Nodes[i].m_System->get_name() << "'";
+
+			g_LogError << sstr.str();
+
+			throw std::runtime_error("Cyclic update ordering in frame graph");
+		}
+	}
+
+	void FrameGraph::schedule(size_t node_idx, Scheduler& scheduler) {
+		if (m_Nodes[node_idx].m_MainThread) {
+			std::lock_guard guard(m_MainThreadMutex);
+			m_MainThreadReady.push_back(node_idx);
+		}
+		else
+			m_Group->run([this, node_idx, &scheduler] {
+				run(node_idx, scheduler);
+			});
+	}
+
+	void FrameGraph::run(size_t node_idx, Scheduler& scheduler) {
+		auto& node  = m_Nodes[node_idx];
+		auto  start = std::chrono::steady_clock::now();
+
+		try {
+			HECATE_PROFILE_SCOPE(node.m_ProfileName);
+
+			node.m_System->get_mailbox().drain();
+			node.m_System->update();
+		}
+		catch (...) {
+			// rethrown on the main thread once the frame is done
+			std::lock_guard guard(m_ExceptionMutex);
+
+			if (!m_Exception)
+				m_Exception = std::current_exception();
+		}
+
+		node.m_LastDuration = std::chrono::duration_cast<Duration>(std::chrono::steady_clock::now() - start);
+
+		for (auto succ : node.m_Successors)
+			if (m_Pending[succ].fetch_sub(1, std::memory_order_acq_rel) == 1)
+				schedule(succ, scheduler);
+
+		m_NumCompleted.fetch_add(1, std::memory_order_release);
+	}
+
+	std::ostream& operator << (std::ostream& os, const FrameGraph& fg) {
+		for (const auto& node : fg.m_Nodes) {
+			os << node.m_System->get_name();
+
+			if (node.m_MainThread)
+				os << " [main]";
+
+			os << " ->";
+
+			for (auto succ : node.m_Successors)
+				os << " " << fg.m_Nodes[succ].m_System->get_name();
+
+			os << "\n";
+		}
+
+		return os;
+	}
+}
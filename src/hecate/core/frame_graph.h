@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "scheduler.h"
+
+namespace hecate {
+	class System;
+
+	/*
+	*	Per-frame DAG of System::update calls
+	*
+	*	Ordering edges come from
+	*		- System dependencies (a system updates after the systems it depends on)
+	*		- declared resource access (readers wait for the previous writer, writers wait for
+	*		  the previous writer and all readers since); registration order breaks the tie
+	*		- the application, if any, updates after all systems
+	*
+	*	Nodes without an ordering constraint between them run at the same time on the
+	*	scheduler; systems that require the main thread are executed by the calling thread.
+	*/
+	class FrameGraph {
+	public:
+		using Duration = std::chrono::nanoseconds;
+
+		void build(
+			const std::vector<System*>& systems,
+			System*                     application = nullptr
+		); // throws if there is a cycle
+
+		void clear();
+
+		void execute(Scheduler& scheduler); // runs all nodes once; must be called from the main thread
+
+		[[nodiscard]] size_t get_num_nodes() const noexcept;
+
+		// based on the timings of the last execution
+		[[nodiscard]] std::vector<const System*> get_critical_path()          const;
+		[[nodiscard]] Duration                   get_critical_path_duration() const;
+		[[nodiscard]] Duration                   get_total_duration()         const; // sum of all node durations
+
+		friend std::ostream& operator << (std::ostream& os, const FrameGraph& fg);
+
+	private:
+		struct Node {
+			System*             m_System          = nullptr;
+			const char*         m_ProfileName     = nullptr;
+			bool                m_MainThread      = false;
+			std::vector<size_t> m_Successors;
+			size_t              m_NumPredecessors = 0;
+			Duration            m_LastDuration    = {};
+		};
+
+		void add_edge(size_t from, size_t to);
+		void check_for_cycles() const;
+
+		void schedule(size_t node_idx, Scheduler& scheduler);
+		void run(size_t node_idx, Scheduler& scheduler);
+
+		std::vector<Node>   m_Nodes;
+		std::vector<size_t> m_Roots;
+
+		// per-execution state
+		std::unique_ptr<std::atomic<size_t>[]> m_Pending;
+		std::atomic<size_t>                    m_NumCompleted = 0;
+
+		std::mutex          m_MainThreadMutex;
+		std::vector<size_t> m_MainThreadReady;
+
+		std::mutex         m_ExceptionMutex;
+		std::exception_ptr m_Exception;
+
+		Scheduler::TaskGroup* m_Group = nullptr;
+	};
+}
@@ -0,0 +1,251 @@
+#include "frame_pacer.h"
+#include "logger.h"
+#include "../platform/platform.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <ostream>
+#include <thread>
+#include <utility>
+
+namespace {
+	constexpr double k_MaxSleepOvershoot = 0.016; // beyond this we'd rather spin for the whole frame
+
+	double percentile(std::vector<double> values, double p) {
+		if (values.empty())
+			return 0.0;
+
+		size_t idx = static_cast<size_t>(std::ceil(p * static_cast<double>(values.size()))) - 1;
+		idx = std::min(idx, values.size() - 1);
+
+		std::nth_element(values.begin(), values.begin() + idx, values.end());
+
+		return values[idx];
+	}
+
+	double mean(const std::vector<double>& values) {
+		if (values.empty())
+			return 0.0;
+
+		return std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+	}
+}
+
+namespace hecate {
+	FramePacer::FramePacer():
+		FramePacer(Clock{ &Platform::get_absolute_time, &Platform::sleep_ms })
+	{
+	}
+
+	FramePacer::FramePacer(Clock clock):
+		m_Clock(std::move(clock))
+	{
+	}
+
+	void FramePacer::set_target_rate(double frames_per_second) {
+		m_TargetRate = std::max(0.0, frames_per_second);
+	}
+
+	double FramePacer::get_target_rate() const noexcept {
+		return m_TargetRate;
+	}
+
+	void FramePacer::set_mode(e_Mode mode) {
+		m_Mode = mode;
+	}
+
+	FramePacer::e_Mode FramePacer::get_mode() const noexcept {
+		return m_Mode;
+	}
+
+	void FramePacer::set_max_catch_up_steps(uint32_t steps) {
+		m_MaxCatchUpSteps = std::max(1u, steps);
+	}
+
+	void FramePacer::start() {
+		m_FrameStart = m_Clock.m_Now();
+
+		if (m_TargetRate > 0) {
+			m_DeltaTime = 1.0 / m_TargetRate;
+			m_Deadline  = m_FrameStart + m_DeltaTime;
+		}
+		else {
+			m_DeltaTime = 0;
+			m_Deadline  = m_FrameStart;
+		}
+	}
+
+	size_t FramePacer::end_frame() {
+		const double work_end  = m_Clock.m_Now();
+		const double work_time = work_end - m_FrameStart;
+
+		size_t num_steps = 1;
+		bool   missed    = false;
+
+		if (m_TargetRate > 0) {
+			const double period = 1.0 / m_TargetRate;
+
+			if (work_end <= m_Deadline) {
+				wait_until(m_Deadline);
+				m_Deadline += period;
+			}
+			else {
+				missed = true;
+
+				if (m_Mode == e_Mode::fixed) {
+					// run the updates that should have happened by now, unless we're too far behind
+					size_t due = 1 + static_cast<size_t>((work_end - m_Deadline) / period);
+
+					if (due <= m_MaxCatchUpSteps) {
+						num_steps   = due;
+						m_Deadline += period * static_cast<double>(due);
+					}
+					else {
+						num_steps  = m_MaxCatchUpSteps;
+						m_Deadline = work_end + period; // drop the backlog
+					}
+				}
+				else
+					m_Deadline = work_end + period;
+			}
+		}
+
+		const double frame_start = m_Clock.m_Now();
+
+		record(frame_start - m_FrameStart, work_time, missed);
+
+		if ((m_Mode == e_Mode::fixed) && (m_TargetRate > 0))
+			m_DeltaTime = 1.0 / m_TargetRate;
+		else
+			m_DeltaTime = frame_start - m_FrameStart;
+
+		m_FrameStart = frame_start;
+
+		return num_steps;
+	}
+
+	double FramePacer::get_delta_time() const noexcept {
+		return m_DeltaTime;
+	}
+
+	FramePacer::Statistics FramePacer::get_statistics() const {
+		Statistics result;
+
+		result.m_NumFrames       = m_NumFrames;
+		result.m_MissedDeadlines = m_MissedDeadlines;
+
+		result.m_MeanFrameTime = mean(m_FrameTimes);
+		result.m_P99FrameTime  = percentile(m_FrameTimes, 0.99);
+		result.m_MeanWorkTime  = mean(m_WorkTimes);
+		result.m_P99WorkTime   = percentile(m_WorkTimes, 0.99);
+
+		if (!m_FrameTimes.empty())
+			result.m_MaxFrameTime = *std::max_element(m_FrameTimes.begin(), m_FrameTimes.end());
+
+		return result;
+	}
+
+	void FramePacer::reset_statistics() {
+		m_FrameTimes.clear();
+		m_WorkTimes .clear();
+
+		m_HistoryIdx      = 0;
+		m_NumFrames       = 0;
+		m_MissedDeadlines = 0;
+	}
+
+	void FramePacer::record(
+		double frame_time,
+		double work_time,
+		bool   missed
+	) {
+		if (m_FrameTimes.size() < k_HistorySize) {
+			m_FrameTimes.push_back(frame_time);
+			m_WorkTimes .push_back(work_time);
+		}
+		else {
+			m_FrameTimes[m_HistoryIdx] = frame_time;
+			m_WorkTimes [m_HistoryIdx] = work_time;
+		}
+
+		m_HistoryIdx = (m_HistoryIdx + 1) % k_HistorySize;
+
+		++m_NumFrames;
+
+		if (missed)
+			++m_MissedDeadlines;
+	}
+
+	void FramePacer::wait_until(double deadline) {
+		// sleep in small slices for as long as we're reasonably sure not to oversleep...
+		for (;;) {
+			const double now       = m_Clock.m_Now();
+			const double remaining = deadline - now;
+
+			if (remaining <= m_SleepOvershoot)
+				break;
+
+			const auto ms = static_cast<uint64_t>((remaining - m_SleepOvershoot) * 1000.0);
+
+			if (ms == 0)
+				break;
+
+			m_Clock.m_Sleep(std::min<uint64_t>(ms, 1));
+
+			// track the worst case, slowly decaying towards the typical case
+			const double overshoot = (m_Clock.m_Now() - now) - 0.001;
+
+			if (overshoot > m_SleepOvershoot)
+				m_SleepOvershoot = overshoot;
+			else
+				m_SleepOvershoot = 0.99 * m_SleepOvershoot + 0.01 * std::max(0.0, overshoot);
+
+			m_SleepOvershoot = std::min(m_SleepOvershoot, k_MaxSleepOvershoot);
+		}
+
+		// ... and spin for the rest
+		while (m_Clock.m_Now() < deadline)
+			std::this_thread::yield();
+	}
+
+	std::ostream& operator << (std::ostream& os, FramePacer::e_Mode mode) {
+		switch (mode) {
+		case FramePacer::e_Mode::variable: os << "variable"; break;
+		case FramePacer::e_Mode::fixed:    os << "fixed";    break;
+
+		default:
+			os << "[unknown]";
+			break;
+		}
+
+		return os;
+	}
+
+	std::ostream& operator << (std::ostream& os, const FramePacer::Statistics& stats) {
+		os
+			<< "frames: "       << stats.m_NumFrames
+			<< ", missed: "     << stats.m_MissedDeadlines
+			<< ", frame time mean/p99/max: "
+			<< stats.m_MeanFrameTime * 1000.0 << "/"
+			<< stats.m_P99FrameTime  * 1000.0 << "/"
+			<< stats.m_MaxFrameTime  * 1000.0 << " ms"
+			<< ", work time mean/p99: "
+			<< stats.m_MeanWorkTime * 1000.0 << "/"
+			<< stats.m_P99WorkTime  * 1000.0 << " ms";
+
+		return os;
+	}
+
+	FramePacer::e_Mode to_frame_pacer_mode(const std::string& name) {
+		if (name == "variable")
+			return FramePacer::e_Mode::variable;
+
+		if (name == "fixed")
+			return FramePacer::e_Mode::fixed;
+
+		g_LogWarning << "Unknown timestep mode '" << name << "', using variable timestep";
+
+		return FramePacer::e_Mode::variable;
+	}
+}
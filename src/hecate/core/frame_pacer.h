@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace hecate {
+	/*
+	*	Keeps the main loop at a target frame rate
+	*
+	*	Waiting is done by sleeping for most of the remaining time and spinning for the
+	*	last bit; the spin margin adapts to how much the OS tends to oversleep.
+	*
+	*	Variable timestep: one update per frame, the delta time is whatever the frame took
+	*	Fixed timestep:    the delta time is always 1/rate; when running behind, multiple
+	*	                   updates are run in a single frame to catch up (up to a limit)
+	*/
+	class FramePacer {
+	public:
+		enum class e_Mode {
+			variable,
+			fixed
+		};
+
+		struct Statistics {
+			uint64_t m_NumFrames       = 0;
+			uint64_t m_MissedDeadlines = 0; // frames where the work took longer than the frame budget
+
+			// over the most recent frames, in seconds
+			double m_MeanFrameTime = 0; // start-to-start
+			double m_P99FrameTime  = 0;
+			double m_MaxFrameTime  = 0;
+			double m_MeanWorkTime  = 0; // excluding the time spent waiting
+			double m_P99WorkTime   = 0;
+		};
+
+		// where the time comes from; defaults to the Platform timer, tests can substitute their own
+		struct Clock {
+			std::function<double()>       m_Now;   // seconds, monotonic
+			std::function<void(uint64_t)> m_Sleep; // milliseconds
+		};
+
+		FramePacer();
+		explicit FramePacer(Clock clock);
+
+		void   set_target_rate(double frames_per_second); // 0 disables pacing entirely
+		double get_target_rate() const noexcept;
+
+		void   set_mode(e_Mode mode);
+		e_Mode get_mode() const noexcept;
+
+		void   set_max_catch_up_steps(uint32_t steps); // fixed timestep only
+
+		void   start();     // call right before the first frame
+		size_t end_frame(); // waits for the next frame, returns the number of updates to run (always 1 in variable mode)
+
+		double get_delta_time() const noexcept; // seconds
+
+		Statistics get_statistics() const;
+		void       reset_statistics();
+
+	private:
+		void record(double frame_time, double work_time, bool missed);
+		void wait_until(double deadline);
+
+		static constexpr size_t k_HistorySize = 1024;
+
+		Clock m_Clock;
+
+		double   m_TargetRate      = 60.0;
+		e_Mode   m_Mode            = e_Mode::variable;
+		uint32_t m_MaxCatchUpSteps = 4;
+
+		double m_FrameStart = 0; // absolute time
+		double m_Deadline   = 0; // absolute time
+		double m_DeltaTime  = 0;
+
+		double m_SleepOvershoot = 0.002; // estimated worst case oversleep, adapts at runtime
+
+		// ring buffers with recent frame timings
+		std::vector<double> m_FrameTimes;
+		std::vector<double> m_WorkTimes;
+		size_t              m_HistoryIdx      = 0;
+		uint64_t            m_NumFrames       = 0;
+		uint64_t            m_MissedDeadlines = 0;
+	};
+
+	std::ostream& operator << (std::ostream& os, FramePacer::e_Mode mode);
+	std::ostream& operator << (std::ostream& os, const FramePacer::Statistics& stats);
+
+	FramePacer::e_Mode to_frame_pacer_mode(const std::string& name); // "variable" or "fixed"
+}
@@ -1,10 +1,71 @@
 #include "logger.h"
+#include "logger/binary_log.h"
 #include "logger/log_message.h"
 #include "logger/log_sink.h"
+#include "logger/rotating_log_file.h"
+#include "metrics.h"
+#include "profiler.h"
+
+#include <chrono>
+#include <csignal>
+#include <exception>
 
 namespace hecate {
+	namespace {
+		constexpr size_t k_WriterBatchSize = 256;
+		constexpr auto   k_WriterIdleWait  = std::chrono::milliseconds(10);
+		constexpr auto   k_CrashLockWait   = std::chrono::milliseconds(100);
+
+		const Metrics::Counter& num_dropped_lines() {
+			static const Metrics::Counter counter = Metrics::instance().get_counter("log.dropped");
+			return counter;
+		}
+
+		void count_line(core::logger::e_LogCategory category) {
+			// in e_LogCategory order
+			static const Metrics::Counter num_lines[] = {
+				Metrics::instance().get_counter("log.debug"),
+				Metrics::instance().get_counter("log.info"),
+				Metrics::instance().get_counter("log.warning"),
+				Metrics::instance().get_counter("log.error"),
+				Metrics::instance().get_counter("log.fatal")
+			};
+
+			num_lines[static_cast<size_t>(category)].add();
+		}
+
+		std::terminate_handler g_PreviousTerminateHandler = nullptr;
+
+		// the logger whose sinks this thread is currently writing to (sinks may log as well)
+		thread_local const Logger* t_Writing = nullptr;
+
+		struct WritingScope {
+			explicit WritingScope(const Logger* logger):
+				m_Previous(t_Writing)
+			{
+				t_Writing = logger;
+			}
+
+			~WritingScope() {
+				t_Writing = m_Previous;
+			}
+
+			const Logger* m_Previous;
+		};
+	}
+
+	// [NOTE] the file is continued rather than truncated, so the log of a previous run (possibly a crash) is kept
 	Logger::Logger(const std::string& filename) {
-		add(core::logger::makeFileSink(filename));
+		core::logger::RotatingLogFile::Config config;
+		config.m_Path = filename;
+
+		m_LogFile = std::make_shared<core::logger::RotatingLogFile>(std::move(config));
+
+		add(core::logger::makeRotatingFileSink(m_LogFile));
+	}
+
+	Logger::~Logger() {
+		stopAsync();
 	}
 
 	// this class provides a singleton interface, but can also be used as a regular object
@@ -15,7 +76,7 @@ namespace hecate {
 
 	Logger::LogMessage Logger::operator()(
 		e_LogCategory      category,
-		const std::string& source_file,
+		const char*        source_file,
 		unsigned int       source_line
 	) noexcept {
 		return LogMessage(
@@ -27,22 +88,406 @@ namespace hecate {
 	}
 
 	void Logger::add(LogSink sink) noexcept {
-		m_Sinks.push_back(std::move(sink));
+		std::lock_guard guard(m_SinkMutex);
+
+		SinkList sinks = *m_Sinks;
+		sinks.push_back(std::make_shared<LogSink>(std::move(sink)));
+
+		m_Sinks = std::make_shared<const SinkList>(std::move(sinks));
+		m_SinkVersion.fetch_add(1, std::memory_order_release);
 	}
 
 	void Logger::removeAll() noexcept {
-		m_Sinks.clear();
+		{
+			std::lock_guard guard(m_SinkMutex);
+
+			m_Sinks = std::make_shared<const SinkList>();
+			m_SinkVersion.fetch_add(1, std::memory_order_release);
+		}
+
+		// the current writer may still hold on to the previous snapshot
+		if (t_Writing != this) {
+			std::lock_guard guard(m_WriteMutex);
+			refreshSinks();
+		}
 	}
 
 	size_t Logger::getNumSinks() const noexcept {
-		return m_Sinks.size();
+		std::lock_guard guard(m_SinkMutex);
+		return m_Sinks->size();
+	}
+
+	std::shared_ptr<core::logger::RotatingLogFile> Logger::getLogFile() const noexcept {
+		return m_LogFile;
 	}
 
 	void Logger::flush(core::logger::LogMessage* message) noexcept {
-		auto info = message->m_MetaInfo;
-		auto str  = message->m_Buffer.str();
+		HECATE_PROFILE_SCOPE("Logger::flush");
+
+		const auto& info = message->m_MetaInfo;
+
+		count_line(info.m_Category);
+
+		enqueue(info, message->getText());
+
+		if (info.m_Category == e_LogCategory::fatal)
+			sync();
+	}
+
+	void Logger::logEvent(
+		const MetaInfo&  info,
+		std::string_view arguments
+	) noexcept {
+		count_line(info.m_Category);
+
+		enqueue(info, arguments);
+
+		if (info.m_Category == e_LogCategory::fatal)
+			sync();
+	}
+
+	void Logger::startAsync(
+		size_t        queue_size,
+		e_LogOverflow overflow
+	) {
+		if (isAsync())
+			stopAsync();
+
+		m_OwnedRing = std::make_unique<Ring>(queue_size);
+		m_Overflow  = overflow;
+		m_Completed.store(0, std::memory_order_relaxed);
+		m_NumDropped.store(0, std::memory_order_relaxed);
+
+		m_Writer = std::jthread([this](std::stop_token token) {
+			runWriter(token);
+		});
+
+		m_Ring.store(m_OwnedRing.get());
+	}
+
+	void Logger::stopAsync() {
+		sync();
+
+		Ring* ring = m_Ring.exchange(nullptr);
+
+		if (!ring)
+			return;
+
+		// wait for producers that already picked up the ring to finish pushing
+		while (m_NumActive.load() != 0)
+			std::this_thread::yield();
+
+		// the writer empties the ring before it stops
+		m_Writer.request_stop();
+		m_Writer.join();
+
+		m_OwnedRing.reset();
+
+		// lines that sinks logged while the writer thread was finishing up
+		std::lock_guard guard(m_WriteMutex);
+		writeStaged();
+	}
+
+	bool Logger::isAsync() const noexcept {
+		return m_Ring.load() != nullptr;
+	}
+
+	void Logger::sync() {
+		// a sink logged something (fatal) while writing
+		if (t_Writing == this)
+			return;
+
+		m_NumActive.fetch_add(1);
+
+		if (Ring* ring = m_Ring.load()) {
+			size_t target = ring->get_enqueue_position();
+
+			while (m_Completed.load(std::memory_order_acquire) < target) {
+				if (m_WriterSleeping.load()) {
+					std::lock_guard guard(m_WakeMutex);
+					m_WakeCondition.notify_one();
+				}
+
+				std::this_thread::yield();
+			}
+
+			m_NumActive.fetch_sub(1);
+			return;
+		}
+
+		m_NumActive.fetch_sub(1);
+
+		std::lock_guard guard(m_WriteMutex);
+
+		writeStaged();
+		flushSinks();
+	}
+
+	uint64_t Logger::getNumDropped() const noexcept {
+		return m_NumDropped.load(std::memory_order_relaxed);
+	}
+
+	void Logger::installCrashHandler() {
+		static std::once_flag installed;
+
+		std::call_once(installed, [] {
+			// [NOTE] draining is not async-signal-safe, but at this point we're going down anyway
+			auto on_signal = [](int signal) {
+				instance().drain();
+
+				std::signal(signal, SIG_DFL);
+				std::raise(signal);
+			};
+
+			auto on_terminate = [] {
+				instance().drain();
+
+				if (g_PreviousTerminateHandler)
+					g_PreviousTerminateHandler();
+
+				std::abort();
+			};
+
+			for (int signal : { SIGSEGV, SIGABRT, SIGFPE, SIGILL })
+				std::signal(signal, on_signal);
+
+			g_PreviousTerminateHandler = std::set_terminate(on_terminate);
+		});
+	}
+
+	void Logger::write(
+		const MetaInfo&  info,
+		std::string_view message
+	) {
+		// [NOTE] deferred events are only meaningful to the binary log, which formats them offline
+		if (info.m_Callsite != LogMessage::k_NoCallsite) {
+			core::logger::BinaryLog::instance().writeEvent(info, message);
+			return;
+		}
+
+		for (const auto& sink : *m_WriteSinks)
+			sink->write(info, message);
+	}
+
+	void Logger::enqueue(
+		const MetaInfo&  info,
+		std::string_view message
+	) {
+		// a sink logged something while the writer thread was writing; pushing to a full ring from
+		// the one thread that empties it would never succeed, so stage it instead
+		if (t_Writing == this) {
+			combine(info, message);
+			return;
+		}
+
+		// [NOTE] m_NumActive is raised before looking at m_Ring, so stopAsync() can tell when
+		//        no producer is using the ring anymore after it was unpublished
+		m_NumActive.fetch_add(1);
+
+		Ring* ring = m_Ring.load();
+
+		if (!ring) {
+			m_NumActive.fetch_sub(1);
+			combine(info, message);
+
+			return;
+		}
+
+		auto wake_writer = [this] {
+			if (m_WriterSleeping.load()) {
+				std::lock_guard guard(m_WakeMutex);
+				m_WakeCondition.notify_one();
+			}
+		};
+
+		switch (m_Overflow) {
+		case e_LogOverflow::block:
+			while (!ring->try_push(info, message)) {
+				wake_writer();
+				std::this_thread::yield();
+			}
+			break;
+
+		case e_LogOverflow::drop:
+			if (!ring->try_push(info, message)) {
+				m_NumDropped.fetch_add(1, std::memory_order_relaxed);
+				num_dropped_lines().add();
+			}
+			break;
+
+		case e_LogOverflow::drop_oldest:
+			while (!ring->try_push(info, message)) {
+				if (ring->try_drop()) {
+					m_NumDropped.fetch_add(1, std::memory_order_relaxed);
+					num_dropped_lines().add();
+				}
+			}
+			break;
+		}
+
+		wake_writer();
+
+		m_NumActive.fetch_sub(1);
+	}
+
+	void Logger::combine(
+		const MetaInfo&  info,
+		std::string_view message
+	) {
+		// a sink logged something; this thread is already writing, so it'll get to it
+		if (t_Writing == this) {
+			if (!m_Staging.try_push(info, message))
+				write(info, message);
+
+			return;
+		}
+
+		size_t position = 0;
+
+		while (!m_Staging.try_push(info, message, &position)) {
+			std::unique_lock lock(m_WriteMutex, std::try_to_lock);
+
+			if (lock.owns_lock())
+				writeStaged();
+			else
+				std::this_thread::yield();
+		}
+
+		// [NOTE] either this thread writes everything that was staged so far (including this message),
+		//        or it waits until the thread that is currently writing has done so
+		while (m_StagingCompleted.load(std::memory_order_acquire) <= position) {
+			std::unique_lock lock(m_WriteMutex, std::try_to_lock);
+
+			if (lock.owns_lock())
+				writeStaged();
+			else
+				std::this_thread::yield();
+		}
+	}
+
+	void Logger::writeStaged() {
+		WritingScope scope(this);
+
+		refreshSinks();
+
+		// at most one lap, so a thread doesn't end up writing for everyone else indefinitely
+		size_t num_written = 0;
+
+		while (
+			num_written < m_Staging.get_capacity() &&
+			m_Staging.try_pop(m_StagedRecord)
+		) {
+			write(m_StagedRecord.m_Info, m_StagedRecord.m_Message);
+			++num_written;
+		}
+
+		m_StagingCompleted.store(m_Staging.get_dequeue_position(), std::memory_order_release);
+	}
+
+	void Logger::refreshSinks() {
+		if (m_SinkVersion.load(std::memory_order_acquire) == m_WriteVersion)
+			return;
+
+		std::lock_guard guard(m_SinkMutex);
+
+		m_WriteSinks   = m_Sinks;
+		m_WriteVersion = m_SinkVersion.load(std::memory_order_relaxed);
+	}
+
+	void Logger::flushSinks() {
+		if (!m_WriteSinks)
+			return;
+
+		for (const auto& sink : *m_WriteSinks)
+			sink->flush();
+	}
+
+	void Logger::runWriter(std::stop_token token) {
+		Ring*  ring = m_OwnedRing.get();
+		Record record; // reused, so its message keeps its capacity
+
+		for (;;) {
+			if (!ring->is_empty()) {
+				HECATE_PROFILE_SCOPE("Logger::runWriter");
+
+				// [NOTE] records are taken out while holding the write lock, so that draining after a
+				//        crash can't overtake a batch that is still in flight
+				std::lock_guard guard(m_WriteMutex);
+				WritingScope    scope(this);
+
+				refreshSinks();
+
+				size_t num_written = 0;
+
+				while (
+					num_written < k_WriterBatchSize &&
+					ring->try_pop(record)
+				) {
+					write(record.m_Info, record.m_Message);
+					++num_written;
+				}
+
+				// lines that sinks logged during this batch
+				if (!m_Staging.is_empty())
+					writeStaged();
+
+				if (num_written > 0)
+					flushSinks();
+			}
+
+			// everything below the dequeue position was either written just now or discarded by a producer
+			m_Completed.store(ring->get_dequeue_position(), std::memory_order_release);
+
+			if (!ring->is_empty())
+				continue;
+
+			if (token.stop_requested())
+				break;
+
+			std::unique_lock lock(m_WakeMutex);
+
+			m_WriterSleeping.store(true);
+			m_WakeCondition.wait_for(lock, token, k_WriterIdleWait, [ring] { return !ring->is_empty(); });
+			m_WriterSleeping.store(false);
+		}
+	}
+
+	void Logger::drain() noexcept {
+		// a crash while draining shouldn't end up here again
+		static std::atomic_flag draining;
+
+		if (draining.test_and_set())
+			return;
+
+		Ring* ring = m_Ring.load();
+
+		// the writer thread may be in the middle of a batch; give it a moment
+		// (or proceed without the lock if it doesn't come back)
+		std::unique_lock lock(m_WriteMutex, std::defer_lock);
+
+		auto deadline = std::chrono::steady_clock::now() + k_CrashLockWait;
+
+		while (
+			!lock.try_lock() &&
+			std::chrono::steady_clock::now() < deadline
+		)
+			std::this_thread::yield();
+
+		if (lock.owns_lock())
+			refreshSinks();
+
+		if (!m_WriteSinks)
+			return;
+
+		Record record;
+
+		while (m_Staging.try_pop(record))
+			write(record.m_Info, record.m_Message);
+
+		if (ring)
+			while (ring->try_pop(record))
+				write(record.m_Info, record.m_Message);
 
-		for (auto& sink : m_Sinks)
-			sink.write(info, str);
+		flushSinks();
 	}
-}
\ No newline at end of file
+}
@@ -1,53 +1,184 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 #include "logger/log_category.h"
+#include "logger/log_ring.h"
 #include "logger/log_sink.h"
+#include "../preprocessor.h"
 
 namespace hecate::core::logger {
 	class LogMessage;
+	class RotatingLogFile;
 }
 
 namespace hecate {
+	/*
+	*	By default every message is written to all sinks by the thread that logged it, when the
+	*	LogMessage is destroyed. In asynchronous mode the message is only moved into a bounded
+	*	queue instead, and a background thread writes it (in batches) to the sinks; what happens
+	*	when the queue is full depends on the overflow policy.
+	*
+	*	The g_Log macros skip messages below the minimum category (HECATE_LOG_MIN_CATEGORY at compile
+	*	time, setMinCategory() at runtime) before anything is constructed or evaluated, so disabled
+	*	logging costs a single branch.
+	*
+	*	Any thread may log, and sinks may be added or removed at any time. Sinks are never called
+	*	concurrently - in asynchronous mode only the background thread writes to them; otherwise
+	*	messages are staged in a small queue and whichever thread gets to write first also writes
+	*	the lines that other threads staged in the meantime (flat combining), while those threads
+	*	only wait for their line to be written. The list of sinks is published as an immutable
+	*	snapshot, so writing doesn't contend with registration either.
+	*
+	*	Fatal messages are always waited for. Stopping the asynchronous mode (or destroying the
+	*	logger) writes everything that is still queued; installCrashHandler() does the same on
+	*	fatal signals and std::terminate.
+	*/
 	class Logger {
 	public:
 		using LogSink       = core::logger::LogSink;
 		using LogMessage    = core::logger::LogMessage;
 		using e_LogCategory = core::logger::e_LogCategory;
+		using e_LogOverflow = core::logger::e_LogOverflow;
+
+		static constexpr size_t k_DefaultQueueSize = 8192;
+		static constexpr size_t k_StagingSize      = 256; // messages that can wait for a combining thread
 
 		explicit Logger() = default;
-		Logger(const std::string& filename); // log both to a file and to std::cout
+		Logger(const std::string& filename); // appends to a RotatingLogFile with the default limits, see getLogFile()
+		~Logger();
+
+		Logger             (const Logger&) = delete;
+		Logger& operator = (const Logger&) = delete;
+		Logger             (Logger&&)      = delete;
+		Logger& operator = (Logger&&)      = delete;
 
 		// this class provides a singleton interface, but can also be used as a regular object
 		static Logger& instance() noexcept;
 
 		void   add(LogSink sink) noexcept;
-		void   removeAll() noexcept;
+		void   removeAll() noexcept; // the sinks are destroyed before this returns
 		size_t getNumSinks() const noexcept;
 
+		// the file from the constructor (nullptr if there is none), can be reconfigured while logging
+		std::shared_ptr<core::logger::RotatingLogFile> getLogFile() const noexcept;
+
 		void flush(LogMessage* message) noexcept;
 
+		// a deferred g_LogFormat event (info.m_Callsite is set, the arguments are encoded), see binary_log.h;
+		// queued like any other message, but only written to the binary log
+		void logEvent(const LogMessage::MetaInfo& info, std::string_view arguments) noexcept;
+
+		void startAsync(
+			size_t        queue_size = k_DefaultQueueSize,
+			e_LogOverflow overflow   = e_LogOverflow::block
+		);
+		void stopAsync(); // writes everything that is still queued, then continues synchronously
+		bool isAsync() const noexcept;
+
+		void sync(); // blocks until everything that was logged so far has been written to the sinks
+
+		uint64_t getNumDropped() const noexcept; // by the overflow policy, since the start of asynchronous mode
+
+		static void installCrashHandler(); // for the global logger
+
+		// applies to the g_Log macros (so, the global logger); categories below the compile time minimum can't be enabled
+		static void          setMinCategory(e_LogCategory category) noexcept;
+		static e_LogCategory getMinCategory() noexcept;
+		static bool          isEnabled(e_LogCategory category) noexcept;
+
 		// create an associated LogMessage with the appropriate message metadata
 		LogMessage operator()(
-			e_LogCategory      category,
-			const std::string& source_file,
-			unsigned int       source_line
+			e_LogCategory category,
+			const char*   source_file, // expected to be a string literal (__FILE__)
+			unsigned int  source_line
 		) noexcept;
 
 	private:
-		std::vector<LogSink> m_Sinks;
+		using Record = core::logger::LogRecord;
+		using Ring   = core::logger::LogRing;
+
+		using MetaInfo = LogMessage::MetaInfo;
+		using SinkList = std::vector<std::shared_ptr<LogSink>>;
+
+		void write(const MetaInfo& info, std::string_view message); // requires m_WriteMutex
+		void enqueue(const MetaInfo& info, std::string_view message);
+		void combine(const MetaInfo& info, std::string_view message);
+		void writeStaged();  // requires m_WriteMutex
+		void refreshSinks(); // requires m_WriteMutex
+		void flushSinks();   // requires m_WriteMutex
+		void runWriter(std::stop_token token);
+		void drain() noexcept; // writes whatever is queued from the calling thread, used after a crash
+
+		// registration (copy-on-write)
+		mutable std::mutex              m_SinkMutex;
+		std::shared_ptr<const SinkList> m_Sinks       = std::make_shared<const SinkList>(); // guarded by m_SinkMutex
+		std::atomic<uint64_t>           m_SinkVersion = 1;
+
+		std::shared_ptr<core::logger::RotatingLogFile> m_LogFile;
+
+		// held by whichever thread writes to the sinks
+		std::mutex                      m_WriteMutex;
+		std::shared_ptr<const SinkList> m_WriteSinks;       // the snapshot in use
+		uint64_t                        m_WriteVersion = 0;
+		Record                          m_StagedRecord;     // reused, so its message keeps its capacity
+
+		// synchronous mode
+		Ring                m_Staging { k_StagingSize };
+		std::atomic<size_t> m_StagingCompleted = 0; // staging position below which every record was written
+
+		// asynchronous mode
+		std::atomic<Ring*>    m_Ring       = nullptr; // published while asynchronous
+		std::unique_ptr<Ring> m_OwnedRing;
+		e_LogOverflow         m_Overflow   = e_LogOverflow::block;
+		std::atomic<uint32_t> m_NumActive  = 0;       // producers currently using m_Ring
+		std::atomic<size_t>   m_Completed  = 0;       // ring position below which every record was written or discarded
+		std::atomic<uint64_t> m_NumDropped = 0;
+
+		std::mutex                  m_WakeMutex;
+		std::condition_variable_any m_WakeCondition;
+		std::atomic_bool            m_WriterSleeping = false;
+		std::jthread                m_Writer;
 	};
 }
 
+namespace hecate::core::logger::detail {
+	// HECATE_LOG_MIN_CATEGORY follows e_LogCategory order (0 = debug ... 4 = fatal)
+	inline constexpr e_LogCategory k_MinCategory = static_cast<e_LogCategory>(HECATE_LOG_MIN_CATEGORY);
+
+	inline std::atomic<e_LogCategory> g_MinCategory = k_MinCategory;
+
+	// lowest precedence that still binds tighter than ?:, so the entire '<<' chain ends up on the right-hand side
+	struct LogStatement {
+		void operator & (const LogMessage&) const noexcept {}
+	};
+}
+
+#include "logger.inl"
+
 // macros to make it as painless as possible to log something
-#define g_LogCategory(category) \
-	(::hecate::Logger::instance()(::hecate::core::logger::e_LogCategory::category, __FILE__, __LINE__))
+//
+// [NOTE] the message is only created (and the << operands only evaluated) if the category is enabled;
+//        below the compile time minimum the condition is a constant and the whole statement is removed
+//
+#define g_LogCategory(category)                                                                             \
+	(::hecate::core::logger::e_LogCategory::category < ::hecate::core::logger::detail::k_MinCategory ||    \
+	 !::hecate::Logger::isEnabled(::hecate::core::logger::e_LogCategory::category))                        \
+		? (void)0                                                                                         \
+		: ::hecate::core::logger::detail::LogStatement() &                                                \
+		  ::hecate::Logger::instance()(::hecate::core::logger::e_LogCategory::category, __FILE__, __LINE__)
 
-#define g_Log (g_LogCategory(info))
+#define g_Log g_LogCategory(info)
 
-#define g_LogDebug   (g_LogCategory(debug))
-#define g_LogInfo    (g_LogCategory(info))
-#define g_LogError   (g_LogCategory(err))
-#define g_LogWarning (g_LogCategory(warning))
-#define g_LogFatal   (g_LogCategory(fatal))
+#define g_LogDebug   g_LogCategory(debug)
+#define g_LogInfo    g_LogCategory(info)
+#define g_LogError   g_LogCategory(err)
+#define g_LogWarning g_LogCategory(warning)
+#define g_LogFatal   g_LogCategory(fatal)
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "logger.h"
+
+namespace hecate {
+	inline void Logger::setMinCategory(e_LogCategory category) noexcept {
+		if (category < core::logger::detail::k_MinCategory)
+			category = core::logger::detail::k_MinCategory;
+
+		core::logger::detail::g_MinCategory.store(category, std::memory_order_relaxed);
+	}
+
+	inline Logger::e_LogCategory Logger::getMinCategory() noexcept {
+		return core::logger::detail::g_MinCategory.load(std::memory_order_relaxed);
+	}
+
+	inline bool Logger::isEnabled(e_LogCategory category) noexcept {
+		return category >= getMinCategory();
+	}
+}
@@ -0,0 +1,430 @@
+#include "binary_log.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <variant>
+
+namespace {
+	using hecate::core::logger::e_LogArgument;
+	using hecate::core::logger::e_LogCategory;
+	using hecate::core::logger::LogCallsite;
+
+	struct CallsiteRegistry {
+		std::mutex               m_Mutex;
+		std::vector<LogCallsite> m_Callsites; // by id
+
+		// regular log messages get a callsite per source location
+		std::map<std::tuple<const char*, unsigned int, e_LogCategory>, uint32_t> m_TextCallsites;
+	};
+
+	CallsiteRegistry& get_registry() {
+		static CallsiteRegistry* registry = new CallsiteRegistry; // [NOTE] never destroyed, same as the BinaryLog
+		return *registry;
+	}
+
+	template <typename U>
+	void write_raw(std::vector<std::byte>& buffer, const U& value) {
+		hecate::core::logger::detail::appendRaw(buffer, value);
+	}
+
+	void write_string(std::vector<std::byte>& buffer, std::string_view str) {
+		write_raw(buffer, static_cast<uint16_t>(str.size()));
+
+		size_t offset = buffer.size();
+
+		buffer.resize(offset + str.size());
+		std::memcpy(buffer.data() + offset, str.data(), str.size());
+	}
+
+	using Argument = std::variant<
+		int32_t,
+		int64_t,
+		uint32_t,
+		uint64_t,
+		float,
+		double,
+		bool,
+		char,
+		std::string
+	>;
+}
+
+namespace hecate::core::logger {
+	BinaryLog& BinaryLog::instance() noexcept {
+		static BinaryLog* log = new BinaryLog;
+		return *log;
+	}
+
+	bool BinaryLog::open(const std::filesystem::path& filename) {
+		close();
+
+		std::lock_guard guard(m_Mutex);
+
+		m_File.open(filename, std::ios::binary | std::ios::trunc);
+
+		if (!m_File)
+			return false;
+
+		m_File.write(k_Magic.data(), k_Magic.size());
+		m_File.write(reinterpret_cast<const char*>(&k_Version), sizeof(k_Version));
+
+		m_Block.clear();
+		m_Block.reserve(k_BlockSize * 2);
+		m_Declared.clear();
+
+		m_NumEvents.store(0, std::memory_order_relaxed);
+		m_IsOpen.store(true);
+
+		return true;
+	}
+
+	void BinaryLog::close() {
+		std::lock_guard guard(m_Mutex);
+
+		if (!m_File.is_open())
+			return;
+
+		m_IsOpen.store(false);
+
+		writeBlock();
+		m_File.close();
+	}
+
+	bool BinaryLog::isOpen() const noexcept {
+		return m_IsOpen.load(std::memory_order_relaxed);
+	}
+
+	uint32_t BinaryLog::registerCallsite(LogCallsite site) {
+		auto& registry = get_registry();
+
+		std::lock_guard guard(registry.m_Mutex);
+
+		registry.m_Callsites.push_back(std::move(site));
+
+		return static_cast<uint32_t>(registry.m_Callsites.size() - 1);
+	}
+
+	void BinaryLog::write(
+		const LogMessage::MetaInfo& info,
+		std::string_view            message
+	) {
+		if (!isOpen())
+			return;
+
+		uint32_t callsite = 0;
+
+		{
+			auto& registry = get_registry();
+			auto  key      = std::make_tuple(info.m_SourceFile, info.m_SourceLine, info.m_Category);
+
+			std::lock_guard guard(registry.m_Mutex);
+
+			if (auto it = registry.m_TextCallsites.find(key); it != registry.m_TextCallsites.end())
+				callsite = it->second;
+			else {
+				registry.m_Callsites.push_back({
+					info.m_Category,
+					info.m_SourceFile,
+					info.m_SourceLine,
+					"{}",
+					{ e_LogArgument::string }
+				});
+
+				callsite = static_cast<uint32_t>(registry.m_Callsites.size() - 1);
+				registry.m_TextCallsites[key] = callsite;
+			}
+		}
+
+		// [NOTE] stamped with the time the message was created; in asynchronous mode it is written later
+		writeAt(info.m_Time, callsite, message);
+	}
+
+	void BinaryLog::writeEvent(
+		const LogMessage::MetaInfo& info,
+		std::string_view            arguments
+	) {
+		if (isOpen())
+			append(info.m_Callsite, arguments, info.m_Time);
+	}
+
+	void BinaryLog::flush() {
+		std::lock_guard guard(m_Mutex);
+
+		if (!m_File.is_open())
+			return;
+
+		writeBlock();
+		m_File.flush();
+	}
+
+	uint64_t BinaryLog::getNumEvents() const noexcept {
+		return m_NumEvents.load(std::memory_order_relaxed);
+	}
+
+	void BinaryLog::append(
+		uint32_t                              callsite,
+		std::string_view                      arguments,
+		std::chrono::system_clock::time_point timestamp
+	) {
+		int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			timestamp.time_since_epoch()
+		).count();
+
+		std::lock_guard guard(m_Mutex);
+
+		if (!m_File.is_open())
+			return;
+
+		if (
+			(callsite >= m_Declared.size()) ||
+			!m_Declared[callsite]
+		)
+			declare(callsite);
+
+		write_raw(m_Block, k_Event);
+		write_raw(m_Block, callsite);
+		write_raw(m_Block, time);
+
+		size_t offset = m_Block.size();
+
+		m_Block.resize(offset + arguments.size());
+		std::memcpy(m_Block.data() + offset, arguments.data(), arguments.size());
+
+		m_NumEvents.fetch_add(1, std::memory_order_relaxed);
+
+		if (m_Block.size() >= k_BlockSize)
+			writeBlock();
+	}
+
+	void BinaryLog::declare(uint32_t callsite) {
+		if (callsite >= m_Declared.size())
+			m_Declared.resize(callsite + 1, false);
+
+		m_Declared[callsite] = true;
+
+		auto& registry = get_registry();
+
+		std::lock_guard guard(registry.m_Mutex);
+
+		const auto& site = registry.m_Callsites[callsite];
+
+		write_raw   (m_Block, k_DeclareCallsite);
+		write_raw   (m_Block, callsite);
+		write_raw   (m_Block, static_cast<uint8_t>(site.m_Category));
+		write_raw   (m_Block, static_cast<uint32_t>(site.m_SourceLine));
+		write_string(m_Block, site.m_SourceFile);
+		write_string(m_Block, site.m_Format);
+		write_raw   (m_Block, static_cast<uint8_t>(site.m_Arguments.size()));
+
+		for (auto type : site.m_Arguments)
+			write_raw(m_Block, type);
+	}
+
+	void BinaryLog::writeBlock() {
+		m_File.write(reinterpret_cast<const char*>(m_Block.data()), m_Block.size());
+		m_Block.clear();
+	}
+
+	bool BinaryLogReader::open(const std::filesystem::path& filename) {
+		m_File.close();
+		m_File.clear();
+		m_File.open(filename, std::ios::binary);
+
+		m_Callsites.clear();
+		m_Known.clear();
+
+		if (!m_File)
+			return false;
+
+		std::array<char, 4> magic   = {};
+		uint32_t            version = 0;
+
+		m_File.read(magic.data(), magic.size());
+		m_File.read(reinterpret_cast<char*>(&version), sizeof(version));
+
+		return
+			m_File.good() &&
+			(magic   == BinaryLog::k_Magic) &&
+			(version == BinaryLog::k_Version);
+	}
+
+	bool BinaryLogReader::next(
+		LogMessage::MetaInfo& info,
+		std::string&          message
+	) {
+		for (;;) {
+			uint8_t kind = 0;
+
+			if (!m_File.read(reinterpret_cast<char*>(&kind), sizeof(kind)))
+				return false;
+
+			if (kind == BinaryLog::k_DeclareCallsite) {
+				readCallsite();
+				continue;
+			}
+
+			if (kind != BinaryLog::k_Event)
+				throw std::runtime_error("Corrupt binary log (unknown record)");
+
+			auto id   = read<uint32_t>();
+			auto time = read<int64_t>();
+
+			if ((id >= m_Known.size()) || !m_Known[id])
+				throw std::runtime_error("Corrupt binary log (undeclared callsite)");
+
+			const auto& site = m_Callsites[id];
+
+			info.m_Category   = site.m_Category;
+			info.m_SourceFile = site.m_SourceFile.c_str();
+			info.m_SourceLine = site.m_SourceLine;
+			info.m_Time       = std::chrono::system_clock::time_point(
+				std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(time))
+			);
+
+			format(site, message);
+
+			return true;
+		}
+	}
+
+	size_t BinaryLogReader::getNumCallsites() const noexcept {
+		return std::count(m_Known.begin(), m_Known.end(), true);
+	}
+
+	template <typename U>
+	U BinaryLogReader::read() {
+		U result;
+
+		if (!m_File.read(reinterpret_cast<char*>(&result), sizeof(U)))
+			throw std::runtime_error("Corrupt binary log (truncated)");
+
+		return result;
+	}
+
+	std::string BinaryLogReader::readString(size_t length) {
+		std::string result(length, '\0');
+
+		if (!m_File.read(result.data(), length))
+			throw std::runtime_error("Corrupt binary log (truncated)");
+
+		return result;
+	}
+
+	void BinaryLogReader::readCallsite() {
+		Callsite site;
+
+		auto id = read<uint32_t>();
+
+		site.m_Category   = static_cast<e_LogCategory>(read<uint8_t>());
+		site.m_SourceLine = read<uint32_t>();
+		site.m_SourceFile = readString(read<uint16_t>());
+		site.m_Format     = readString(read<uint16_t>());
+
+		site.m_Arguments.resize(read<uint8_t>());
+
+		for (auto& type : site.m_Arguments)
+			type = read<e_LogArgument>();
+
+		if (id >= m_Callsites.size()) {
+			m_Callsites.resize(id + 1);
+			m_Known.resize(id + 1, false);
+		}
+
+		m_Callsites[id] = std::move(site);
+		m_Known[id]     = true;
+	}
+
+	void BinaryLogReader::format(
+		const Callsite& site,
+		std::string&    message
+	) {
+		std::vector<Argument> arguments;
+		arguments.reserve(site.m_Arguments.size());
+
+		for (auto type : site.m_Arguments) {
+			switch (type) {
+			case e_LogArgument::int8:      arguments.emplace_back(static_cast<int32_t>(read<int8_t>()));   break;
+			case e_LogArgument::int16:     arguments.emplace_back(static_cast<int32_t>(read<int16_t>()));  break;
+			case e_LogArgument::int32:     arguments.emplace_back(read<int32_t>());                        break;
+			case e_LogArgument::int64:     arguments.emplace_back(read<int64_t>());                        break;
+			case e_LogArgument::uint8:     arguments.emplace_back(static_cast<uint32_t>(read<uint8_t>())); break;
+			case e_LogArgument::uint16:    arguments.emplace_back(static_cast<uint32_t>(read<uint16_t>())); break;
+			case e_LogArgument::uint32:    arguments.emplace_back(read<uint32_t>());                       break;
+			case e_LogArgument::uint64:    arguments.emplace_back(read<uint64_t>());                       break;
+			case e_LogArgument::float32:   arguments.emplace_back(read<float>());                          break;
+			case e_LogArgument::float64:   arguments.emplace_back(read<double>());                         break;
+			case e_LogArgument::boolean:   arguments.emplace_back(read<bool>());                           break;
+			case e_LogArgument::character: arguments.emplace_back(read<char>());                           break;
+			case e_LogArgument::string:    arguments.emplace_back(readString(read<uint32_t>()));           break;
+
+			default:
+				throw std::runtime_error("Corrupt binary log (unknown argument type)");
+			}
+		}
+
+		// [NOTE] the format string was checked at compile time; here every replacement field is
+		//        formatted on its own, with its own argument
+		message.clear();
+
+		std::string_view fmt        = site.m_Format;
+		size_t           next_index = 0;
+		std::string      field;
+
+		for (size_t i = 0; i < fmt.size(); ++i) {
+			char c = fmt[i];
+
+			if ((c == '{' || c == '}') && (i + 1 < fmt.size()) && (fmt[i + 1] == c)) {
+				message += c; // escaped brace
+				++i;
+				continue;
+			}
+
+			if (c != '{') {
+				message += c;
+				continue;
+			}
+
+			size_t end = fmt.find('}', i);
+
+			if (end == std::string_view::npos)
+				break;
+
+			std::string_view spec  = fmt.substr(i + 1, end - i - 1);
+			size_t           index = next_index++;
+
+			// an explicit argument index, f.e. {1} or {0:x}
+			if (!spec.empty() && std::isdigit(static_cast<unsigned char>(spec.front()))) {
+				index = 0;
+
+				while (!spec.empty() && std::isdigit(static_cast<unsigned char>(spec.front()))) {
+					index = index * 10 + (spec.front() - '0');
+					spec.remove_prefix(1);
+				}
+			}
+
+			field = "{";
+			field += spec;
+			field += "}";
+
+			if (index < arguments.size()) {
+				try {
+					std::visit([&](const auto& value) {
+						message += std::vformat(field, std::make_format_args(value));
+					}, arguments[index]);
+				}
+				catch (const std::format_error&) {
+					message += field; // f.e. a nested replacement field, which isn't supported here
+				}
+			}
+			else
+				message += field;
+
+			i = end;
+		}
+	}
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "log_category.h"
+#include "log_message.h"
+#include "../logger.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace hecate::core::logger {
+	// how a single argument is stored in a binary log
+	enum class e_LogArgument: uint8_t {
+		int8,
+		int16,
+		int32,
+		int64,
+		uint8,
+		uint16,
+		uint32,
+		uint64,
+		float32,
+		float64,
+		boolean,
+		character,
+		string     // u32 length + characters
+	};
+
+	template <typename T>
+	concept c_LogArgument =
+		std::is_arithmetic_v<T> ||
+		std::convertible_to<const T&, std::string_view>;
+
+	struct LogCallsite {
+		e_LogCategory              m_Category   = e_LogCategory::info;
+		const char*                m_SourceFile = "";
+		unsigned int               m_SourceLine = 0;
+		std::string_view           m_Format;    // std::format syntax
+		std::vector<e_LogArgument> m_Arguments;
+	};
+
+	/*
+	*	Binary log with deferred formatting
+	*
+	*	Every g_LogFormat callsite registers its format string, category, source location and
+	*	argument types once; after that a log event only stores the callsite id, a timestamp and
+	*	the raw argument bytes - formatting happens offline, with hecate-logdecode (src/logdecode):
+	*
+	*		BinaryLog::instance().open("hecate.hcl");
+	*
+	*		g_LogFormat(info, "Loaded {} in {:.2f} ms", name, elapsed);
+	*
+	*	While no binary log is open, g_LogFormat formats the message right away and passes it to
+	*	the regular logger instead. makeBinaryFileSink() (see log_sink.h) opens the binary log as
+	*	well and also stores regular log messages in it, as preformatted strings.
+	*
+	*	g_LogFormat events are queued by the Logger like any other message, so they keep their order
+	*	relative to regular messages and the file is written by whichever thread writes the sinks
+	*	(the writer thread in asynchronous mode). They are staged in memory and written in blocks;
+	*	Logger::sync() and the asynchronous writer thread flush them along with the other sinks.
+	*
+	*	File layout (native endianness): "HCLG", u32 version, then records starting with a u8 kind:
+	*		k_DeclareCallsite: u32 id, u8 category, u32 line, u16 + file, u16 + format, u8 count + argument types
+	*		k_Event:           u32 id, i64 time (ns since the system clock epoch), arguments
+	*	Callsites are declared in a file right before their first event.
+	*/
+	class BinaryLog {
+	public:
+		static constexpr uint32_t k_Version         = 1;
+		static constexpr uint8_t  k_DeclareCallsite = 0;
+		static constexpr uint8_t  k_Event           = 1;
+		static constexpr size_t   k_BlockSize       = 64 * 1024;
+
+		static constexpr std::array<char, 4> k_Magic = { 'H', 'C', 'L', 'G' };
+
+		// [NOTE] never destroyed, so log messages can still be written during static destruction
+		static BinaryLog& instance() noexcept;
+
+		BinaryLog             (const BinaryLog&) = delete;
+		BinaryLog& operator = (const BinaryLog&) = delete;
+		BinaryLog             (BinaryLog&&)      = delete;
+		BinaryLog& operator = (BinaryLog&&)      = delete;
+
+		bool open(const std::filesystem::path& filename); // returns false if the file could not be created
+		void close();
+		bool isOpen() const noexcept;
+
+		static uint32_t registerCallsite(LogCallsite site); // ids are valid for the entire process
+
+		template <typename... Args>
+		void write(uint32_t callsite, const Args&... args); // directly, on the calling thread
+
+		void write     (const LogMessage::MetaInfo& info, std::string_view message);   // a regular (formatted) message
+		void writeEvent(const LogMessage::MetaInfo& info, std::string_view arguments); // encoded arguments for info.m_Callsite
+		void flush();
+
+		uint64_t getNumEvents() const noexcept; // since open()
+
+	private:
+		BinaryLog() = default;
+
+		template <typename... Args>
+		void writeAt(std::chrono::system_clock::time_point time, uint32_t callsite, const Args&... args);
+
+		void append(uint32_t callsite, std::string_view arguments, std::chrono::system_clock::time_point time);
+		void declare(uint32_t callsite); // requires m_Mutex
+		void writeBlock();               // requires m_Mutex
+
+		mutable std::mutex     m_Mutex;
+		std::ofstream          m_File;
+		std::vector<std::byte> m_Block;
+		std::vector<bool>      m_Declared; // per callsite, in the current file
+		std::atomic_bool       m_IsOpen    = false;
+		std::atomic<uint64_t>  m_NumEvents = 0;
+	};
+
+	/*
+	*	Reads a binary log back, formatting the messages
+	*/
+	class BinaryLogReader {
+	public:
+		bool open(const std::filesystem::path& filename); // returns false if the file is missing or not a binary log
+
+		// returns false at the end of the log; throws std::runtime_error if the log is corrupt
+		bool next(LogMessage::MetaInfo& info, std::string& message);
+
+		size_t getNumCallsites() const noexcept;
+
+	private:
+		struct Callsite {
+			e_LogCategory              m_Category = e_LogCategory::info;
+			std::string                m_SourceFile;
+			unsigned int               m_SourceLine = 0;
+			std::string                m_Format;
+			std::vector<e_LogArgument> m_Arguments;
+		};
+
+		template <typename U>
+		U read();
+
+		std::string readString(size_t length);
+		void        readCallsite();
+		void        format(const Callsite& site, std::string& message);
+
+		std::ifstream         m_File;
+		std::vector<Callsite> m_Callsites; // by id, sparse
+		std::vector<bool>     m_Known;
+	};
+
+	template <c_LogArgument T>
+	constexpr e_LogArgument getLogArgument() noexcept;
+
+	// implementation of g_LogFormat; every callsite passes a lambda of its own, which creates its LogCallsite
+	template <typename Location, c_LogArgument... Args>
+	void logFormat(
+		Location                           location,
+		std::format_string<const Args&...> format,
+		const Args&...                     args
+	);
+}
+
+#include "binary_log.inl"
+
+// deferred formatting: g_LogFormat(info, "{} took {} ms", name, ms);
+// arguments may be numbers, characters and strings
+#define g_LogFormat(category, format, ...)                                                                  \
+	(::hecate::core::logger::e_LogCategory::category < ::hecate::core::logger::detail::k_MinCategory ||    \
+	 !::hecate::Logger::isEnabled(::hecate::core::logger::e_LogCategory::category))                        \
+		? (void)0                                                                                         \
+		: ::hecate::core::logger::logFormat(                                                              \
+			[](std::string_view fmt) {                                                                    \
+				return ::hecate::core::logger::LogCallsite{                                               \
+					::hecate::core::logger::e_LogCategory::category, __FILE__, __LINE__, fmt, {}          \
+				};                                                                                        \
+			},                                                                                            \
+			format __VA_OPT__(,) __VA_ARGS__                                                              \
+		)
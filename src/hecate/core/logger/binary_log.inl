@@ -0,0 +1,127 @@
+#pragma once
+
+#include "binary_log.h"
+
+#include <cstring>
+
+namespace hecate::core::logger {
+	namespace detail {
+		template <typename U>
+		void appendRaw(std::vector<std::byte>& buffer, const U& value) {
+			size_t offset = buffer.size();
+
+			buffer.resize(offset + sizeof(U));
+			std::memcpy(buffer.data() + offset, &value, sizeof(U));
+		}
+
+		template <c_LogArgument T>
+		void appendArgument(std::vector<std::byte>& buffer, const T& value) {
+			constexpr e_LogArgument type = getLogArgument<T>();
+
+			if constexpr (type == e_LogArgument::string) {
+				std::string_view str = value;
+
+				appendRaw(buffer, static_cast<uint32_t>(str.size()));
+
+				size_t offset = buffer.size();
+
+				buffer.resize(offset + str.size());
+				std::memcpy(buffer.data() + offset, str.data(), str.size());
+			}
+			else if constexpr (type == e_LogArgument::float32)
+				appendRaw(buffer, static_cast<float>(value));
+			else if constexpr (type == e_LogArgument::float64)
+				appendRaw(buffer, static_cast<double>(value));
+			else
+				appendRaw(buffer, value);
+		}
+
+		template <c_LogArgument... Args>
+		std::string_view encodeArguments(std::vector<std::byte>& buffer, const Args&... args) {
+			buffer.clear();
+			(appendArgument(buffer, args), ...);
+
+			return { reinterpret_cast<const char*>(buffer.data()), buffer.size() };
+		}
+	}
+
+	template <c_LogArgument T>
+	constexpr e_LogArgument getLogArgument() noexcept {
+		if constexpr (std::is_same_v<T, bool>)
+			return e_LogArgument::boolean;
+		else if constexpr (std::is_same_v<T, char>)
+			return e_LogArgument::character;
+		else if constexpr (std::is_floating_point_v<T>)
+			return (sizeof(T) == sizeof(float)) ? e_LogArgument::float32 : e_LogArgument::float64;
+		else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+			switch (sizeof(T)) {
+			case 1:  return e_LogArgument::int8;
+			case 2:  return e_LogArgument::int16;
+			case 4:  return e_LogArgument::int32;
+			default: return e_LogArgument::int64;
+			}
+		}
+		else if constexpr (std::is_integral_v<T>) {
+			switch (sizeof(T)) {
+			case 1:  return e_LogArgument::uint8;
+			case 2:  return e_LogArgument::uint16;
+			case 4:  return e_LogArgument::uint32;
+			default: return e_LogArgument::uint64;
+			}
+		}
+		else
+			return e_LogArgument::string;
+	}
+
+	template <typename... Args>
+	void BinaryLog::write(uint32_t callsite, const Args&... args) {
+		writeAt(std::chrono::system_clock::now(), callsite, args...);
+	}
+
+	template <typename... Args>
+	void BinaryLog::writeAt(
+		std::chrono::system_clock::time_point time,
+		uint32_t                              callsite,
+		const Args&...                        args
+	) {
+		// [NOTE] reused per thread, so encoding doesn't allocate once it has grown large enough
+		thread_local std::vector<std::byte> t_Arguments;
+
+		append(callsite, detail::encodeArguments(t_Arguments, args...), time);
+	}
+
+	template <typename Location, c_LogArgument... Args>
+	void logFormat(
+		Location                           location,
+		std::format_string<const Args&...> format,
+		const Args&...                     args
+	) {
+		// Location is a unique type per callsite, so this registers every callsite exactly once
+		static const LogCallsite site = [&] {
+			LogCallsite result = location(format.get());
+			result.m_Arguments = { getLogArgument<Args>()... };
+
+			return result;
+		}();
+
+		static const uint32_t callsite = BinaryLog::registerCallsite(site);
+
+		if (BinaryLog::instance().isOpen()) {
+			// [NOTE] separate from the buffer in BinaryLog::writeAt; this thread may end up writing the
+			//        binary log sink (see Logger) while the event is still being queued
+			thread_local std::vector<std::byte> t_Arguments;
+
+			LogMessage::MetaInfo info = {
+				site.m_Category,
+				site.m_SourceFile,
+				site.m_SourceLine,
+				std::chrono::system_clock::now(),
+				callsite
+			};
+
+			Logger::instance().logEvent(info, detail::encodeArguments(t_Arguments, args...));
+		}
+		else
+			Logger::instance()(site.m_Category, site.m_SourceFile, site.m_SourceLine) << std::format(format, args...);
+	}
+}
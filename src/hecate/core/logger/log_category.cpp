@@ -1,22 +1,44 @@
 #include "log_category.h"
+#include "../logger.h"
 #include <ostream>
 
 namespace hecate::core::logger {
 	std::ostream& operator << (std::ostream& os, e_LogCategory cat) {
+		return os << get_prefix(cat);
+	}
 
+	std::string_view get_prefix(e_LogCategory cat) {
 		switch (cat) {
-		case e_LogCategory::debug:   os << "[dbg] "; break;
-		case e_LogCategory::info:    os << "      "; break; // should be the most common, and hence the least annotated
-		case e_LogCategory::warning: os << "*wrn* "; break;
+		case e_LogCategory::debug:   return "[dbg] ";
+		case e_LogCategory::info:    return "      "; // should be the most common, and hence the least annotated
+		case e_LogCategory::warning: return "*wrn* ";
 
-		case e_LogCategory::err:     os << "< ERROR >     "; break;
-		case e_LogCategory::fatal:   os << "<## FATAL ##> "; break;
+		case e_LogCategory::err:     return "< ERROR >     ";
+		case e_LogCategory::fatal:   return "<## FATAL ##> ";
 
 		default:
-			os << "[???] ";
-			break;
+			return "[???] ";
 		}
+	}
+
+	e_LogCategory to_log_category(const std::string& name) {
+		if (name == "debug")
+			return e_LogCategory::debug;
+
+		if (name == "info")
+			return e_LogCategory::info;
+
+		if (name == "warning")
+			return e_LogCategory::warning;
+
+		if (name == "error")
+			return e_LogCategory::err;
+
+		if (name == "fatal")
+			return e_LogCategory::fatal;
+
+		g_LogWarning << "Unknown log category '" << name << "', logging everything";
 
-		return os;
+		return e_LogCategory::debug;
 	}
 }
\ No newline at end of file
@@ -1,15 +1,22 @@
 #pragma once
 
 #include <iosfwd>
+#include <string>
+#include <string_view>
 
 namespace hecate::core::logger {
+	// in order of severity, so categories can be compared against a threshold
 	enum class e_LogCategory {
 		debug,
 		info,
-		err,
 		warning,
+		err,
 		fatal
 	};
 
 	std::ostream& operator << (std::ostream& os, e_LogCategory cat);
+
+	std::string_view get_prefix(e_LogCategory cat); // what operator << writes
+
+	e_LogCategory to_log_category(const std::string& name); // "debug", "info", "warning", "error" or "fatal"
 }
@@ -1,19 +1,60 @@
 #include "log_message.h"
 #include "../logger.h"
 #include <ostream>
+#include <streambuf>
+
+namespace {
+	// taken by the first log message on a thread that doesn't fit its inline buffer
+	struct OverflowBuffer {
+		std::string m_Text;
+		bool        m_InUse = false;
+	};
+
+	thread_local OverflowBuffer t_Overflow;
+
+	constexpr size_t k_MaxRetainedOverflow = 64 * 1024; // larger buffers are released again
+}
 
 namespace hecate::core::logger {
+	// forwards whatever is streamed to the current target message
+	class LogMessage::StreamAdapter:
+		public std::streambuf
+	{
+	public:
+		StreamAdapter():
+			m_Stream(this)
+		{
+		}
+
+		LogMessage*  m_Target = nullptr;
+		std::ostream m_Stream;
+
+	protected:
+		int_type overflow(int_type c) override {
+			if (!traits_type::eq_int_type(c, traits_type::eof()))
+				m_Target->append(traits_type::to_char_type(c));
+
+			return c;
+		}
+
+		std::streamsize xsputn(const char* text, std::streamsize count) override {
+			m_Target->append(std::string_view(text, static_cast<size_t>(count)));
+			return count;
+		}
+	};
+
 	LogMessage::LogMessage(
-		Logger*            owner,
-		e_LogCategory      category,
-		const std::string& source_file,
-		unsigned int       source_line
+		Logger*       owner,
+		e_LogCategory category,
+		const char*   source_file,
+		unsigned int  source_line
 	):
 		m_Owner(owner),
 		m_MetaInfo{
 			category,
 			source_file,
-			source_line
+			source_line,
+			std::chrono::system_clock::now()
 		}
 	{
 	}
@@ -21,12 +62,77 @@ namespace hecate::core::logger {
 	LogMessage::~LogMessage() {
 		if (m_Owner)
 			m_Owner->flush(this);
-	}
 
+		if (m_OwnsOverflow)
+			delete m_Overflow;
+		else if (m_Overflow) {
+			if (m_Overflow->capacity() > k_MaxRetainedOverflow) {
+				m_Overflow->clear();
+				m_Overflow->shrink_to_fit();
+			}
+
+			t_Overflow.m_InUse = false;
+		}
+	}
 
 	// allow iostream manipulator functions to work on this as well (such as std::endl and std::boolalpha)
 	LogMessage& LogMessage::operator << (std::ostream& (*fn)(std::ostream&)) {
-		(*fn)(m_Buffer);
+		LogMessage*   previous = nullptr;
+		std::ostream& os       = beginStream(previous);
+
+		(*fn)(os);
+
+		endStream(os, previous);
+
 		return *this;
 	}
-}
\ No newline at end of file
+
+	void LogMessage::overflow(size_t required) {
+		if (!t_Overflow.m_InUse) {
+			t_Overflow.m_InUse = true;
+			m_Overflow = &t_Overflow.m_Text;
+		}
+		else {
+			m_Overflow     = new std::string;
+			m_OwnsOverflow = true;
+		}
+
+		m_Overflow->reserve(m_Size + required);
+		m_Overflow->assign(m_Inline, m_Size);
+	}
+
+	std::ostream& LogMessage::beginStream(LogMessage*& previous) {
+		thread_local StreamAdapter adapter;
+
+		previous = adapter.m_Target;
+		adapter.m_Target = this;
+
+		auto& os = adapter.m_Stream;
+
+		os.flags    (m_StreamState.m_Flags);
+		os.precision(m_StreamState.m_Precision);
+		os.width    (m_StreamState.m_Width);
+		os.fill     (m_StreamState.m_Fill);
+
+		return os;
+	}
+
+	void LogMessage::endStream(std::ostream& os, LogMessage* previous) {
+		m_StreamState.m_Flags     = os.flags();
+		m_StreamState.m_Precision = os.precision();
+		m_StreamState.m_Width     = os.width();
+		m_StreamState.m_Fill      = os.fill();
+
+		auto& adapter = static_cast<StreamAdapter&>(*os.rdbuf());
+
+		// a message that was logged while streaming into another one (f.e. from an operator <<)
+		adapter.m_Target = previous;
+
+		if (previous) {
+			os.flags    (previous->m_StreamState.m_Flags);
+			os.precision(previous->m_StreamState.m_Precision);
+			os.width    (previous->m_StreamState.m_Width);
+			os.fill     (previous->m_StreamState.m_Fill);
+		}
+	}
+}
@@ -1,9 +1,16 @@
 #pragma once
 
 #include "log_category.h"
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <ios>
 #include <iosfwd>
-#include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 namespace hecate {
 	class Logger;
@@ -12,27 +19,40 @@ namespace hecate {
 namespace hecate::core::logger {
 	class LogSink;
 
+	namespace detail {
+		// appended directly (numbers via std::format_to), everything else goes through operator << (std::ostream&)
+		template <typename T>
+		concept c_DirectLogValue =
+			std::is_arithmetic_v<T> ||
+			std::convertible_to<const T&, std::string_view>;
+	}
+
 	// string buffer, accumulates the full message and flushes it during destruction
 	//
+	// [NOTE] the text is kept in an inline buffer; longer messages continue in a per-thread overflow
+	//        buffer that keeps its capacity, so a log line normally doesn't allocate at all
+	//
 	class LogMessage {
 	private:
-		friend class Logger;
+		friend class ::hecate::Logger;
 		friend class LogSink;
 
 		LogMessage(
-			Logger*            owner,
-			e_LogCategory      category,
-			const std::string& source_file,
-			unsigned int       source_line
+			Logger*       owner,
+			e_LogCategory category,
+			const char*   source_file, // expected to be a string literal (__FILE__)
+			unsigned int  source_line
 		);
 
-		// no-copy, move-default (moving is questionable though)
-		LogMessage             (const LogMessage&)     = delete;
-		LogMessage& operator = (const LogMessage&)     = delete;
-		LogMessage             (LogMessage&&) noexcept = default;
-		LogMessage& operator = (LogMessage&&) noexcept = default;
+		// no-copy, no-move (the text may live in the inline buffer)
+		LogMessage             (const LogMessage&) = delete;
+		LogMessage& operator = (const LogMessage&) = delete;
+		LogMessage             (LogMessage&&)      = delete;
+		LogMessage& operator = (LogMessage&&)      = delete;
 
 	public:
+		static constexpr size_t k_InlineCapacity = 256; // characters
+
 		~LogMessage();
 
 		// allow additional values to accumulate here
@@ -42,17 +62,57 @@ namespace hecate::core::logger {
 		// allow iostream manipulator functions to work on this as well (such as std::endl and std::boolalpha)
 		LogMessage& operator << (std::ostream& (*fn)(std::ostream&));
 
+		std::string_view getText() const noexcept;
+
+		static constexpr uint32_t k_NoCallsite = ~uint32_t(0);
+
 		struct MetaInfo {
-			e_LogCategory  m_Category;
-			std::string    m_SourceFile;
-			unsigned int   m_SourceLine;
+			e_LogCategory                         m_Category;
+			const char*                           m_SourceFile;
+			unsigned int                          m_SourceLine;
+			std::chrono::system_clock::time_point m_Time; // when the message was created
+
+			// set for deferred g_LogFormat events, the text then holds the encoded arguments (see BinaryLog)
+			uint32_t m_Callsite = k_NoCallsite;
 		};
 
 	private:
-		std::ostringstream m_Buffer;
-		Logger*            m_Owner = nullptr;
-		MetaInfo           m_MetaInfo;
+		class StreamAdapter;
+
+		struct StreamState {
+			std::ios_base::fmtflags m_Flags     = std::ios_base::skipws | std::ios_base::dec;
+			std::streamsize         m_Precision = 6;
+			std::streamsize         m_Width     = 0;
+			char                    m_Fill      = ' ';
+
+			bool operator == (const StreamState&) const = default;
+		};
+
+		void append(std::string_view text);
+		void append(char c);
+		void overflow(size_t required); // moves the text to an overflow buffer with room for 'required' more characters
+
+		template <typename T>
+		void appendDirect(const T& value);
+
+		template <typename T>
+		void appendNumber(std::format_string<const T&> format, const T& value);
+
+		template <typename T>
+		void appendStreamed(const T& value);
+
+		// the per-thread std::ostream for everything else, writing into this message
+		std::ostream& beginStream(LogMessage*& previous); // applies m_StreamState
+		void          endStream(std::ostream& os, LogMessage* previous);
+
+		Logger*      m_Owner = nullptr;
+		MetaInfo     m_MetaInfo;
+		StreamState  m_StreamState;            // only changed by manipulators
+		std::string* m_Overflow     = nullptr; // once the inline buffer is exhausted
+		bool         m_OwnsOverflow = false;   // if the per-thread buffer was already taken (nested log messages)
+		size_t       m_Size         = 0;       // in the inline buffer
+		char         m_Inline[k_InlineCapacity];
 	};
 }
 
-#include "log_message.inl"
\ No newline at end of file
+#include "log_message.inl"
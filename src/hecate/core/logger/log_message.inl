@@ -1,9 +1,101 @@
 #pragma once
 
+#include <cstring>
+#include <iterator>
+#include <ostream>
+
 namespace hecate::core::logger {
 	template <typename T>
 	LogMessage& LogMessage::operator << (const T& value) {
-		m_Buffer << value;
+		if constexpr (detail::c_DirectLogValue<T>) {
+			// manipulators only affect values that go through the stream
+			if (m_StreamState == StreamState()) {
+				appendDirect(value);
+				return *this;
+			}
+		}
+
+		appendStreamed(value);
 		return *this;
 	}
-}
\ No newline at end of file
+
+	inline std::string_view LogMessage::getText() const noexcept {
+		if (m_Overflow)
+			return *m_Overflow;
+
+		return std::string_view(m_Inline, m_Size);
+	}
+
+	inline void LogMessage::append(std::string_view text) {
+		if (!m_Overflow) {
+			if (m_Size + text.size() <= k_InlineCapacity) {
+				std::memcpy(m_Inline + m_Size, text.data(), text.size());
+				m_Size += text.size();
+				return;
+			}
+
+			overflow(text.size());
+		}
+
+		m_Overflow->append(text);
+	}
+
+	inline void LogMessage::append(char c) {
+		if (!m_Overflow) {
+			if (m_Size < k_InlineCapacity) {
+				m_Inline[m_Size++] = c;
+				return;
+			}
+
+			overflow(1);
+		}
+
+		m_Overflow->push_back(c);
+	}
+
+	// the output matches what std::ostream would produce without manipulators
+	template <typename T>
+	void LogMessage::appendDirect(const T& value) {
+		if constexpr (std::is_same_v<T, bool>)
+			append(value ? '1' : '0');
+		else if constexpr (
+			std::is_same_v<T, char>        ||
+			std::is_same_v<T, signed char> ||
+			std::is_same_v<T, unsigned char>
+		)
+			append(static_cast<char>(value));
+		else if constexpr (std::is_floating_point_v<T>)
+			appendNumber<T>("{:.6g}", value); // default stream precision
+		else if constexpr (std::is_arithmetic_v<T>)
+			appendNumber<T>("{}", value);
+		else
+			append(std::string_view(value));
+	}
+
+	template <typename T>
+	void LogMessage::appendNumber(std::format_string<const T&> format, const T& value) {
+		if (!m_Overflow) {
+			size_t available = k_InlineCapacity - m_Size;
+			auto   result    = std::format_to_n(m_Inline + m_Size, available, format, value);
+
+			if (static_cast<size_t>(result.size) <= available) {
+				m_Size += result.size;
+				return;
+			}
+
+			overflow(result.size);
+		}
+
+		std::format_to(std::back_inserter(*m_Overflow), format, value);
+	}
+
+	template <typename T>
+	void LogMessage::appendStreamed(const T& value) {
+		LogMessage*   previous = nullptr;
+		std::ostream& os       = beginStream(previous);
+
+		os << value;
+
+		endStream(os, previous);
+	}
+}
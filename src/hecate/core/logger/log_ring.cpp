@@ -0,0 +1,127 @@
+#include "log_ring.h"
+#include "../logger.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <ostream>
+
+namespace hecate::core::logger {
+	std::ostream& operator << (std::ostream& os, e_LogOverflow overflow) {
+		switch (overflow) {
+		case e_LogOverflow::block:       os << "block";       break;
+		case e_LogOverflow::drop:        os << "drop";        break;
+		case e_LogOverflow::drop_oldest: os << "drop_oldest"; break;
+		}
+
+		return os;
+	}
+
+	e_LogOverflow to_log_overflow(const std::string& name) {
+		if (name == "block")
+			return e_LogOverflow::block;
+
+		if (name == "drop")
+			return e_LogOverflow::drop;
+
+		if (name == "drop_oldest")
+			return e_LogOverflow::drop_oldest;
+
+		g_LogWarning << "Unknown log overflow policy '" << name << "', blocking instead";
+
+		return e_LogOverflow::block;
+	}
+
+	LogRing::LogRing(size_t capacity) {
+		capacity = std::bit_ceil(std::max<size_t>(capacity, 2));
+
+		m_Slots = std::make_unique<Slot[]>(capacity);
+		m_Mask  = capacity - 1;
+
+		for (size_t i = 0; i < capacity; ++i)
+			m_Slots[i].m_Sequence.store(i, std::memory_order_relaxed);
+	}
+
+	bool LogRing::try_push(
+		const LogMessage::MetaInfo& info,
+		std::string_view            message,
+		size_t*                     claimed
+	) {
+		size_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+
+		for (;;) {
+			Slot&    slot     = m_Slots[position & m_Mask];
+			size_t   sequence = slot.m_Sequence.load(std::memory_order_acquire);
+			intptr_t diff     = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+			if (diff == 0) {
+				// the slot is free, try to claim it
+				if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					slot.m_Record.m_Info = info;
+					slot.m_Record.m_Message.assign(message);
+					slot.m_Sequence.store(position + 1, std::memory_order_release);
+
+					if (claimed)
+						*claimed = position;
+
+					return true;
+				}
+			}
+			else if (diff < 0)
+				return false; // the slot still holds a record from the previous lap
+			else
+				position = m_EnqueuePosition.load(std::memory_order_relaxed); // another producer got here first
+		}
+	}
+
+	bool LogRing::try_pop(LogRecord& record) {
+		return dequeue(&record);
+	}
+
+	bool LogRing::try_drop() {
+		return dequeue(nullptr);
+	}
+
+	bool LogRing::dequeue(LogRecord* record) {
+		size_t position = m_DequeuePosition.load(std::memory_order_relaxed);
+
+		for (;;) {
+			Slot&    slot     = m_Slots[position & m_Mask];
+			size_t   sequence = slot.m_Sequence.load(std::memory_order_acquire);
+			intptr_t diff     = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+			if (diff == 0) {
+				if (m_DequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					if (record) {
+						record->m_Info = slot.m_Record.m_Info;
+						record->m_Message.assign(slot.m_Record.m_Message);
+					}
+
+					slot.m_Sequence.store(position + m_Mask + 1, std::memory_order_release);
+
+					return true;
+				}
+			}
+			else if (diff < 0)
+				return false; // nothing was written here yet
+			else
+				position = m_DequeuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	size_t LogRing::get_capacity() const noexcept {
+		return m_Mask + 1;
+	}
+
+	size_t LogRing::get_enqueue_position() const noexcept {
+		return m_EnqueuePosition.load(std::memory_order_acquire);
+	}
+
+	size_t LogRing::get_dequeue_position() const noexcept {
+		return m_DequeuePosition.load(std::memory_order_acquire);
+	}
+
+	bool LogRing::is_empty() const noexcept {
+		return get_dequeue_position() >= get_enqueue_position();
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "log_message.h"
+
+#include <atomic>
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace hecate::core::logger {
+	enum class e_LogOverflow {
+		block,      // wait until the writer thread has made room
+		drop,       // discard the new record
+		drop_oldest // discard the oldest queued record to make room
+	};
+
+	std::ostream& operator << (std::ostream& os, e_LogOverflow overflow);
+
+	e_LogOverflow to_log_overflow(const std::string& name); // "block", "drop" or "drop_oldest"
+
+	struct LogRecord {
+		LogMessage::MetaInfo m_Info;
+		std::string          m_Message;
+	};
+
+	/*
+	*	Bounded multi-producer queue of log records
+	*
+	*	Every slot carries a sequence number that tells whether it is ready to be written or read
+	*	(Vyukov's bounded queue); producers only contend on the enqueue position and never wait on
+	*	each other. Messages are copied into the slot strings and out again, which keeps their
+	*	capacity - once every slot was used a few times, the ring doesn't allocate anymore.
+	*
+	*	Any thread may also consume; the writer thread normally does, but producers do when dropping
+	*	the oldest record or when combining (see Logger), and so does the crash handler when draining
+	*	what's left.
+	*/
+	class LogRing {
+	public:
+		explicit LogRing(size_t capacity); // rounded up to a power of 2
+
+		LogRing             (const LogRing&) = delete;
+		LogRing& operator = (const LogRing&) = delete;
+		LogRing             (LogRing&&)      = delete;
+		LogRing& operator = (LogRing&&)      = delete;
+
+		// returns false if the ring is full, optionally provides the position of the new record
+		bool try_push(
+			const LogMessage::MetaInfo& info,
+			std::string_view            message,
+			size_t*                     position = nullptr
+		);
+
+		bool try_pop (LogRecord& record); // returns false if the ring is empty
+		bool try_drop();                  // discards the oldest record, returns false if the ring is empty
+
+		[[nodiscard]] size_t get_capacity() const noexcept;
+
+		// every record gets a position in the order it was pushed; everything below the dequeue
+		// position has been taken out of the ring
+		[[nodiscard]] size_t get_enqueue_position() const noexcept;
+		[[nodiscard]] size_t get_dequeue_position() const noexcept;
+		[[nodiscard]] bool   is_empty() const noexcept; // approximate while other threads are busy
+
+	private:
+		bool dequeue(LogRecord* record);
+
+		// [NOTE] padded to avoid false sharing between neighbouring producers
+		struct alignas(64) Slot {
+			std::atomic<size_t> m_Sequence = 0;
+			LogRecord           m_Record;
+		};
+
+		std::unique_ptr<Slot[]> m_Slots;
+		size_t                  m_Mask = 0;
+
+		alignas(64) std::atomic<size_t> m_EnqueuePosition = 0;
+		alignas(64) std::atomic<size_t> m_DequeuePosition = 0;
+	};
+}
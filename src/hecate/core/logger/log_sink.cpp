@@ -1,4 +1,5 @@
 #include "log_sink.h"
+#include "binary_log.h"
 #include "../../platform/platform.h"
 
 #include <iostream>
@@ -6,8 +7,22 @@
 #include <chrono>
 #include <filesystem>
 #include <format>
+#include <iterator>
+#include <string_view>
 
 namespace {
+	void write_line(
+		std::ostream&                                     os,
+		std::string&                                      scratch,
+		const hecate::core::logger::LogMessage::MetaInfo& info,
+		std::string_view                                  message
+	) {
+		scratch.clear();
+		hecate::core::logger::format_line(scratch, info, message);
+
+		os << scratch;
+	}
+
 	struct FileSink {
 		FileSink(const std::filesystem::path& p):
 			m_File(p.string())
@@ -18,40 +33,55 @@ namespace {
 
 		void operator()(
 			const hecate::core::logger::LogMessage::MetaInfo& info, 
-			const std::string&                                  message
+			std::string_view                                  message
 		) noexcept {
-			auto now = std::chrono::system_clock::now();
-
-			auto simplified_source_path = std::filesystem::path(info.m_SourceFile)
-				.filename()
-				.string();
-
-			m_File
-				<< std::vformat("{0:%T}", std::make_format_args(now))
-				<< info.m_Category
-				<< message
-				<< " (" << simplified_source_path
-				<< ":" << info.m_SourceLine
-				<< ")\n";
+			write_line(m_File, m_Line, info, message);
+		}
+
+		void flush() {
+			m_File.flush();
 		}
 
 		std::ofstream m_File;
+		std::string   m_Line; // reused between lines
 	};
-}
 
-namespace hecate::core::logger {
-	void LogSink::write(
-		const LogMessage::MetaInfo& info,
-		const std::string&          message
-	) {
-		(*m_Wrapper)(info, message);
-	}
+	struct StreamSink {
+		void operator()(
+			const hecate::core::logger::LogMessage::MetaInfo& info,
+			std::string_view                                  message
+		) {
+			write_line(*m_Stream, m_Line, info, message);
+		}
 
-	LogSink makeStdOutSink() {
-		return [](
-			const LogMessage::MetaInfo& info, 
-			const std::string&          message
+		void flush() {
+			m_Stream->flush();
+		}
+
+		std::ostream* m_Stream;
+		std::string   m_Line;
+	};
+
+	struct BinaryFileSink {
+		void operator()(
+			const hecate::core::logger::LogMessage::MetaInfo& info,
+			std::string_view                                  message
+		) {
+			hecate::core::logger::BinaryLog::instance().write(info, message);
+		}
+
+		void flush() {
+			hecate::core::logger::BinaryLog::instance().flush();
+		}
+	};
+
+	struct StdOutSink {
+		void operator()(
+			const hecate::core::logger::LogMessage::MetaInfo& info,
+			std::string_view                                  message
 		) {
+			using hecate::core::logger::e_LogCategory;
+
 			switch (info.m_Category) {
 			case e_LogCategory::debug:   std::cout << rang::fgB::green;                     break;
 			case e_LogCategory::warning: std::cout << rang::fgB::yellow;                    break;
@@ -64,13 +94,56 @@ namespace hecate::core::logger {
 
 			std::cout << info.m_Category << message << "\n";
 			std::cout << rang::style::reset;
-		};
+		}
+
+		void flush() {
+			std::cout.flush();
+		}
+	};
+}
+
+namespace hecate::core::logger {
+	void LogSink::write(
+		const LogMessage::MetaInfo& info,
+		std::string_view            message
+	) {
+		(*m_Wrapper)(info, message);
+	}
+
+	void LogSink::flush() {
+		m_Wrapper->flush();
+	}
+
+	void format_line(
+		std::string&                out,
+		const LogMessage::MetaInfo& info,
+		std::string_view            message
+	) {
+		// just the filename part of the source path (either separator)
+		std::string_view source = info.m_SourceFile;
+
+		if (auto pos = source.find_last_of("/\\"); pos != std::string_view::npos)
+			source.remove_prefix(pos + 1);
+
+		std::format_to(
+			std::back_inserter(out),
+			"{:%T}{}{} ({}:{})\n",
+			info.m_Time,
+			get_prefix(info.m_Category),
+			message,
+			source,
+			info.m_SourceLine
+		);
+	}
+
+	LogSink makeStdOutSink() {
+		return StdOutSink();
 	}
 
 	LogSink makeStdErrSink() {
 		return [](
 			const LogMessage::MetaInfo& info,
-			const std::string& message
+			std::string_view            message
 		) {
 			std::cerr << info.m_Category << message << "\n";
 		};
@@ -79,4 +152,15 @@ namespace hecate::core::logger {
 	LogSink makeFileSink(const std::filesystem::path& p) {
 		return FileSink(p);
 	}
+
+	LogSink makeStreamSink(std::ostream& os) {
+		return StreamSink{ &os, {} };
+	}
+
+	LogSink makeBinaryFileSink(const std::filesystem::path& p) {
+		if (!BinaryLog::instance().open(p))
+			throw std::runtime_error("Failed to create binary file sink");
+
+		return BinaryFileSink();
+	}
 }
\ No newline at end of file
@@ -4,20 +4,28 @@
 #include "../../preprocessor.h"
 #include <memory>
 #include <filesystem>
+#include <string>
+#include <string_view>
 
 namespace hecate::core::logger {
 	/*
 	* Type-erased interface; this allows storage in a vector
+	*
+	* Sinks may optionally provide flush(), which is called after every batch written by the
+	* asynchronous logger and when draining the log after a crash
+	*
+	* Messages are passed as a std::string_view; sinks that take a const std::string& instead get
+	* a (reused) per-thread copy
 	*/
 
 	template <typename T>
-	concept c_LogSink = requires(
-		T                           sink,
-		const LogMessage::MetaInfo& info,
-		const std::string&          message
-	) {
-		{ sink(info, message) } -> std::convertible_to<void>;
-	};
+	concept c_LogSink =
+		requires(T sink, const LogMessage::MetaInfo& info, std::string_view message) {
+			{ sink(info, message) } -> std::convertible_to<void>;
+		} ||
+		requires(T sink, const LogMessage::MetaInfo& info, const std::string& message) {
+			{ sink(info, message) } -> std::convertible_to<void>;
+		};
 
 	class LogSink {
 	public:
@@ -32,17 +40,21 @@ namespace hecate::core::logger {
 
 		void write(
 			const LogMessage::MetaInfo& info,
-			const std::string&          message
+			std::string_view            message
 		);
 
+		void flush();
+
 	private:
 		struct Prototype {
 			virtual ~Prototype() = default;
 
 			virtual void operator()(
 				const LogMessage::MetaInfo& meta,
-				const std::string&          message
+				std::string_view            message
 			) = 0;
+
+			virtual void flush() = 0;
 		};
 
 		template <c_LogSink T>
@@ -53,9 +65,11 @@ namespace hecate::core::logger {
 
 			virtual void operator()(
 				const LogMessage::MetaInfo& meta,
-				const std::string&          message
+				std::string_view            message
 			) override; 
 
+			virtual void flush() override;
+
 			T m_Impl;
 		};
 
@@ -66,6 +80,17 @@ namespace hecate::core::logger {
 	LogSink makeStdErrSink();   // [logLevel] [message] [\n] ~> std::cerr
 	
 	LogSink makeFileSink(const std::filesystem::path& p); // [timestamp] [loglevel] [message] ([sourcefile]:[linenumber]) [\n] ~> p
+	LogSink makeStreamSink(std::ostream& os);             // same as the file sink, the stream should outlive the sink
+
+	// opens the binary log (see binary_log.h) and stores regular messages there as well
+	LogSink makeBinaryFileSink(const std::filesystem::path& p);
+
+	// [timestamp] [loglevel] [message] ([sourcefile]:[linenumber]) [\n], appended to out
+	void format_line(
+		std::string&                out,
+		const LogMessage::MetaInfo& info,
+		std::string_view            message
+	);
 }
 
 #include "log_sink.inl"
\ No newline at end of file
@@ -18,8 +18,21 @@ namespace hecate::core::logger {
 	template <c_LogSink T>
 	void LogSink::Wrapper<T>::operator()(
 		const LogMessage::MetaInfo& info,
-		const std::string&          message
+		std::string_view            message
 	) {
-		m_Impl(info, message);
+		if constexpr (std::is_invocable_v<T&, const LogMessage::MetaInfo&, std::string_view>)
+			m_Impl(info, message);
+		else {
+			thread_local std::string copy;
+
+			copy.assign(message);
+			m_Impl(info, copy);
+		}
+	}
+
+	template <c_LogSink T>
+	void LogSink::Wrapper<T>::flush() {
+		if constexpr (requires { m_Impl.flush(); })
+			m_Impl.flush();
 	}
 }
\ No newline at end of file
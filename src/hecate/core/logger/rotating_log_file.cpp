@@ -0,0 +1,234 @@
+#include "rotating_log_file.h"
+#include "../metrics.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+
+namespace {
+	const hecate::Metrics::Counter& num_dropped_lines() {
+		static const hecate::Metrics::Counter counter = hecate::Metrics::instance().get_counter("log.dropped");
+		return counter;
+	}
+
+	// LogSink needs something movable
+	struct RotatingFileSink {
+		void operator()(
+			const hecate::core::logger::LogMessage::MetaInfo& info,
+			std::string_view                                  message
+		) {
+			m_File->write(info, message);
+		}
+
+		void flush() {
+			m_File->flush();
+		}
+
+		std::shared_ptr<hecate::core::logger::RotatingLogFile> m_File;
+	};
+}
+
+namespace hecate::core::logger {
+	RotatingLogFile::RotatingLogFile(Config config):
+		m_Config(std::move(config))
+	{
+		m_Config.m_ChunkSize = std::max<size_t>(m_Config.m_ChunkSize, 4096);
+
+		open();
+
+		if (!m_File.is_open())
+			throw std::runtime_error("Failed to create rotating file sink");
+	}
+
+	RotatingLogFile::~RotatingLogFile() {
+		close();
+	}
+
+	void RotatingLogFile::write(
+		const LogMessage::MetaInfo& info,
+		std::string_view            message
+	) {
+		std::lock_guard guard(m_Mutex);
+
+		m_Line.clear();
+		format_line(m_Line, info, message);
+
+		if (m_Size > 0) {
+			bool too_large =
+				m_Config.m_MaxFileSize > 0 &&
+				m_Size + m_Line.size() > m_Config.m_MaxFileSize;
+
+			bool too_old =
+				m_Config.m_MaxFileAge.count() > 0 &&
+				info.m_Time - m_OpenedAt >= m_Config.m_MaxFileAge;
+
+			if (too_large || too_old)
+				rotate_files();
+		}
+
+		if (!reserve(m_Size + m_Line.size())) {
+			num_dropped_lines().add();
+			return;
+		}
+
+		std::memcpy(m_File.get_data() + m_Size, m_Line.data(), m_Line.size());
+		m_Size += m_Line.size();
+
+		// [NOTE] uses the message time, so there's no clock call per line
+		if (info.m_Time - m_LastSync >= m_Config.m_SyncInterval)
+			sync(info.m_Time);
+	}
+
+	void RotatingLogFile::flush() {
+		std::lock_guard guard(m_Mutex);
+
+		auto now = Clock::now();
+
+		if (now - m_LastSync >= m_Config.m_SyncInterval)
+			sync(now);
+	}
+
+	void RotatingLogFile::rotate() {
+		std::lock_guard guard(m_Mutex);
+		rotate_files();
+	}
+
+	void RotatingLogFile::configure(Config config) {
+		config.m_ChunkSize = std::max<size_t>(config.m_ChunkSize, 4096);
+
+		std::lock_guard guard(m_Mutex);
+
+		if (config.m_Path == m_Config.m_Path)
+			m_Config = std::move(config);
+		else {
+			close();
+			m_Config = std::move(config);
+			open();
+		}
+	}
+
+	RotatingLogFile::Config RotatingLogFile::get_config() const {
+		std::lock_guard guard(m_Mutex);
+		return m_Config;
+	}
+
+	size_t RotatingLogFile::get_size() const {
+		std::lock_guard guard(m_Mutex);
+		return m_Size;
+	}
+
+	size_t RotatingLogFile::get_num_rotations() const {
+		std::lock_guard guard(m_Mutex);
+		return m_NumRotations;
+	}
+
+	void RotatingLogFile::rotate_files() {
+		close();
+
+		namespace fs = std::filesystem;
+
+		std::error_code ec; // failing to rotate shouldn't take the logger down; worst case the file is appended to
+
+		if (m_Config.m_MaxFiles == 0)
+			fs::remove(m_Config.m_Path, ec);
+		else {
+			fs::remove(get_rotated_path(m_Config.m_Path, m_Config.m_MaxFiles), ec);
+
+			for (size_t i = m_Config.m_MaxFiles; i > 1; --i) {
+				auto older = get_rotated_path(m_Config.m_Path, i - 1);
+
+				if (fs::exists(older, ec))
+					fs::rename(older, get_rotated_path(m_Config.m_Path, i), ec);
+			}
+
+			fs::rename(m_Config.m_Path, get_rotated_path(m_Config.m_Path, 1), ec);
+		}
+
+		++m_NumRotations;
+
+		open();
+	}
+
+	std::filesystem::path RotatingLogFile::get_rotated_path(
+		const std::filesystem::path& p,
+		size_t                       index
+	) {
+		auto result = p;
+
+		result.replace_filename(
+			p.stem().string() + "." + std::to_string(index) + p.extension().string()
+		);
+
+		return result;
+	}
+
+	void RotatingLogFile::open() {
+		m_Size       = 0;
+		m_SyncedSize = 0;
+		m_OpenedAt   = Clock::now();
+		m_LastSync   = m_OpenedAt;
+
+		if (!m_File.open(m_Config.m_Path))
+			return;
+
+		// continue after what is already there; after a crash that is followed by zero padding
+		if (const char* data = m_File.get_data()) {
+			size_t size = m_File.get_size();
+
+			while (size > 0 && data[size - 1] == '\0')
+				--size;
+
+			m_Size       = size;
+			m_SyncedSize = size;
+
+			// [NOTE] an older file is continued, so it should also be rotated as soon as it's due
+			if (size > 0)
+				m_OpenedAt = m_File.get_creation_time();
+		}
+	}
+
+	void RotatingLogFile::close() {
+		if (!m_File.is_open())
+			return;
+
+		m_File.sync(m_SyncedSize, m_Size - m_SyncedSize, false);
+		m_File.close(m_Size);
+
+		m_Size       = 0;
+		m_SyncedSize = 0;
+	}
+
+	bool RotatingLogFile::reserve(size_t num_bytes) {
+		if (!m_File.is_open())
+			return false;
+
+		if (num_bytes <= m_File.get_size())
+			return true;
+
+		size_t chunk    = m_Config.m_ChunkSize;
+		size_t new_size = (num_bytes + chunk - 1) / chunk * chunk;
+
+		// don't pre-allocate beyond the size that would be rotated at
+		if (m_Config.m_MaxFileSize > 0)
+			new_size = std::max(num_bytes, std::min(new_size, m_Config.m_MaxFileSize));
+
+		return m_File.resize(new_size);
+	}
+
+	void RotatingLogFile::sync(Clock::time_point now) {
+		m_File.sync(m_SyncedSize, m_Size - m_SyncedSize, false);
+
+		m_SyncedSize = m_Size;
+		m_LastSync   = now;
+	}
+
+	LogSink makeRotatingFileSink(RotatingLogFile::Config config) {
+		return RotatingFileSink{ std::make_shared<RotatingLogFile>(std::move(config)) };
+	}
+
+	LogSink makeRotatingFileSink(std::shared_ptr<RotatingLogFile> file) {
+		return RotatingFileSink{ std::move(file) };
+	}
+}
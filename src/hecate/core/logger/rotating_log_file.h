@@ -0,0 +1,94 @@
+#pragma once
+
+#include "log_message.h"
+#include "log_sink.h"
+#include "../../platform/mapped_file.h"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace hecate::core::logger {
+	/*
+	*	Text log that is appended to through a memory mapping
+	*
+	*	The file is pre-allocated and grows in chunks, so writing a line is a copy into the mapping
+	*	instead of a system call. Mapped pages belong to the OS, so whatever was written survives the
+	*	process crashing; the file then ends in zero padding, which is trimmed when it is opened
+	*	again. On a regular close the file is truncated to what was written.
+	*
+	*	The file is rotated when a line wouldn't fit anymore or when it gets too old (by message
+	*	time): hecate.log becomes hecate.1.log, hecate.1.log becomes hecate.2.log etc, up to the
+	*	number of retained files - older ones are deleted. The age of a file that is continued
+	*	counts from when it was created. Written pages are msync'ed (without waiting) at most once
+	*	every sync interval.
+	*
+	*	Thread-safe, so it can be reconfigured while a Logger is writing to it.
+	*/
+	class RotatingLogFile {
+	public:
+		struct Config {
+			std::filesystem::path     m_Path         = "hecate.log";
+			size_t                    m_ChunkSize    = 1 << 20;  // bytes, the file grows in steps of this size
+			size_t                    m_MaxFileSize  = 64 << 20; // bytes, 0 for no limit
+			std::chrono::seconds      m_MaxFileAge   = {};       // 0 for no limit
+			size_t                    m_MaxFiles     = 5;        // rotated files that are kept next to the active one
+			std::chrono::milliseconds m_SyncInterval = std::chrono::seconds(1);
+		};
+
+		explicit RotatingLogFile(Config config); // throws std::runtime_error if the file can't be opened
+		~RotatingLogFile();
+
+		RotatingLogFile             (const RotatingLogFile&) = delete;
+		RotatingLogFile& operator = (const RotatingLogFile&) = delete;
+		RotatingLogFile             (RotatingLogFile&&)      = delete;
+		RotatingLogFile& operator = (RotatingLogFile&&)      = delete;
+
+		void write(
+			const LogMessage::MetaInfo& info,
+			std::string_view            message
+		);
+
+		void flush(); // msyncs if the sync interval has passed
+		void rotate();
+
+		void configure(Config config); // applies from the next line on; a different path closes the current file
+
+		[[nodiscard]] Config get_config() const;
+		[[nodiscard]] size_t get_size() const;          // bytes written to the active file
+		[[nodiscard]] size_t get_num_rotations() const;
+
+		// hecate.log ~> hecate.<index>.log
+		static std::filesystem::path get_rotated_path(
+			const std::filesystem::path& p,
+			size_t                       index
+		);
+
+	private:
+		using Clock = std::chrono::system_clock; // same as the message timestamps
+
+		void open();         // requires m_Mutex
+		void close();        // requires m_Mutex
+		void rotate_files(); // requires m_Mutex
+		bool reserve(size_t num_bytes);
+		void sync(Clock::time_point now);
+
+		mutable std::mutex   m_Mutex;
+		Config               m_Config;
+		platform::MappedFile m_File;
+		size_t               m_Size         = 0; // bytes in use
+		size_t               m_SyncedSize   = 0; // bytes that were msync'ed
+		size_t               m_NumRotations = 0;
+		Clock::time_point    m_OpenedAt;
+		Clock::time_point    m_LastSync;
+		std::string          m_Line;             // reused between lines
+	};
+
+	// [timestamp] [loglevel] [message] ([sourcefile]:[linenumber]) [\n] ~> config.m_Path, see RotatingLogFile
+	LogSink makeRotatingFileSink(RotatingLogFile::Config config);
+	LogSink makeRotatingFileSink(std::shared_ptr<RotatingLogFile> file); // keeps it alive while the sink exists
+}
@@ -0,0 +1,54 @@
+#include "mediator.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+	std::mutex                                       g_PostedMutex;
+	std::vector<hecate::core::detail::DispatchPosted> g_PostedQueues;
+}
+
+namespace hecate {
+	void dispatch_posted_messages() {
+		// [NOTE] handlers may post messages of a type that wasn't used before, which registers another queue;
+		//        so don't hold the lock while dispatching
+		for (size_t i = 0; ; ++i) {
+			core::detail::DispatchPosted fn;
+
+			{
+				std::lock_guard guard(g_PostedMutex);
+
+				if (i >= g_PostedQueues.size())
+					break;
+
+				fn = g_PostedQueues[i];
+			}
+
+			fn();
+		}
+	}
+
+	namespace core::detail {
+		thread_local const DeliveryGate::Running* DeliveryGate::t_Running = nullptr;
+
+		void register_posted_queue(DispatchPosted fn) {
+			std::lock_guard guard(g_PostedMutex);
+			g_PostedQueues.push_back(fn);
+		}
+
+		void DeliveryGate::close() {
+			m_Open.store(false);
+
+			// a handler that detaches itself (or drains a mailbox that does) would otherwise wait for itself
+			uint32_t num_own = 0;
+
+			for (const Running* running = t_Running; running; running = running->m_Previous)
+				if (running->m_Gate == this)
+					++num_own;
+
+			while (m_InFlight.load(std::memory_order_acquire) > num_own)
+				std::this_thread::yield();
+		}
+	}
+}
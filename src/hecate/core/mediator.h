@@ -1,23 +1,67 @@
 #pragma once
 
+#include "delivery_policy.h"
+#include "executor.h"
+#include "detail/topic_traits.h"
+
 namespace hecate {
+    enum class e_HandlerExceptions {
+        propagate, // out of broadcast() (or the executor); the remaining handlers are skipped
+        trap       // logged as a warning, the remaining handlers are still called
+    };
+
+    // with an executor other than immediate, messages are copied and handed to that executor instead of
+    // calling the handler directly; f.e. Executor::on(system->get_mailbox()) delivers on the thread that
+    // updates that system
+    // [NOTE] detaching such a handler waits for deliveries that are running on other threads, so it can be
+    //        destroyed afterwards; don't detach while holding a lock that the handler itself takes
     template <typename T, typename H>
-    void attach_handler(H* handler);
+    void attach_handler(
+        H*                  handler,
+        Executor            executor   = Executor::immediate(),
+        e_HandlerExceptions exceptions = e_HandlerExceptions::propagate
+    );
 
     template <typename T, typename H>
     void detach_handler(H* handler);
 
     template <typename T>
-    void detach_all_handlers();
+    void detach_all_handlers(); // subscriptions to T included
+
+    // only receive the messages for which t_Extract(message) == key, f.e.
+    //     subscribe<&Keyboard::OnKeyPressed::key>(this, Keyboard::e_Key::escape);
+    // where t_Extract is a data member pointer, a function or a captureless lambda taking the message;
+    // dispatching only touches the handlers that were subscribed to the key of the message
+    template <auto t_Extract, typename H>
+    void subscribe(
+        H*                                       handler,
+        const core::detail::TopicKey<t_Extract>& key,
+        e_HandlerExceptions                      exceptions = e_HandlerExceptions::propagate
+    );
 
+    template <auto t_Extract, typename H>
+    void unsubscribe(
+        H*                                       handler,
+        const core::detail::TopicKey<t_Extract>& key
+    );
+
+    // handlers are called immediately, on the calling thread; unless DeliveryPolicy<T> specifies otherwise
     template <typename T>
     void broadcast(const T& message);
 
+    template <typename T>
+    void post(T message); // queued (from any thread), handlers are called during the next dispatch_posted_messages()
+
+    void dispatch_posted_messages(); // the engine calls this on the main thread at the start of every frame
+
     // [NOTE] this *can* be used as a base class, but it's not required
     template <typename T>
     class MessageHandler {
     public:
-        MessageHandler();
+        explicit MessageHandler(
+            Executor            executor   = Executor::immediate(),
+            e_HandlerExceptions exceptions = e_HandlerExceptions::propagate
+        );
         virtual ~MessageHandler();
 
         MessageHandler             (const MessageHandler&)     = default;
@@ -2,11 +2,17 @@
 
 #include "mediator.h"
 #include "detail/mediator_queue.h"
+#include "detail/static_route.h"
+#include "detail/topic_index.h"
 
 namespace hecate {
     template <typename T, typename H>
-    void attach_handler(H* handler) {
-        core::detail::MediatorQueue<T>::instance().attach(handler);
+    void attach_handler(
+        H*                  handler,
+        Executor            executor,
+        e_HandlerExceptions exceptions
+    ) {
+        core::detail::MediatorQueue<T>::instance().attach(handler, executor, exceptions);
     }
 
     template <typename T, typename H>
@@ -19,14 +25,50 @@ namespace hecate {
         core::detail::MediatorQueue<T>::instance().detach_all();
     }
 
+    template <auto E, typename H>
+    void subscribe(
+        H*                               handler,
+        const core::detail::TopicKey<E>& key,
+        e_HandlerExceptions              exceptions
+    ) {
+        core::detail::TopicIndex<E>::instance().subscribe(handler, key, exceptions);
+    }
+
+    template <auto E, typename H>
+    void unsubscribe(
+        H*                               handler,
+        const core::detail::TopicKey<E>& key
+    ) {
+        core::detail::TopicIndex<E>::instance().unsubscribe(handler, key);
+    }
+
     template <typename T>
     void broadcast(const T& message) {
-        core::detail::MediatorQueue<T>::instance().broadcast(message);
+        if constexpr (DeliveryPolicy<T>::k_Delivery == e_Delivery::immediate) {
+            // receivers bound to a StaticBus first, if any; a type that is only routed statically skips the queue
+            bool routed = core::detail::StaticRoute<T>::dispatch(message);
+
+            if (!routed || core::detail::MediatorQueue<T>::has_handlers())
+                core::detail::MediatorQueue<T>::instance().broadcast(message);
+        }
+        else
+            core::detail::MediatorQueue<T>::instance().coalesce(message);
+    }
+
+    template <typename T>
+    void post(T message) {
+        if constexpr (DeliveryPolicy<T>::k_Delivery == e_Delivery::immediate)
+            core::detail::MediatorQueue<T>::instance().post(std::move(message));
+        else
+            core::detail::MediatorQueue<T>::instance().coalesce(message);
     }
 
     template <typename T>
-    MessageHandler<T>::MessageHandler() {
-        attach_handler<T>(this);
+    MessageHandler<T>::MessageHandler(
+        Executor            executor,
+        e_HandlerExceptions exceptions
+    ) {
+        attach_handler<T>(this, executor, exceptions);
     }
 
     template <typename T>
@@ -0,0 +1,252 @@
+#include "message_recording.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace {
+	template <typename U>
+	void write_raw(std::ostream& os, const U& value) {
+		os.write(reinterpret_cast<const char*>(&value), sizeof(U));
+	}
+
+	template <typename U>
+	bool read_raw(std::span<const std::byte>& data, U& value) {
+		if (data.size() < sizeof(U))
+			return false;
+
+		std::memcpy(&value, data.data(), sizeof(U));
+		data = data.subspan(sizeof(U));
+
+		return true;
+	}
+}
+
+namespace hecate {
+	MessageRecorder::MessageRecorder() {
+	}
+
+	MessageRecorder::~MessageRecorder() {
+		stop();
+	}
+
+	bool MessageRecorder::start(const std::string& filename) {
+		stop();
+
+		std::lock_guard guard(m_Mutex);
+
+		m_Out.open(filename, std::ios::binary | std::ios::trunc);
+
+		if (!m_Out)
+			return false;
+
+		m_Out.write(k_Magic.data(), k_Magic.size());
+		write_raw(m_Out, k_Version);
+
+		for (const auto& channel : m_Channels) {
+			declare(*channel);
+			channel->attach();
+		}
+
+		m_Start       = std::chrono::steady_clock::now();
+		m_NumMessages = 0;
+
+		return true;
+	}
+
+	void MessageRecorder::stop() {
+		std::lock_guard guard(m_Mutex);
+
+		if (!m_Out.is_open())
+			return;
+
+		// [NOTE] a broadcast on another thread may still be about to write; write_record() checks for that
+		for (const auto& channel : m_Channels)
+			channel->detach();
+
+		m_Out.close();
+	}
+
+	bool MessageRecorder::is_recording() const {
+		std::lock_guard guard(m_Mutex);
+		return m_Out.is_open();
+	}
+
+	size_t MessageRecorder::get_num_messages() const {
+		std::lock_guard guard(m_Mutex);
+		return m_NumMessages;
+	}
+
+	void MessageRecorder::declare(const ChannelBase& channel) {
+		// declarations are timestamped at the start, they aren't messages
+		write_raw(m_Out, uint64_t(0));
+		write_raw(m_Out, k_DeclareChannel);
+		write_raw(m_Out, static_cast<uint32_t>(sizeof(uint16_t) + channel.m_Name.size()));
+		write_raw(m_Out, channel.m_ID);
+
+		m_Out.write(channel.m_Name.data(), channel.m_Name.size());
+	}
+
+	void MessageRecorder::write_record(
+		uint16_t                   channel,
+		std::span<const std::byte> payload
+	) {
+		std::lock_guard guard(m_Mutex);
+
+		if (!m_Out.is_open())
+			return;
+
+		auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_Start);
+
+		write_raw(m_Out, static_cast<uint64_t>(time.count()));
+		write_raw(m_Out, channel);
+		write_raw(m_Out, static_cast<uint32_t>(payload.size()));
+
+		m_Out.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+
+		++m_NumMessages;
+	}
+
+	bool MessageReplayer::open(const std::string& filename) {
+		m_Entries.clear();
+		m_Payloads.clear();
+		m_Next       = 0;
+		m_NumSkipped = 0;
+
+		std::ifstream in(filename, std::ios::binary | std::ios::ate);
+
+		if (!in)
+			return false;
+
+		std::vector<std::byte> contents(static_cast<size_t>(in.tellg()));
+
+		in.seekg(0);
+		in.read(reinterpret_cast<char*>(contents.data()), contents.size());
+
+		std::span<const std::byte> data = contents;
+
+		std::array<char, 4> magic   = {};
+		uint32_t            version = 0;
+
+		if (
+			!read_raw(data, magic)                    ||
+			(magic != MessageRecorder::k_Magic)       ||
+			!read_raw(data, version)                  ||
+			(version != MessageRecorder::k_Version)
+		) {
+			g_LogWarning << filename << " is not a message recording (or an unsupported version)";
+			return false;
+		}
+
+		std::vector<Decoder> channels; // decoder per channel id, nullptr for unregistered types
+
+		while (!data.empty()) {
+			uint64_t time    = 0;
+			uint16_t channel = 0;
+			uint32_t size    = 0;
+
+			if (
+				!read_raw(data, time)    ||
+				!read_raw(data, channel) ||
+				!read_raw(data, size)    ||
+				(data.size() < size)
+			) {
+				// f.e. when the application was killed while recording; keep what we have
+				g_LogWarning << filename << " is truncated, replaying " << m_Entries.size() << " messages";
+				break;
+			}
+
+			auto payload = data.first(size);
+			data = data.subspan(size);
+
+			if (channel == MessageRecorder::k_DeclareChannel) {
+				uint16_t id = 0;
+
+				if (!read_raw(payload, id))
+					continue;
+
+				std::string_view name(reinterpret_cast<const char*>(payload.data()), payload.size());
+
+				auto it = std::find_if(
+					std::begin(m_Types),
+					std::end(m_Types),
+					[name](const Type& t) { return t.m_Name == name; }
+				);
+
+				if (channels.size() <= id)
+					channels.resize(id + 1);
+
+				channels[id] = (it != std::end(m_Types)) ? it->m_Decoder : nullptr;
+
+				continue;
+			}
+
+			if ((channel >= channels.size()) || !channels[channel]) {
+				++m_NumSkipped;
+				continue;
+			}
+
+			Entry e;
+
+			e.m_Time    = Duration(time);
+			e.m_Decoder = channels[channel];
+			e.m_Offset  = m_Payloads.size();
+			e.m_Size    = size;
+
+			m_Payloads.insert(std::end(m_Payloads), std::begin(payload), std::end(payload));
+			m_Entries.push_back(e);
+		}
+
+		// messages from different threads may have been written slightly out of order
+		std::stable_sort(
+			std::begin(m_Entries),
+			std::end(m_Entries),
+			[](const Entry& a, const Entry& b) { return a.m_Time < b.m_Time; }
+		);
+
+		return true;
+	}
+
+	void MessageReplayer::rewind() {
+		m_Next = 0;
+	}
+
+	size_t MessageReplayer::advance(Duration elapsed) {
+		size_t count = 0;
+
+		while ((m_Next < m_Entries.size()) && (m_Entries[m_Next].m_Time <= elapsed)) {
+			replay_entry(m_Entries[m_Next++]);
+			++count;
+		}
+
+		return count;
+	}
+
+	size_t MessageReplayer::replay_all() {
+		return advance(Duration::max());
+	}
+
+	bool MessageReplayer::is_finished() const noexcept {
+		return m_Next >= m_Entries.size();
+	}
+
+	MessageReplayer::Duration MessageReplayer::get_duration() const noexcept {
+		if (m_Entries.empty())
+			return Duration::zero();
+
+		return m_Entries.back().m_Time;
+	}
+
+	size_t MessageReplayer::get_num_messages() const noexcept {
+		return m_Entries.size();
+	}
+
+	size_t MessageReplayer::get_num_skipped() const noexcept {
+		return m_NumSkipped;
+	}
+
+	void MessageReplayer::replay_entry(const Entry& entry) const {
+		entry.m_Decoder(std::span<const std::byte>(m_Payloads).subspan(entry.m_Offset, entry.m_Size));
+	}
+}
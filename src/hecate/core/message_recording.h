@@ -0,0 +1,182 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace hecate {
+	class RecordWriter {
+	public:
+		explicit RecordWriter(std::vector<std::byte>& buffer);
+
+		template <typename U>
+		requires std::is_trivially_copyable_v<U>
+		void write(const U& value);
+
+	private:
+		std::vector<std::byte>& m_Buffer;
+	};
+
+	class RecordReader {
+	public:
+		explicit RecordReader(std::span<const std::byte> payload);
+
+		template <typename U>
+		requires std::is_trivially_copyable_v<U>
+		U read(); // throws std::runtime_error when reading past the end of the payload
+
+	private:
+		std::span<const std::byte> m_Payload;
+	};
+
+	/*
+	*	Per message type serialization for MessageRecorder/MessageReplayer; specialize this next to
+	*	the message type to make it recordable
+	*
+	*		template <>
+	*		struct RecordedMessage<OnKeyPressed> {
+	*			static constexpr const char* k_Name = "input::Keyboard::OnKeyPressed";
+	*
+	*			static void         save(RecordWriter& writer, const OnKeyPressed& message);
+	*			static OnKeyPressed load(RecordReader& reader);
+	*		};
+	*
+	*	The name identifies the type in a recording, so it should not change once recordings exist.
+	*
+	*	[NOTE] pointers (devices, windows) are meaningless in another session; save the values only
+	*	       and leave the pointers as nullptr when loading
+	*/
+	template <typename T>
+	struct RecordedMessage;
+
+	template <typename T>
+	concept c_RecordedMessage = requires(RecordWriter& writer, RecordReader& reader, const T& message) {
+		{ RecordedMessage<T>::k_Name }                 -> std::convertible_to<std::string_view>;
+		{ RecordedMessage<T>::save(writer, message) };
+		{ RecordedMessage<T>::load(reader) }          -> std::same_as<T>;
+	};
+
+	/*
+	*	Writes every broadcast of the selected message types to a compact, timestamped binary file
+	*
+	*		MessageRecorder rec;
+	*		rec.record<Keyboard::OnKeyPressed>();
+	*		rec.record<Mouse::OnMoved>();
+	*		rec.start("session.hcr");
+	*
+	*	Handlers are attached while recording (immediate delivery), so whatever the handlers of a
+	*	type receive is recorded - for coalesced types that's the merged message. Broadcasts may come
+	*	from any thread; writes are serialized and timestamped relative to start().
+	*
+	*	File layout (native endianness): "HCRC", u32 version, then records of
+	*	{ u64 time (ns), u16 channel, u32 size, payload }. Channel k_DeclareChannel declares the
+	*	u16 channel id + name of a message type before it is first used.
+	*/
+	class MessageRecorder {
+	public:
+		static constexpr uint32_t k_Version        = 1;
+		static constexpr uint16_t k_DeclareChannel = 0xFFFF;
+
+		static constexpr std::array<char, 4> k_Magic = { 'H', 'C', 'R', 'C' };
+
+		MessageRecorder();
+		~MessageRecorder(); // stops recording
+
+		MessageRecorder             (const MessageRecorder&) = delete;
+		MessageRecorder& operator = (const MessageRecorder&) = delete;
+		MessageRecorder             (MessageRecorder&&)      = delete;
+		MessageRecorder& operator = (MessageRecorder&&)      = delete;
+
+		template <c_RecordedMessage T>
+		void record(); // may be called before or during a recording
+
+		bool start(const std::string& filename); // returns false if the file could not be opened
+		void stop();                             // detaches the handlers again
+
+		[[nodiscard]] bool   is_recording()     const;
+		[[nodiscard]] size_t get_num_messages() const; // in the current (or last) recording
+
+	private:
+		struct ChannelBase {
+			virtual ~ChannelBase() = default;
+
+			virtual void attach() = 0;
+			virtual void detach() = 0;
+
+			std::string m_Name;
+			uint16_t    m_ID = 0;
+		};
+
+		template <typename T>
+		struct Channel;
+
+		void declare(const ChannelBase& channel); // requires m_Mutex
+		void write_record(uint16_t channel, std::span<const std::byte> payload);
+
+		mutable std::mutex                        m_Mutex;
+		std::ofstream                             m_Out;
+		std::chrono::steady_clock::time_point     m_Start;
+		size_t                                    m_NumMessages = 0;
+		std::vector<std::unique_ptr<ChannelBase>> m_Channels;
+	};
+
+	/*
+	*	Broadcasts the messages of a recording again, either following the original timing via
+	*	advance() or all at once via replay_all(); messages are broadcast on the calling thread
+	*
+	*	Types that were recorded but not registered with replay<T>() are skipped.
+	*/
+	class MessageReplayer {
+	public:
+		using Duration = std::chrono::nanoseconds;
+
+		template <c_RecordedMessage T>
+		void replay(); // register before open()
+
+		bool open(const std::string& filename); // loads the entire recording; returns false if it is missing or invalid
+		void rewind();
+
+		size_t advance(Duration elapsed); // broadcasts all messages recorded up to 'elapsed' since the start; returns the number broadcast
+		size_t replay_all();              // broadcasts all remaining messages
+
+		[[nodiscard]] bool     is_finished()      const noexcept;
+		[[nodiscard]] Duration get_duration()     const noexcept; // timestamp of the last message
+		[[nodiscard]] size_t   get_num_messages() const noexcept; // that can be replayed
+		[[nodiscard]] size_t   get_num_skipped()  const noexcept; // recorded messages of unregistered types
+
+	private:
+		using Decoder = void(*)(std::span<const std::byte> payload); // load + broadcast
+
+		struct Type {
+			std::string m_Name;
+			Decoder     m_Decoder = nullptr;
+		};
+
+		struct Entry {
+			Duration m_Time;
+			Decoder  m_Decoder = nullptr;
+			size_t   m_Offset  = 0; // into m_Payloads
+			size_t   m_Size    = 0;
+		};
+
+		void replay_entry(const Entry& entry) const;
+
+		std::vector<Type>      m_Types;
+		std::vector<Entry>     m_Entries;
+		std::vector<std::byte> m_Payloads;
+		size_t                 m_Next       = 0;
+		size_t                 m_NumSkipped = 0;
+	};
+}
+
+#include "message_recording.inl"
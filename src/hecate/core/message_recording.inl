@@ -0,0 +1,109 @@
+#pragma once
+
+#include "message_recording.h"
+#include "mediator.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace hecate {
+	inline RecordWriter::RecordWriter(std::vector<std::byte>& buffer):
+		m_Buffer(buffer)
+	{
+	}
+
+	template <typename U>
+	requires std::is_trivially_copyable_v<U>
+	void RecordWriter::write(const U& value) {
+		size_t offset = m_Buffer.size();
+
+		m_Buffer.resize(offset + sizeof(U));
+		std::memcpy(m_Buffer.data() + offset, &value, sizeof(U));
+	}
+
+	inline RecordReader::RecordReader(std::span<const std::byte> payload):
+		m_Payload(payload)
+	{
+	}
+
+	template <typename U>
+	requires std::is_trivially_copyable_v<U>
+	U RecordReader::read() {
+		if (m_Payload.size() < sizeof(U))
+			throw std::runtime_error("Recorded message is truncated");
+
+		U result;
+		std::memcpy(&result, m_Payload.data(), sizeof(U));
+
+		m_Payload = m_Payload.subspan(sizeof(U));
+
+		return result;
+	}
+
+	template <typename T>
+	struct MessageRecorder::Channel:
+		ChannelBase
+	{
+		Channel(MessageRecorder* owner, uint16_t id):
+			m_Owner(owner)
+		{
+			m_Name = RecordedMessage<T>::k_Name;
+			m_ID   = id;
+		}
+
+		void attach() override {
+			attach_handler<T>(this);
+		}
+
+		void detach() override {
+			detach_handler<T>(this);
+		}
+
+		void operator()(const T& message) {
+			thread_local std::vector<std::byte> t_Buffer;
+
+			t_Buffer.clear();
+
+			RecordWriter writer(t_Buffer);
+			RecordedMessage<T>::save(writer, message);
+
+			m_Owner->write_record(m_ID, t_Buffer);
+		}
+
+		MessageRecorder* m_Owner = nullptr;
+	};
+
+	template <c_RecordedMessage T>
+	void MessageRecorder::record() {
+		std::lock_guard guard(m_Mutex);
+
+		for (const auto& channel : m_Channels)
+			if (channel->m_Name == RecordedMessage<T>::k_Name)
+				return;
+
+		if (m_Channels.size() >= k_DeclareChannel)
+			throw std::runtime_error("Too many recorded message types");
+
+		auto channel = std::make_unique<Channel<T>>(this, static_cast<uint16_t>(m_Channels.size()));
+
+		if (m_Out.is_open()) {
+			declare(*channel);
+			channel->attach();
+		}
+
+		m_Channels.push_back(std::move(channel));
+	}
+
+	template <c_RecordedMessage T>
+	void MessageReplayer::replay() {
+		Type t;
+
+		t.m_Name    = RecordedMessage<T>::k_Name;
+		t.m_Decoder = [](std::span<const std::byte> payload) {
+			RecordReader reader(payload);
+			broadcast<T>(RecordedMessage<T>::load(reader));
+		};
+
+		m_Types.push_back(std::move(t));
+	}
+}
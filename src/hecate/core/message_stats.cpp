@@ -0,0 +1,211 @@
+#include "message_stats.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+
+namespace {
+	struct RegisteredMessage {
+		std::string              m_Type; // readable type name, which is also what the metrics are named after
+		std::vector<std::string> m_Handlers;
+	};
+
+	std::mutex                     g_StatsMutex;
+	std::vector<RegisteredMessage> g_Registered;
+
+	RegisteredMessage& find_or_add(const std::string& message_type) { // requires g_StatsMutex
+		for (auto& m : g_Registered)
+			if (m.m_Type == message_type)
+				return m;
+
+		g_Registered.push_back({ message_type, {} });
+
+		return g_Registered.back();
+	}
+
+	std::string get_prefix(const std::string& message_type) {
+		return "messages." + message_type + ".";
+	}
+
+	// registration happens inside broadcast(), which shouldn't throw because of statistics; the
+	// metric is left out instead (f.e. when the metric slots run out)
+	void warn_registration_failed(const std::exception& ex) {
+		static std::atomic_bool warned = false;
+
+		if (!warned.exchange(true))
+			g_LogWarning << "Message statistics are incomplete: " << ex.what();
+	}
+
+	uint64_t get_total_time(const hecate::MessageStatistics& stats) {
+		uint64_t result = 0;
+
+		for (const auto& h : stats.m_Handlers)
+			result += h.m_Latency.m_Sum;
+
+		return result;
+	}
+}
+
+namespace hecate {
+	std::vector<MessageStatistics> get_message_statistics() {
+		std::vector<RegisteredMessage> registered;
+
+		{
+			std::lock_guard guard(g_StatsMutex);
+			registered = g_Registered;
+		}
+
+		auto snapshot = Metrics::instance().take_snapshot();
+
+		std::unordered_map<std::string, const Metrics::Value*> values;
+
+		for (const auto& v : snapshot.m_Values)
+			values[v.m_Name] = &v;
+
+		auto find = [&](const std::string& name) -> const Metrics::Value* {
+			auto it = values.find(name);
+			return (it != values.end()) ? it->second : nullptr;
+		};
+
+		std::vector<MessageStatistics> result;
+
+		for (const auto& m : registered) {
+			auto prefix = get_prefix(m.m_Type);
+
+			MessageStatistics stats;
+
+			stats.m_Message = m.m_Type;
+
+			if (auto* v = find(prefix + "broadcasts"))    stats.m_Broadcasts   = v->m_Counter;
+			if (auto* v = find(prefix + "handler_calls")) stats.m_HandlerCalls = v->m_Counter;
+			if (auto* v = find(prefix + "exceptions"))    stats.m_Exceptions   = v->m_Counter;
+
+			for (const auto& h : m.m_Handlers) {
+				HandlerStatistics handler;
+
+				handler.m_Handler = h;
+
+				if (auto* v = find(prefix + "latency." + h))
+					handler.m_Latency = v->m_Histogram;
+
+				stats.m_Handlers.push_back(std::move(handler));
+			}
+
+			std::sort(
+				std::begin(stats.m_Handlers),
+				std::end(stats.m_Handlers),
+				[](const HandlerStatistics& a, const HandlerStatistics& b) {
+					return a.m_Latency.m_Sum > b.m_Latency.m_Sum;
+				}
+			);
+
+			result.push_back(std::move(stats));
+		}
+
+		std::stable_sort(
+			std::begin(result),
+			std::end(result),
+			[](const MessageStatistics& a, const MessageStatistics& b) {
+				return get_total_time(a) > get_total_time(b);
+			}
+		);
+
+		return result;
+	}
+
+	void write_message_statistics(std::ostream& os) {
+		// [NOTE] latency percentiles are the upper bounds of the histogram buckets (powers of 2)
+		for (const auto& m : get_message_statistics()) {
+			os << std::format(
+				"{}: {} dispatched, {} handler calls, {} exceptions, {:.3f} ms in handlers\n",
+				m.m_Message,
+				m.m_Broadcasts,
+				m.m_HandlerCalls,
+				m.m_Exceptions,
+				get_total_time(m) / 1e6
+			);
+
+			for (const auto& h : m.m_Handlers) {
+				const auto& l = h.m_Latency;
+
+				os << std::format(
+					"    {}: {} calls, p50 < {} ns, p99 < {} ns, max < {} ns, {:.3f} ms total\n",
+					h.m_Handler,
+					l.m_Count,
+					l.m_P50,
+					l.m_P99,
+					l.m_Max,
+					l.m_Sum / 1e6
+				);
+			}
+		}
+	}
+
+	bool write_message_statistics(const std::string& filename) {
+		std::ofstream out(filename);
+
+		if (!out)
+			return false;
+
+		write_message_statistics(out);
+
+		return static_cast<bool>(out);
+	}
+
+	namespace core::detail {
+		MessageCounters register_message_stats(const std::string& message_type) {
+			auto  prefix  = get_prefix(message_type);
+			auto& metrics = Metrics::instance();
+
+			MessageCounters result;
+
+			try {
+				result = {
+					metrics.get_counter(prefix + "broadcasts"),
+					metrics.get_counter(prefix + "handler_calls"),
+					metrics.get_counter(prefix + "exceptions")
+				};
+			}
+			catch (const std::exception& ex) {
+				warn_registration_failed(ex);
+				return {};
+			}
+
+			std::lock_guard guard(g_StatsMutex);
+			find_or_add(message_type);
+
+			return result;
+		}
+
+		Metrics::Histogram register_handler_stats(
+			const std::string& message_type,
+			const std::string& handler_type
+		) {
+			Metrics::Histogram result;
+
+			try {
+				result = Metrics::instance().get_histogram(get_prefix(message_type) + "latency." + handler_type);
+			}
+			catch (const std::exception& ex) {
+				warn_registration_failed(ex);
+				return {};
+			}
+
+			std::lock_guard guard(g_StatsMutex);
+
+			auto& handlers = find_or_add(message_type).m_Handlers;
+
+			// [NOTE] handlers with a polymorphic type are registered once per thread that calls them
+			if (std::find(std::begin(handlers), std::end(handlers), handler_type) == std::end(handlers))
+				handlers.push_back(handler_type);
+
+			return result;
+		}
+	}
+}
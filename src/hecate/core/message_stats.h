@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "metrics.h"
+#include "../preprocessor.h"
+
+namespace hecate {
+	/*
+	*	Mediator instrumentation
+	*
+	*	Per message type: the number of messages dispatched, handler calls and handler exceptions
+	*	(trapped as well as propagated). Per handler type (the dynamic type for polymorphic handlers such
+	*	as MessageHandler<T>): a latency histogram, in nanoseconds.
+	*	These are regular metrics, so they also end up in the engine metrics snapshots (named after the
+	*	readable type names):
+	*
+	*		messages.<type>.broadcasts
+	*		messages.<type>.handler_calls
+	*		messages.<type>.exceptions
+	*		messages.<type>.latency.<handler type>
+	*
+	*	Compiling with HECATE_MESSAGE_STATS=0 removes all of it. Timing costs two clock reads per
+	*	handler call, which is a lot compared to the call itself, so it is off until switched on via
+	*	set_handler_timing() (or the 'handler_timing' engine setting); the counters are always kept.
+	*
+	*	[NOTE] handlers with an executor are timed when they actually run, on the executor thread
+	*	[NOTE] handler calls are counted as they happen, so handlers skipped by a propagated exception aren't
+	*	[NOTE] a TopicIndex isn't a handler of its own here; its subscribers are counted and timed instead
+	*	[NOTE] latencies include nested dispatches
+	*	[NOTE] receivers bound to a StaticBus are not part of this, nor are routed broadcasts without dynamic handlers
+	*/
+	struct HandlerStatistics {
+		std::string               m_Handler; // readable type name
+		Metrics::HistogramSummary m_Latency; // nanoseconds
+	};
+
+	struct MessageStatistics {
+		std::string m_Message; // readable type name
+		uint64_t    m_Broadcasts   = 0;
+		uint64_t    m_HandlerCalls = 0;
+		uint64_t    m_Exceptions   = 0;
+
+		std::vector<HandlerStatistics> m_Handlers; // most total time spent first
+	};
+
+	std::vector<MessageStatistics> get_message_statistics(); // every message type dispatched so far, most handler time first
+
+	void write_message_statistics(std::ostream& os);           // human-readable table
+	bool write_message_statistics(const std::string& filename); // returns false if the file could not be written
+
+	void set_handler_timing(bool enabled) noexcept; // runtime toggle, disabled by default
+	bool is_handler_timing_enabled() noexcept;
+
+	namespace core::detail {
+		inline constexpr bool k_MessageStats = (HECATE_MESSAGE_STATS != 0);
+
+		inline std::atomic_bool g_HandlerTiming = false;
+
+		struct MessageCounters {
+			Metrics::Counter m_Broadcasts;
+			Metrics::Counter m_HandlerCalls;
+			Metrics::Counter m_Exceptions;
+		};
+
+		// registered on first use
+		template <typename T>
+		const MessageCounters& get_message_counters();
+
+		template <typename T, typename H>
+		Metrics::Histogram get_handler_latency(const H& handler); // per dynamic type of the handler
+
+		// based on the readable type names (see util::get_type_name), which is also what the metrics are named after
+		MessageCounters    register_message_stats(const std::string& message_type);
+		Metrics::Histogram register_handler_stats(const std::string& message_type, const std::string& handler_type);
+
+		class HandlerTimer {
+		public:
+			explicit HandlerTimer(Metrics::Histogram latency) noexcept;
+			~HandlerTimer();
+
+			HandlerTimer             (const HandlerTimer&) = delete;
+			HandlerTimer& operator = (const HandlerTimer&) = delete;
+			HandlerTimer             (HandlerTimer&&)      = delete;
+			HandlerTimer& operator = (HandlerTimer&&)      = delete;
+
+		private:
+			Metrics::Histogram m_Latency;
+			int64_t            m_Begin = 0;
+		};
+	}
+}
+
+#include "message_stats.inl"
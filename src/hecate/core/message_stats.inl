@@ -0,0 +1,73 @@
+#pragma once
+
+#include "message_stats.h"
+#include "../util/type_name.h"
+
+#include <chrono>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace hecate {
+	inline void set_handler_timing(bool enabled) noexcept {
+		core::detail::g_HandlerTiming.store(enabled, std::memory_order_relaxed);
+	}
+
+	inline bool is_handler_timing_enabled() noexcept {
+		return core::detail::g_HandlerTiming.load(std::memory_order_relaxed);
+	}
+
+	namespace core::detail {
+		template <typename T>
+		const MessageCounters& get_message_counters() {
+			static const MessageCounters counters = register_message_stats(util::get_type_name<T>());
+			return counters;
+		}
+
+		template <typename T, typename H>
+		Metrics::Histogram get_handler_latency(const H& handler) {
+			if constexpr (std::is_polymorphic_v<H>) {
+				// [NOTE] f.e. every System attaches itself as a MessageHandler<T>*, so the dynamic type is what
+				//        tells handlers apart; it's looked up in a small per-thread cache
+				struct CacheEntry {
+					const std::type_info* m_Type;
+					Metrics::Histogram    m_Latency;
+				};
+
+				thread_local std::vector<CacheEntry> t_Cache;
+
+				const std::type_info& type = typeid(handler);
+
+				for (const auto& entry : t_Cache)
+					if (*entry.m_Type == type)
+						return entry.m_Latency;
+
+				auto latency = register_handler_stats(util::get_type_name<T>(), util::demangle(type.name()));
+
+				t_Cache.push_back({ &type, latency });
+
+				return latency;
+			}
+			else {
+				static const Metrics::Histogram latency = register_handler_stats(util::get_type_name<T>(), util::get_type_name<H>());
+				return latency;
+			}
+		}
+
+		inline int64_t handler_timer_now() noexcept {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()
+			).count();
+		}
+
+		inline HandlerTimer::HandlerTimer(Metrics::Histogram latency) noexcept:
+			m_Latency(latency),
+			m_Begin  (handler_timer_now())
+		{
+		}
+
+		inline HandlerTimer::~HandlerTimer() {
+			m_Latency.record(static_cast<uint64_t>(handler_timer_now() - m_Begin));
+		}
+	}
+}
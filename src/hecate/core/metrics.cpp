@@ -0,0 +1,278 @@
+#include "metrics.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+namespace {
+	thread_local bool t_Exiting = false; // the metrics shard of this thread was already released
+
+	uint64_t bucket_upper_bound(size_t bucket) {
+		if (bucket == 0)
+			return 0;
+
+		if (bucket >= 64)
+			return std::numeric_limits<uint64_t>::max();
+
+		return (uint64_t(1) << bucket) - 1;
+	}
+}
+
+namespace hecate {
+	thread_local Metrics::Shard* Metrics::t_Shard = nullptr;
+
+	Metrics& Metrics::instance() {
+		static Metrics m;
+		return m;
+	}
+
+	Metrics::Counter Metrics::get_counter(const std::string& name) {
+		Counter result;
+		result.m_Slot = register_metric(name, e_Type::counter, 1).m_Slot;
+		return result;
+	}
+
+	Metrics::Gauge Metrics::get_gauge(const std::string& name) {
+		Gauge result;
+		result.m_Value = register_metric(name, e_Type::gauge, 0).m_Gauge.get();
+		return result;
+	}
+
+	Metrics::Histogram Metrics::get_histogram(const std::string& name) {
+		Histogram result;
+		result.m_Slot = register_metric(name, e_Type::histogram, 2 + k_HistogramBuckets).m_Slot;
+		return result;
+	}
+
+	const Metrics::Entry& Metrics::register_metric(
+		const std::string& name,
+		e_Type             type,
+		uint32_t           num_slots
+	) {
+		std::lock_guard guard(m_Mutex);
+
+		for (const auto& entry : m_Entries)
+			if (entry.m_Name == name) {
+				if (entry.m_Type != type)
+					throw std::runtime_error("Metric '" + name + "' was already registered with a different type");
+
+				return entry;
+			}
+
+		if (m_NextSlot + num_slots > k_MaxSlots)
+			throw std::runtime_error("Out of metric slots while registering '" + name + "'");
+
+		Entry entry;
+
+		entry.m_Name = name;
+		entry.m_Type = type;
+		entry.m_Slot = m_NextSlot;
+
+		if (type == e_Type::gauge)
+			entry.m_Gauge = std::make_unique<std::atomic<double>>(0.0);
+
+		m_NextSlot += num_slots;
+
+		return m_Entries.emplace_back(std::move(entry));
+	}
+
+	size_t Metrics::get_num_shards() const {
+		std::lock_guard guard(m_Mutex);
+		return m_Shards.size();
+	}
+
+	Metrics::Shard* Metrics::register_thread() {
+		// hands the shard back when the thread exits; metrics recorded after that (by other thread_local
+		// destructors) get a shard of their own, which is kept
+		struct Release {
+			~Release() {
+				if (t_Shard)
+					instance().release_thread(t_Shard);
+
+				t_Shard   = nullptr;
+				t_Exiting = true;
+			}
+		};
+
+		if (!t_Exiting) {
+			static thread_local Release release;
+			(void)release;
+		}
+
+		std::unique_ptr<Shard> shard;
+
+		{
+			std::lock_guard guard(m_Mutex);
+
+			if (!m_FreeShards.empty()) {
+				shard = std::move(m_FreeShards.back());
+				m_FreeShards.pop_back();
+			}
+		}
+
+		if (!shard)
+			shard = std::make_unique<Shard>();
+
+		t_Shard = shard.get();
+
+		std::lock_guard guard(m_Mutex);
+		m_Shards.push_back(std::move(shard));
+
+		return t_Shard;
+	}
+
+	void Metrics::release_thread(Shard* shard) {
+		std::lock_guard guard(m_Mutex);
+
+		auto it = std::find_if(
+			std::begin(m_Shards),
+			std::end(m_Shards),
+			[shard](const std::unique_ptr<Shard>& ptr) {
+				return ptr.get() == shard;
+			}
+		);
+
+		if (it == std::end(m_Shards))
+			return;
+
+		// [NOTE] under the lock, so a snapshot sees the counts either in the shard or in the retired total
+		for (size_t i = 0; i < k_MaxSlots; ++i)
+			m_Retired[i] += shard->m_Slots[i].load(std::memory_order_relaxed);
+
+		for (auto& slot : shard->m_Slots)
+			slot.store(0, std::memory_order_relaxed);
+
+		m_FreeShards.push_back(std::move(*it));
+		m_Shards.erase(it);
+	}
+
+	uint64_t Metrics::sum_slot(uint32_t slot) const {
+		uint64_t result = m_Retired[slot];
+
+		for (const auto& shard : m_Shards)
+			result += shard->m_Slots[slot].load(std::memory_order_relaxed);
+
+		return result;
+	}
+
+	Metrics::Snapshot Metrics::take_snapshot(
+		uint64_t frame,
+		double   time
+	) const {
+		Snapshot result;
+
+		result.m_Frame = frame;
+		result.m_Time  = time;
+
+		std::lock_guard guard(m_Mutex);
+
+		result.m_Values.reserve(m_Entries.size());
+
+		for (const auto& entry : m_Entries) {
+			Value v;
+
+			v.m_Name = entry.m_Name;
+			v.m_Type = entry.m_Type;
+
+			switch (entry.m_Type) {
+			case e_Type::counter:
+				v.m_Counter = sum_slot(entry.m_Slot);
+				break;
+
+			case e_Type::gauge:
+				v.m_Gauge = entry.m_Gauge->load(std::memory_order_relaxed);
+				break;
+
+			case e_Type::histogram: {
+				auto& h = v.m_Histogram;
+
+				h.m_Count = sum_slot(entry.m_Slot);
+				h.m_Sum   = sum_slot(entry.m_Slot + 1);
+
+				for (uint32_t i = 0; i < k_HistogramBuckets; ++i)
+					h.m_Buckets[i] = sum_slot(entry.m_Slot + 2 + i);
+
+				// approximate percentiles from the buckets (shards may be mid-update, so don't rely on m_Count)
+				uint64_t total = 0;
+				for (auto b : h.m_Buckets)
+					total += b;
+
+				uint64_t accumulated = 0;
+
+				for (size_t i = 0; i < k_HistogramBuckets; ++i) {
+					if (h.m_Buckets[i] == 0)
+						continue;
+
+					uint64_t previous = accumulated;
+					accumulated += h.m_Buckets[i];
+
+					if ((previous < (total + 1) / 2) && (accumulated >= (total + 1) / 2))
+						h.m_P50 = bucket_upper_bound(i);
+
+					if ((previous * 100 < total * 99) && (accumulated * 100 >= total * 99))
+						h.m_P99 = bucket_upper_bound(i);
+
+					h.m_Max = bucket_upper_bound(i);
+				}
+				break;
+			}
+			}
+
+			result.m_Values.push_back(std::move(v));
+		}
+
+		return result;
+	}
+
+	void Metrics::write_json(std::ostream& os, const Snapshot& snapshot) {
+		using nlohmann::json;
+
+		json js;
+
+		js["frame"] = snapshot.m_Frame;
+		js["time"]  = snapshot.m_Time;
+
+		json& values = js["metrics"] = json::object();
+
+		for (const auto& v : snapshot.m_Values) {
+			switch (v.m_Type) {
+			case e_Type::counter:
+				values[v.m_Name] = v.m_Counter;
+				break;
+
+			case e_Type::gauge:
+				values[v.m_Name] = v.m_Gauge;
+				break;
+
+			case e_Type::histogram:
+				values[v.m_Name] = {
+					{ "count", v.m_Histogram.m_Count },
+					{ "sum",   v.m_Histogram.m_Sum },
+					{ "p50",   v.m_Histogram.m_P50 },
+					{ "p99",   v.m_Histogram.m_P99 },
+					{ "max",   v.m_Histogram.m_Max }
+				};
+				break;
+			}
+		}
+
+		os << js.dump();
+	}
+
+	std::ostream& operator << (std::ostream& os, Metrics::e_Type type) {
+		switch (type) {
+		case Metrics::e_Type::counter:   os << "counter";   break;
+		case Metrics::e_Type::gauge:     os << "gauge";     break;
+		case Metrics::e_Type::histogram: os << "histogram"; break;
+
+		default:
+			os << "[unknown]";
+			break;
+		}
+
+		return os;
+	}
+}
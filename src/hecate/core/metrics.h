@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hecate {
+	/*
+	*	Engine-wide metrics: named counters, gauges and histograms
+	*
+	*	Counters and histograms are sharded per thread; each thread only ever writes to its own
+	*	shard (plain relaxed loads/stores, no read-modify-write), and taking a snapshot sums all
+	*	shards. When a thread exits its counts are folded into a retired total and the shard is
+	*	handed to the next thread that needs one. Gauges hold a single value, the last write wins.
+	*
+	*	Registration takes a lock, so keep the handle around (f.e. in a function-local static):
+	*
+	*		static auto c = Metrics::instance().get_counter("my_system.items");
+	*		c.add(n);
+	*
+	*	Default-constructed counters and histograms are valid but discard what is recorded, so they
+	*	can stand in when registration fails.
+	*/
+	class Metrics {
+	public:
+		static constexpr size_t k_MaxSlots         = 4096; // per thread shard
+		static constexpr size_t k_HistogramBuckets = 65;   // bucket i holds values in [2^(i-1), 2^i), so any uint64_t fits
+		static constexpr size_t k_ScratchSlots     = 2 + k_HistogramBuckets; // after k_MaxSlots, never reported
+
+		enum class e_Type {
+			counter,
+			gauge,
+			histogram
+		};
+
+		class Counter {
+		public:
+			void add(uint64_t amount = 1) const noexcept;
+
+		private:
+			friend class Metrics;
+
+			uint32_t m_Slot = k_MaxSlots; // scratch
+		};
+
+		class Gauge {
+		public:
+			void set(double value) const noexcept;
+
+		private:
+			friend class Metrics;
+
+			std::atomic<double>* m_Value = nullptr;
+		};
+
+		class Histogram {
+		public:
+			void record(uint64_t value) const noexcept;
+
+		private:
+			friend class Metrics;
+
+			uint32_t m_Slot = k_MaxSlots; // count, sum, then the buckets; scratch by default
+		};
+
+		struct HistogramSummary {
+			uint64_t m_Count = 0;
+			uint64_t m_Sum   = 0;
+			uint64_t m_P50   = 0; // upper bound of the bucket containing the percentile
+			uint64_t m_P99   = 0;
+			uint64_t m_Max   = 0; // upper bound of the highest non-empty bucket
+
+			std::array<uint64_t, k_HistogramBuckets> m_Buckets = {};
+		};
+
+		struct Value {
+			std::string      m_Name;
+			e_Type           m_Type      = e_Type::counter;
+			uint64_t         m_Counter   = 0;
+			double           m_Gauge     = 0;
+			HistogramSummary m_Histogram;
+		};
+
+		struct Snapshot {
+			uint64_t           m_Frame = 0;
+			double             m_Time  = 0; // seconds
+			std::vector<Value> m_Values;
+		};
+
+		static Metrics& instance();
+
+		Metrics             (const Metrics&) = delete;
+		Metrics& operator = (const Metrics&) = delete;
+		Metrics             (Metrics&&)      = delete;
+		Metrics& operator = (Metrics&&)      = delete;
+
+		// registering the same name twice returns the same metric; throws if the type differs or space runs out
+		Counter   get_counter  (const std::string& name);
+		Gauge     get_gauge    (const std::string& name);
+		Histogram get_histogram(const std::string& name);
+
+		Snapshot take_snapshot(uint64_t frame = 0, double time = 0) const;
+
+		[[nodiscard]] size_t get_num_shards() const; // in use by live threads
+
+		static void write_json(std::ostream& os, const Snapshot& snapshot); // a single line of JSON
+
+	private:
+		Metrics() = default;
+
+		struct Shard {
+			std::array<std::atomic<uint64_t>, k_MaxSlots + k_ScratchSlots> m_Slots = {};
+		};
+
+		struct Entry {
+			std::string                          m_Name;
+			e_Type                               m_Type  = e_Type::counter;
+			uint32_t                             m_Slot  = 0;
+			std::unique_ptr<std::atomic<double>> m_Gauge;
+		};
+
+		static Shard& get_shard() noexcept;
+		static void   bump(uint32_t slot, uint64_t amount) noexcept;
+
+		Shard* register_thread();
+		void   release_thread(Shard* shard);
+
+		const Entry& register_metric(const std::string& name, e_Type type, uint32_t num_slots);
+
+		uint64_t sum_slot(uint32_t slot) const; // requires m_Mutex
+
+		mutable std::mutex                  m_Mutex;
+		std::deque<Entry>                   m_Entries; // deque so that existing entries don't move
+		std::vector<std::unique_ptr<Shard>> m_Shards;     // in use
+		std::vector<std::unique_ptr<Shard>> m_FreeShards; // zeroed, left behind by threads that exited
+		std::array<uint64_t, k_MaxSlots>    m_Retired = {}; // counts of threads that exited
+		uint32_t                            m_NextSlot = 0;
+
+		static thread_local Shard* t_Shard;
+	};
+
+	std::ostream& operator << (std::ostream& os, Metrics::e_Type type);
+}
+
+#include "metrics.inl"
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "metrics.h"
+
+#include <bit>
+
+namespace hecate {
+	inline Metrics::Shard& Metrics::get_shard() noexcept {
+		Shard* shard = t_Shard;
+
+		if (!shard) [[unlikely]]
+			shard = instance().register_thread();
+
+		return *shard;
+	}
+
+	inline void Metrics::bump(uint32_t slot, uint64_t amount) noexcept {
+		// only the owning thread writes to a shard, so this doesn't need to be an atomic increment
+		auto& value = get_shard().m_Slots[slot];
+		value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+	inline void Metrics::Counter::add(uint64_t amount) const noexcept {
+		bump(m_Slot, amount);
+	}
+
+	inline void Metrics::Gauge::set(double value) const noexcept {
+		if (m_Value)
+			m_Value->store(value, std::memory_order_relaxed);
+	}
+
+	inline void Metrics::Histogram::record(uint64_t value) const noexcept {
+		size_t bucket = std::bit_width(value); // at most 64
+
+		bump(m_Slot,                                      1);
+		bump(m_Slot + 1,                                  value);
+		bump(m_Slot + 2 + static_cast<uint32_t>(bucket),  1);
+	}
+}
@@ -0,0 +1,249 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <tuple>
+
+namespace {
+	thread_local bool t_Exiting = false; // the profiler buffer of this thread was already released
+
+	int64_t steady_nanoseconds() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()
+		).count();
+	}
+
+	void write_json_string(std::ostream& os, const char* str) {
+		os << '"';
+
+		for (const char* c = str; *c; ++c) {
+			switch (*c) {
+			case '"':  os << "\\\""; break;
+			case '\\': os << "\\\\"; break;
+			case '\n': os << "\\n";  break;
+			case '\t': os << "\\t";  break;
+
+			default:
+				if (static_cast<unsigned char>(*c) < 0x20)
+					os << ' ';
+				else
+					os << *c;
+				break;
+			}
+		}
+
+		os << '"';
+	}
+}
+
+namespace hecate {
+	thread_local Profiler::ThreadBuffer* Profiler::t_Buffer = nullptr;
+
+	Profiler::Profiler():
+		m_StartTicks      (now()),
+		m_StartNanoseconds(steady_nanoseconds())
+	{
+	}
+
+	Profiler::~Profiler() {
+	}
+
+	Profiler& Profiler::instance() {
+		static Profiler p;
+		return p;
+	}
+
+	void Profiler::set_enabled(bool enabled) noexcept {
+		s_Enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	void Profiler::set_thread_name(const std::string& name) {
+		ThreadBuffer* buffer = t_Buffer;
+
+		if (!buffer)
+			buffer = register_thread();
+
+		std::lock_guard guard(m_Mutex);
+		buffer->m_ThreadName = name;
+	}
+
+	const char* Profiler::intern(const std::string& name) {
+		std::lock_guard guard(m_Mutex);
+
+		for (const auto& str : m_InternedNames)
+			if (str == name)
+				return str.c_str();
+
+		return m_InternedNames.emplace_back(name).c_str();
+	}
+
+	void Profiler::clear() {
+		std::lock_guard guard(m_Mutex);
+
+		for (auto& buffer : m_Threads)
+			buffer->m_Head.store(0, std::memory_order_relaxed);
+	}
+
+	size_t Profiler::get_num_buffers() const {
+		std::lock_guard guard(m_Mutex);
+		return m_Threads.size();
+	}
+
+	Profiler::ThreadBuffer* Profiler::register_thread() {
+		// hands the buffer back when the thread exits; zones recorded after that (by other thread_local
+		// destructors) get a buffer of their own, like before
+		struct Release {
+			~Release() {
+				if (t_Buffer)
+					instance().release_thread(t_Buffer);
+
+				t_Buffer  = nullptr;
+				t_Exiting = true;
+			}
+		};
+
+		if (!t_Exiting) {
+			static thread_local Release release;
+			(void)release;
+		}
+
+		{
+			std::lock_guard guard(m_Mutex);
+
+			for (auto& buffer : m_Threads) {
+				if (buffer->m_InUse)
+					continue;
+
+				// [NOTE] the zones of the previous thread are dropped at this point
+				buffer->m_InUse = true;
+				buffer->m_ThreadName.clear();
+				buffer->m_Head.store(0, std::memory_order_relaxed);
+
+				t_Buffer = buffer.get();
+
+				return t_Buffer;
+			}
+		}
+
+		auto buffer = std::make_unique<ThreadBuffer>();
+
+		buffer->m_Events = std::make_unique<Event[]>(k_EventsPerThread);
+
+		std::lock_guard guard(m_Mutex);
+
+		buffer->m_ThreadID = static_cast<uint32_t>(m_Threads.size() + 1);
+		t_Buffer = buffer.get();
+
+		m_Threads.push_back(std::move(buffer));
+
+		return t_Buffer;
+	}
+
+	void Profiler::release_thread(ThreadBuffer* buffer) {
+		std::lock_guard guard(m_Mutex);
+		buffer->m_InUse = false;
+	}
+
+	double Profiler::get_ticks_per_microsecond() const {
+#if HECATE_PROFILER_RDTSC
+		// calibrate against the steady clock over the lifetime of the profiler
+		const uint64_t ticks       = now() - m_StartTicks;
+		const int64_t  nanoseconds = steady_nanoseconds() - m_StartNanoseconds;
+
+		if ((nanoseconds <= 0) || (ticks == 0))
+			return 1000.0; // assume ~1GHz, the trace will be off but still readable
+
+		return static_cast<double>(ticks) / (static_cast<double>(nanoseconds) / 1000.0);
+#else
+		return 1000.0; // ticks are nanoseconds
+#endif
+	}
+
+	void Profiler::write_chrome_trace(std::ostream& os) const {
+		const double ticks_per_us = get_ticks_per_microsecond();
+
+		std::lock_guard guard(m_Mutex);
+
+		// timestamps are in microseconds, keep nanosecond resolution
+		const auto old_flags     = os.flags();
+		const auto old_precision = os.precision();
+
+		os << std::fixed << std::setprecision(3);
+
+		os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+		bool first = true;
+
+		auto separator = [&] {
+			if (!first)
+				os << ",\n";
+
+			first = false;
+		};
+
+		for (const auto& buffer : m_Threads) {
+			if (!buffer->m_ThreadName.empty()) {
+				separator();
+
+				os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->m_ThreadID << ",\"args\":{\"name\":";
+				write_json_string(os, buffer->m_ThreadName.c_str());
+				os << "}}";
+			}
+
+			// the owning thread may still be recording, so only take what definitely won't be overwritten
+			const uint64_t head      = buffer->m_Head.load(std::memory_order_acquire);
+			const uint64_t first_idx = (head > k_EventsPerThread) ? head - k_EventsPerThread : 0;
+
+			std::vector<std::tuple<const char*, uint64_t, uint64_t>> events;
+			events.reserve(static_cast<size_t>(head - first_idx));
+
+			for (uint64_t i = first_idx; i < head; ++i) {
+				const Event& event = buffer->m_Events[i & (k_EventsPerThread - 1)];
+
+				events.emplace_back(
+					event.m_Name .load(std::memory_order_relaxed),
+					event.m_Begin.load(std::memory_order_relaxed),
+					event.m_End  .load(std::memory_order_relaxed)
+				);
+			}
+
+			const uint64_t new_head = buffer->m_Head.load(std::memory_order_acquire);
+			const uint64_t valid    = (new_head >= k_EventsPerThread) ? new_head - k_EventsPerThread + 1 : 0;
+			const size_t   skip     = static_cast<size_t>(std::min(std::max(valid, first_idx) - first_idx, head - first_idx));
+
+			for (size_t i = skip; i < events.size(); ++i) {
+				const auto& [name, begin, end] = events[i];
+
+				if (!name)
+					continue;
+
+				const double ts  = static_cast<double>(static_cast<int64_t>(begin - m_StartTicks)) / ticks_per_us;
+				const double dur = static_cast<double>(end - begin)          / ticks_per_us;
+
+				separator();
+
+				os << "{\"name\":";
+				write_json_string(os, name);
+				os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->m_ThreadID << ",\"ts\":" << ts << ",\"dur\":" << dur << "}";
+			}
+		}
+
+		os << "]}\n";
+
+		os.flags    (old_flags);
+		os.precision(old_precision);
+	}
+
+	bool Profiler::write_chrome_trace(const std::string& filename) const {
+		std::ofstream out(filename);
+
+		if (!out.good())
+			return false;
+
+		write_chrome_trace(out);
+
+		return out.good();
+	}
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../preprocessor.h"
+
+namespace hecate {
+	/*
+	*	Scoped-zone profiler
+	*
+	*	Zones are recorded into per-thread ring buffers (single writer, no locks on the hot path);
+	*	when a ring is full the oldest zones are overwritten. Timestamps are raw CPU ticks where
+	*	available, converted to wall time only when the trace is written. Recording a zone only
+	*	touches thread-local and class-static state, not the singleton itself.
+	*
+	*	The buffer of a thread that exits stays in the trace until a new thread takes it over, so
+	*	short-lived threads don't each add another buffer.
+	*
+	*	The trace is written in the Chrome trace event format, which can be loaded in
+	*	chrome://tracing or https://ui.perfetto.dev
+	*
+	*	Use HECATE_PROFILE_SCOPE("name") to record a zone; the name must outlive the profiler
+	*	(string literals, or strings obtained via Profiler::intern). Compiling with HECATE_PROFILING=0
+	*	removes all zones entirely.
+	*/
+	class Profiler {
+	public:
+		static constexpr size_t k_EventsPerThread = 1 << 15; // power of 2
+
+		static Profiler& instance();
+
+		~Profiler();
+
+		Profiler             (const Profiler&) = delete;
+		Profiler& operator = (const Profiler&) = delete;
+		Profiler             (Profiler&&)      = delete;
+		Profiler& operator = (Profiler&&)      = delete;
+
+		static uint64_t now() noexcept; // in ticks
+
+		static void set_enabled(bool enabled) noexcept; // runtime toggle, enabled by default
+		static bool is_enabled() noexcept;
+
+		static void record(
+			const char* name,
+			uint64_t    begin,
+			uint64_t    end
+		) noexcept;
+
+		void set_thread_name(const std::string& name); // for the calling thread
+
+		const char* intern(const std::string& name); // provides a stable pointer for a dynamic zone name
+
+		void clear(); // should not be used while other threads are recording
+
+		size_t get_num_buffers() const; // allocated so far, including the ones left behind by threads that exited
+
+		void write_chrome_trace(std::ostream& os) const;
+		bool write_chrome_trace(const std::string& filename) const; // returns false if the file could not be written
+
+	private:
+		Profiler();
+
+		struct Event {
+			std::atomic<const char*> m_Name  = nullptr;
+			std::atomic<uint64_t>    m_Begin = 0;
+			std::atomic<uint64_t>    m_End   = 0;
+		};
+
+		struct ThreadBuffer {
+			std::unique_ptr<Event[]> m_Events;
+			std::atomic<uint64_t>    m_Head     = 0; // total number of events written
+			uint32_t                 m_ThreadID = 0;
+			std::string              m_ThreadName;   // guarded by m_Mutex
+			bool                     m_InUse    = true; // guarded by m_Mutex, cleared when the thread exits
+		};
+
+		ThreadBuffer* register_thread();
+		void          release_thread(ThreadBuffer* buffer);
+
+		double get_ticks_per_microsecond() const;
+
+		inline static std::atomic_bool s_Enabled = true;
+
+		mutable std::mutex                         m_Mutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> m_Threads;
+		std::deque<std::string>                    m_InternedNames; // deque keeps the strings in place
+
+		// calibration reference for tick -> time conversion
+		uint64_t m_StartTicks = 0;
+		int64_t  m_StartNanoseconds = 0;
+
+		static thread_local ThreadBuffer* t_Buffer;
+	};
+
+	class ProfileScope {
+	public:
+		explicit ProfileScope(const char* name) noexcept;
+		~ProfileScope();
+
+		ProfileScope             (const ProfileScope&) = delete;
+		ProfileScope& operator = (const ProfileScope&) = delete;
+		ProfileScope             (ProfileScope&&)      = delete;
+		ProfileScope& operator = (ProfileScope&&)      = delete;
+
+	private:
+		const char* m_Name  = nullptr; // nullptr if the profiler was disabled at the start of the scope
+		uint64_t    m_Begin = 0;
+	};
+}
+
+#define HECATE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define HECATE_PROFILE_CONCAT(a, b) HECATE_PROFILE_CONCAT_IMPL(a, b)
+
+#if HECATE_PROFILING
+	#define HECATE_PROFILE_SCOPE(name) \
+		::hecate::ProfileScope HECATE_PROFILE_CONCAT(hecate_profile_scope_, __LINE__)(name)
+#else
+	#define HECATE_PROFILE_SCOPE(name) ((void)0)
+#endif
+
+#include "profiler.inl"
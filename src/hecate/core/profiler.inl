@@ -0,0 +1,66 @@
+#pragma once
+
+#include "profiler.h"
+
+#include <chrono>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define HECATE_PROFILER_RDTSC 1
+
+	#if HECATE_COMPILER != HECATE_COMPILER_MSVC
+		#include <x86intrin.h>
+	#else
+		#include <intrin.h>
+	#endif
+#else
+	#define HECATE_PROFILER_RDTSC 0
+#endif
+
+namespace hecate {
+	inline bool Profiler::is_enabled() noexcept {
+		return s_Enabled.load(std::memory_order_relaxed);
+	}
+
+	inline uint64_t Profiler::now() noexcept {
+#if HECATE_PROFILER_RDTSC
+		return __rdtsc();
+#else
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()
+		).count());
+#endif
+	}
+
+	inline void Profiler::record(
+		const char* name,
+		uint64_t    begin,
+		uint64_t    end
+	) noexcept {
+		ThreadBuffer* buffer = t_Buffer;
+
+		if (!buffer) [[unlikely]]
+			buffer = instance().register_thread();
+
+		// only the owning thread writes, the release store publishes the event to the trace writer
+		const uint64_t head  = buffer->m_Head.load(std::memory_order_relaxed);
+		Event&         event = buffer->m_Events[head & (k_EventsPerThread - 1)];
+
+		event.m_Name .store(name,  std::memory_order_relaxed);
+		event.m_Begin.store(begin, std::memory_order_relaxed);
+		event.m_End  .store(end,   std::memory_order_relaxed);
+
+		buffer->m_Head.store(head + 1, std::memory_order_release);
+	}
+
+	inline ProfileScope::ProfileScope(const char* name) noexcept {
+		if (Profiler::is_enabled()) {
+			m_Name  = name;
+			m_Begin = Profiler::now();
+		}
+	}
+
+	inline ProfileScope::~ProfileScope() {
+		if (m_Name)
+			Profiler::record(m_Name, m_Begin, Profiler::now());
+	}
+}
@@ -0,0 +1,319 @@
+#include "scheduler.h"
+#include "logger.h"
+#include "profiler.h"
+
+#include <exception>
+#include <string>
+
+namespace {
+	thread_local const hecate::Scheduler* t_CurrentScheduler = nullptr;
+	thread_local size_t                   t_WorkerIndex      = 0;
+	thread_local uint32_t                 t_RandomState      = 0x9E3779B9u;
+
+	// idle workers yield a couple of times before going to sleep
+	constexpr int k_SpinCount = 64;
+
+	uint32_t next_random() noexcept {
+		// xorshift32
+		uint32_t x = t_RandomState;
+
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+
+		t_RandomState = x;
+		return x;
+	}
+}
+
+namespace hecate {
+	uint64_t Scheduler::Stats::get_total_executed() const noexcept {
+		uint64_t result = m_ExecutedExternally;
+
+		for (const auto& w : m_Workers)
+			result += w.m_Executed;
+
+		return result;
+	}
+
+	uint64_t Scheduler::Stats::get_total_stolen() const noexcept {
+		uint64_t result = 0;
+
+		for (const auto& w : m_Workers)
+			result += w.m_Stolen;
+
+		return result;
+	}
+
+	double Scheduler::Stats::get_steal_ratio() const noexcept {
+		auto executed = get_total_executed();
+
+		if (executed == 0)
+			return 0.0;
+
+		return static_cast<double>(get_total_stolen()) / static_cast<double>(executed);
+	}
+
+	Scheduler::Scheduler(size_t num_workers) {
+		if (num_workers == 0)
+			num_workers = std::max(1u, std::thread::hardware_concurrency());
+
+		// all deques must exist before any of the workers start stealing
+		for (size_t i = 0; i < num_workers; ++i)
+			m_Workers.push_back(std::make_unique<Worker>());
+
+		for (size_t i = 0; i < num_workers; ++i)
+			m_Workers[i]->m_Thread = std::jthread([this, i] {
+				worker_loop(i);
+			});
+	}
+
+	Scheduler::~Scheduler() {
+		{
+			std::lock_guard guard(m_SleepMutex);
+			m_Stopping = true;
+		}
+
+		m_SleepCondition.notify_all();
+
+		for (auto& w : m_Workers)
+			if (w->m_Thread.joinable())
+				w->m_Thread.join();
+
+		// whatever is left over still gets executed, so that nothing waiting on a group is left hanging
+		while (Job* job = acquire_job(k_ExternalThread))
+			execute(job);
+	}
+
+	bool Scheduler::try_execute_one() {
+		size_t idx = (t_CurrentScheduler == this) ? t_WorkerIndex : k_ExternalThread;
+
+		if (Job* job = acquire_job(idx)) {
+			if (idx == k_ExternalThread)
+				m_ExecutedExternally.fetch_add(1, std::memory_order_relaxed);
+			else
+				m_Workers[idx]->m_Executed.fetch_add(1, std::memory_order_relaxed);
+
+			execute(job);
+
+			return true;
+		}
+
+		return false;
+	}
+
+	size_t Scheduler::get_num_workers() const noexcept {
+		return m_Workers.size();
+	}
+
+	bool Scheduler::is_worker_thread() const noexcept {
+		return t_CurrentScheduler == this;
+	}
+
+	Scheduler::Stats Scheduler::get_stats() const {
+		Stats result;
+
+		result.m_Workers.reserve(m_Workers.size());
+
+		for (const auto& w : m_Workers)
+			result.m_Workers.push_back(WorkerStats{
+				w->m_Executed     .load(std::memory_order_relaxed),
+				w->m_Stolen       .load(std::memory_order_relaxed),
+				w->m_StealAttempts.load(std::memory_order_relaxed),
+				w->m_Sleeps       .load(std::memory_order_relaxed)
+			});
+
+		result.m_ExecutedExternally = m_ExecutedExternally.load(std::memory_order_relaxed);
+
+		return result;
+	}
+
+	void Scheduler::reset_stats() {
+		for (auto& w : m_Workers) {
+			w->m_Executed     .store(0, std::memory_order_relaxed);
+			w->m_Stolen       .store(0, std::memory_order_relaxed);
+			w->m_StealAttempts.store(0, std::memory_order_relaxed);
+			w->m_Sleeps       .store(0, std::memory_order_relaxed);
+		}
+
+		m_ExecutedExternally.store(0, std::memory_order_relaxed);
+	}
+
+	void Scheduler::enqueue(Job* job) {
+		if (t_CurrentScheduler == this)
+			m_Workers[t_WorkerIndex]->m_Deque.push(job);
+		else {
+			std::lock_guard guard(m_InjectionMutex);
+			m_InjectionQueue.push_back(job);
+		}
+
+		m_NumQueued.fetch_add(1, std::memory_order_seq_cst);
+
+		// only bother with the mutex if someone may actually be sleeping
+		if (m_NumSleeping.load(std::memory_order_seq_cst) > 0) {
+			{
+				std::lock_guard guard(m_SleepMutex);
+			}
+
+			m_SleepCondition.notify_one();
+		}
+	}
+
+	Scheduler::Job* Scheduler::acquire_job(size_t worker_index) {
+		Job* result = nullptr;
+
+		if (worker_index != k_ExternalThread)
+			result = m_Workers[worker_index]->m_Deque.pop();
+
+		if (!result) {
+			std::lock_guard guard(m_InjectionMutex);
+
+			if (!m_InjectionQueue.empty()) {
+				result = m_InjectionQueue.front();
+				m_InjectionQueue.pop_front();
+			}
+		}
+
+		if (!result)
+			result = steal_job(worker_index);
+
+		if (result)
+			m_NumQueued.fetch_sub(1, std::memory_order_relaxed);
+
+		return result;
+	}
+
+	Scheduler::Job* Scheduler::steal_job(size_t thief_index) {
+		const size_t num_workers = m_Workers.size();
+		const size_t offset      = next_random() % num_workers;
+
+		for (size_t i = 0; i < num_workers; ++i) {
+			size_t victim = (offset + i) % num_workers;
+
+			if (victim == thief_index)
+				continue;
+
+			if (m_Workers[victim]->m_Deque.is_empty())
+				continue;
+
+			if (thief_index != k_ExternalThread)
+				m_Workers[thief_index]->m_StealAttempts.fetch_add(1, std::memory_order_relaxed);
+
+			if (Job* job = m_Workers[victim]->m_Deque.steal()) {
+				if (thief_index != k_ExternalThread)
+					m_Workers[thief_index]->m_Stolen.fetch_add(1, std::memory_order_relaxed);
+
+				return job;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void Scheduler::execute(Job* job) {
+		try {
+			job->m_Fn();
+		}
+		catch (std::exception& ex) {
+			g_LogError << "Task exception: " << ex.what();
+		}
+		catch (...) {
+			g_LogError << "Task exception [unspecified]";
+		}
+
+		TaskGroup* group = job->m_Group;
+		delete job;
+
+		if (group)
+			group->on_task_completed();
+	}
+
+	void Scheduler::worker_loop(size_t worker_index) {
+		t_CurrentScheduler = this;
+		t_WorkerIndex      = worker_index;
+		t_RandomState      = 0x9E3779B9u ^ static_cast<uint32_t>((worker_index + 1) * 0x85EBCA6Bu);
+
+		Profiler::instance().set_thread_name("Worker " + std::to_string(worker_index));
+
+		auto& self = *m_Workers[worker_index];
+
+		while (!m_Stopping.load(std::memory_order_relaxed)) {
+			if (Job* job = acquire_job(worker_index)) {
+				self.m_Executed.fetch_add(1, std::memory_order_relaxed);
+				execute(job);
+				continue;
+			}
+
+			bool has_work = false;
+
+			for (int i = 0; i < k_SpinCount; ++i) {
+				if (m_NumQueued.load(std::memory_order_relaxed) > 0) {
+					has_work = true;
+					break;
+				}
+
+				std::this_thread::yield();
+			}
+
+			if (has_work)
+				continue;
+
+			std::unique_lock lock(m_SleepMutex);
+
+			m_NumSleeping.fetch_add(1, std::memory_order_seq_cst);
+			self.m_Sleeps.fetch_add(1, std::memory_order_relaxed);
+
+			m_SleepCondition.wait(lock, [this] {
+				return
+					m_Stopping.load(std::memory_order_relaxed) ||
+					(m_NumQueued.load(std::memory_order_seq_cst) > 0);
+			});
+
+			m_NumSleeping.fetch_sub(1, std::memory_order_seq_cst);
+		}
+	}
+
+	Scheduler::TaskGroup::TaskGroup(Scheduler& scheduler):
+		m_Scheduler(scheduler)
+	{
+	}
+
+	Scheduler::TaskGroup::~TaskGroup() {
+		wait();
+	}
+
+	void Scheduler::TaskGroup::wait() {
+		while (!is_done())
+			if (!m_Scheduler.try_execute_one())
+				std::this_thread::yield();
+	}
+
+	bool Scheduler::TaskGroup::is_done() const noexcept {
+		return
+			(m_Outstanding.load(std::memory_order_acquire) == 0) &&
+			(m_Finalizing .load(std::memory_order_acquire) == 0);
+	}
+
+	size_t Scheduler::TaskGroup::get_num_outstanding() const noexcept {
+		return m_Outstanding.load(std::memory_order_relaxed);
+	}
+
+	void Scheduler::TaskGroup::on_task_completed() {
+		// m_Finalizing keeps waiters from returning (and destroying the group) while we're still in here
+		m_Finalizing.fetch_add(1, std::memory_order_seq_cst);
+
+		if (m_Outstanding.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+			std::vector<Job*> continuations;
+
+			{
+				std::lock_guard guard(m_ContinuationMutex);
+				continuations.swap(m_Continuations);
+			}
+
+			for (Job* job : continuations)
+				m_Scheduler.enqueue(job);
+		}
+
+		m_Finalizing.fetch_sub(1, std::memory_order_seq_cst);
+	}
+}
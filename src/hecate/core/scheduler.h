@@ -0,0 +1,153 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "detail/work_stealing_deque.h"
+#include "../util/function.h"
+
+/*
+*	Work-stealing task scheduler
+*
+*	Each worker thread owns a deque; tasks submitted from a worker are pushed onto its own
+*	deque, tasks submitted from any other thread go through a shared injection queue.
+*	Idle workers steal from the other workers (oldest tasks first), and sleep when there
+*	is nothing left to do.
+*
+*	Fork/join is done through TaskGroup; a thread waiting on a group helps executing tasks
+*	until the group is done, so waiting from inside a task does not deadlock the pool.
+*/
+namespace hecate {
+	class Scheduler {
+	public:
+		using Task = util::Function<void()>;
+
+		class TaskGroup;
+
+		struct WorkerStats {
+			uint64_t m_Executed      = 0; // tasks executed by this worker
+			uint64_t m_Stolen        = 0; // tasks this worker took from another worker
+			uint64_t m_StealAttempts = 0; // includes the successful ones
+			uint64_t m_Sleeps        = 0; // number of times the worker went idle
+		};
+
+		struct Stats {
+			std::vector<WorkerStats> m_Workers;
+			uint64_t                 m_ExecutedExternally = 0; // tasks executed by non-worker threads while waiting
+
+			uint64_t get_total_executed() const noexcept;
+			uint64_t get_total_stolen()   const noexcept;
+			double   get_steal_ratio()    const noexcept; // stolen / executed
+		};
+
+		explicit Scheduler(size_t num_workers = 0); // 0 will use one worker per hardware thread
+		~Scheduler();
+
+		Scheduler             (const Scheduler&) = delete;
+		Scheduler& operator = (const Scheduler&) = delete;
+		Scheduler             (Scheduler&&)      = delete;
+		Scheduler& operator = (Scheduler&&)      = delete;
+
+		// fire-and-forget
+		template <typename t_Callable>
+		void submit(t_Callable&& fn);
+
+		// calls fn(i) for every i in [begin, end), recursively splitting the range until it is at most grain_size
+		// (0 picks a grain size based on the number of workers); returns when all iterations have completed
+		template <typename t_Callable>
+		void parallel_for(
+			size_t       begin,
+			size_t       end,
+			t_Callable&& fn,
+			size_t       grain_size = 0
+		);
+
+		bool try_execute_one(); // execute a single pending task on the calling thread, if any
+
+		[[nodiscard]] size_t get_num_workers()   const noexcept;
+		[[nodiscard]] bool   is_worker_thread()  const noexcept; // true if called from one of *this* scheduler's workers
+		[[nodiscard]] Stats  get_stats()         const;
+		void                 reset_stats();
+
+	private:
+		struct Job {
+			Task       m_Fn;
+			TaskGroup* m_Group = nullptr;
+		};
+
+		struct alignas(64) Worker {
+			core::detail::WorkStealingDeque<Job> m_Deque;
+			std::jthread                         m_Thread;
+
+			std::atomic<uint64_t> m_Executed      = 0;
+			std::atomic<uint64_t> m_Stolen        = 0;
+			std::atomic<uint64_t> m_StealAttempts = 0;
+			std::atomic<uint64_t> m_Sleeps        = 0;
+		};
+
+		void enqueue(Job* job);
+		Job* acquire_job(size_t worker_index); // pass k_ExternalThread for non-worker threads
+		Job* steal_job(size_t thief_index);
+		void execute(Job* job);
+		void worker_loop(size_t worker_index);
+
+		static constexpr size_t k_ExternalThread = ~size_t(0);
+
+		std::vector<std::unique_ptr<Worker>> m_Workers;
+
+		std::mutex       m_InjectionMutex;
+		std::deque<Job*> m_InjectionQueue;
+
+		std::atomic<int64_t>    m_NumQueued   = 0; // jobs that have been enqueued but not yet picked up
+		std::atomic<int64_t>    m_NumSleeping = 0;
+		std::atomic_bool        m_Stopping    = false;
+		std::mutex              m_SleepMutex;
+		std::condition_variable m_SleepCondition;
+
+		std::atomic<uint64_t> m_ExecutedExternally = 0;
+	};
+
+	// Counts outstanding tasks; wait() blocks (while helping out) until all of them are done
+	// continuations registered with then() are submitted as soon as the group becomes empty
+	class Scheduler::TaskGroup {
+	public:
+		explicit TaskGroup(Scheduler& scheduler);
+		~TaskGroup(); // waits for outstanding tasks
+
+		TaskGroup             (const TaskGroup&) = delete;
+		TaskGroup& operator = (const TaskGroup&) = delete;
+		TaskGroup             (TaskGroup&&)      = delete;
+		TaskGroup& operator = (TaskGroup&&)      = delete;
+
+		template <typename t_Callable>
+		void run(t_Callable&& fn);
+
+		template <typename t_Callable>
+		void then(t_Callable&& continuation);
+
+		void wait();
+
+		[[nodiscard]] bool   is_done()             const noexcept;
+		[[nodiscard]] size_t get_num_outstanding() const noexcept;
+
+	private:
+		friend class Scheduler;
+
+		void on_task_completed();
+
+		Scheduler&          m_Scheduler;
+		std::atomic<size_t> m_Outstanding = 0;
+		std::atomic<size_t> m_Finalizing  = 0; // completing threads that may still touch this group
+
+		std::mutex        m_ContinuationMutex;
+		std::vector<Job*> m_Continuations;
+	};
+}
+
+#include "scheduler.inl"
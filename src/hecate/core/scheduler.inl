@@ -0,0 +1,72 @@
+#pragma once
+
+#include "scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace hecate {
+	template <typename t_Callable>
+	void Scheduler::submit(t_Callable&& fn) {
+		enqueue(new Job{ Task(std::forward<t_Callable>(fn)), nullptr });
+	}
+
+	template <typename t_Callable>
+	void Scheduler::parallel_for(
+		size_t       begin,
+		size_t       end,
+		t_Callable&& fn,
+		size_t       grain_size
+	) {
+		if (begin >= end)
+			return;
+
+		if (grain_size == 0)
+			grain_size = std::max<size_t>(1, (end - begin) / (get_num_workers() * 4));
+
+		TaskGroup group(*this);
+
+		// split off the upper half as a new task until the remainder is small enough,
+		// so that thieves take large chunks while the owner keeps working on the small ones
+		auto split = [&fn, &group, grain_size](auto& self, size_t first, size_t last) -> void {
+			while (last - first > grain_size) {
+				size_t middle = first + (last - first) / 2;
+
+				group.run([&self, middle, last] {
+					self(self, middle, last);
+				});
+
+				last = middle;
+			}
+
+			for (size_t i = first; i < last; ++i)
+				fn(i);
+		};
+
+		split(split, begin, end);
+		group.wait();
+	}
+
+	template <typename t_Callable>
+	void Scheduler::TaskGroup::run(t_Callable&& fn) {
+		m_Outstanding.fetch_add(1, std::memory_order_relaxed);
+		m_Scheduler.enqueue(new Job{ Task(std::forward<t_Callable>(fn)), this });
+	}
+
+	template <typename t_Callable>
+	void Scheduler::TaskGroup::then(t_Callable&& continuation) {
+		auto* job = new Job{ Task(std::forward<t_Callable>(continuation)), nullptr };
+
+		{
+			std::lock_guard guard(m_ContinuationMutex);
+
+			if (m_Outstanding.load(std::memory_order_acquire) > 0) {
+				m_Continuations.push_back(job);
+				return;
+			}
+		}
+
+		// the group is already done, so the continuation can run right away
+		m_Scheduler.enqueue(job);
+	}
+}
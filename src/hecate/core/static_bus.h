@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <mutex>
+
+#include "mediator.h"
+
+namespace hecate {
+	template <typename... t_Messages>
+	struct MessageList {};
+
+	/*
+	*	Compile-time message bus for a fixed set of receiver types
+	*
+	*	Binding a receiver routes all listed message types through a generated dispatch function that
+	*	calls the bound receivers directly (no virtual call, no handler table, so the handler bodies
+	*	can be inlined). Handlers attached at runtime via attach_handler/MessageHandler keep working
+	*	and are called after the statically bound ones; while there are none, broadcasting a routed
+	*	message type doesn't touch the dynamic queue at all.
+	*
+	*		class App;
+	*		using AppBus = StaticBus<MessageList<OnKeyPressed, OnScroll>, App>;
+	*
+	*		AppBus::bind(this);   // f.e. in App::init()
+	*		AppBus::unbind(this); // f.e. in App::shutdown()
+	*
+	*	[NOTE] there is at most one instance per receiver type
+	*	[NOTE] a message type can only be routed by one bus at a time; if bind() throws for that reason,
+	*	       none of the message types are routed by this bus
+	*	[NOTE] unbind from the thread(s) that broadcast, or make sure no broadcasts are in progress
+	*/
+	template <typename t_MessageList, typename... t_Receivers>
+	class StaticBus;
+
+	template <typename... t_Messages, typename... t_Receivers>
+	class StaticBus<MessageList<t_Messages...>, t_Receivers...> {
+	public:
+		template <typename R>
+		requires (std::same_as<R, t_Receivers> || ...)
+		static void bind(R* receiver);
+
+		template <typename R>
+		requires (std::same_as<R, t_Receivers> || ...)
+		static void unbind(R* receiver);
+
+		template <typename T>
+		requires (std::same_as<T, t_Messages> || ...)
+		static void dispatch(const T& message); // only the statically bound receivers
+
+	private:
+		template <typename T>
+		static constexpr bool k_Handled = (std::invocable<t_Receivers&, const T&> || ...);
+
+		template <typename R, typename T>
+		static void call(const T& message);
+
+		template <typename R>
+		inline static std::atomic<R*> s_Receiver = nullptr;
+
+		inline static std::mutex s_Mutex;
+		inline static size_t     s_NumBound = 0; // guarded by s_Mutex
+	};
+}
+
+#include "static_bus.inl"
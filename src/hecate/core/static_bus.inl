@@ -0,0 +1,69 @@
+#pragma once
+
+#include "static_bus.h"
+
+#include <stdexcept>
+
+namespace hecate {
+	template <typename... Ms, typename... Rs>
+	template <typename R>
+	requires (std::same_as<R, Rs> || ...)
+	void StaticBus<MessageList<Ms...>, Rs...>::bind(R* receiver) {
+		static_assert((k_Handled<Ms> && ...), "Every message type in a StaticBus should have at least one receiver");
+
+		std::lock_guard guard(s_Mutex);
+
+		if (s_Receiver<R>.load(std::memory_order_relaxed))
+			throw std::logic_error("A receiver of this type is already bound to the StaticBus");
+
+		// all or nothing; if another bus routes one of the message types, undo the routes installed before it
+		if (s_NumBound == 0) {
+			size_t num_installed = 0;
+
+			try {
+				((core::detail::StaticRoute<Ms>::install(&dispatch<Ms>), ++num_installed), ...);
+			}
+			catch (...) {
+				size_t idx = 0;
+
+				((idx++ < num_installed ? core::detail::StaticRoute<Ms>::uninstall(&dispatch<Ms>) : void()), ...);
+
+				throw;
+			}
+		}
+
+		s_Receiver<R>.store(receiver, std::memory_order_release);
+		++s_NumBound;
+	}
+
+	template <typename... Ms, typename... Rs>
+	template <typename R>
+	requires (std::same_as<R, Rs> || ...)
+	void StaticBus<MessageList<Ms...>, Rs...>::unbind(R* receiver) {
+		std::lock_guard guard(s_Mutex);
+
+		if (s_Receiver<R>.load(std::memory_order_relaxed) != receiver)
+			return;
+
+		s_Receiver<R>.store(nullptr, std::memory_order_release);
+
+		if (--s_NumBound == 0)
+			(core::detail::StaticRoute<Ms>::uninstall(&dispatch<Ms>), ...);
+	}
+
+	template <typename... Ms, typename... Rs>
+	template <typename T>
+	requires (std::same_as<T, Ms> || ...)
+	void StaticBus<MessageList<Ms...>, Rs...>::dispatch(const T& message) {
+		(call<Rs>(message), ...);
+	}
+
+	template <typename... Ms, typename... Rs>
+	template <typename R, typename T>
+	void StaticBus<MessageList<Ms...>, Rs...>::call(const T& message) {
+		if constexpr (std::invocable<R&, const T&>) {
+			if (R* receiver = s_Receiver<R>.load(std::memory_order_acquire))
+				(*receiver)(message);
+		}
+	}
+}
@@ -3,6 +3,8 @@
 #include "../util/algorithm.h"
 #include "logger.h"
 
+#include <stdexcept>
+
 namespace hecate {
 	System::System(const std::string& unique_system_name):
 		m_Name(unique_system_name)
@@ -34,6 +36,26 @@ namespace hecate {
 		return m_Settings;
 	}
 
+	const System::Resources& System::get_resource_access() const {
+		return m_ResourceAccess;
+	}
+
+	bool System::is_main_thread_only() const {
+		return m_MainThreadOnly;
+	}
+
+	bool System::has_dedicated_thread() const {
+		return m_DedicatedThread;
+	}
+
+	Mailbox& System::get_mailbox() {
+		return *m_Mailbox;
+	}
+
+	double System::get_tick_rate() const {
+		return m_TickRate;
+	}
+
 	void System::add_dependency(const std::string& system_name) {
 		if (!util::contains(m_Dependencies, system_name))
 			m_Dependencies.push_back(std::string(system_name));
@@ -41,6 +63,29 @@ namespace hecate {
 			g_Log << "Ignoring duplicate dependency: " << system_name;
 	}
 
+	void System::add_read_access(const std::string& resource_name) {
+		m_ResourceAccess.push_back(ResourceAccess{ resource_name, false });
+	}
+
+	void System::add_write_access(const std::string& resource_name) {
+		m_ResourceAccess.push_back(ResourceAccess{ resource_name, true });
+	}
+
+	void System::require_main_thread() {
+		m_MainThreadOnly = true;
+	}
+
+	void System::run_on_dedicated_thread(double tick_rate) {
+		if (m_MainThreadOnly)
+			throw std::logic_error("A system cannot both require the main thread and run on a dedicated thread");
+
+		if (!m_DedicatedThread)
+			register_setting("tick_rate", &m_TickRate);
+
+		m_DedicatedThread = true;
+		m_TickRate        = tick_rate;
+	}
+
 	void System::operator()(const RequestShutdown& req) {
 		if (req.m_System == this)
 			shutdown();
@@ -4,6 +4,7 @@
 #include <string>
 #include <string_view>
 #include <functional>
+#include <memory>
 #include <iostream>
 #include <type_traits>
 
@@ -18,6 +19,8 @@ namespace hecate {
 	*	Current Subsystem features:
 	*		Engine-managed initialization/shutdown including inter-system dependency management
 	*		Engine-managed updating of running subsystems
+	*		Parallel updates, ordered by dependencies and declared resource access (see FrameGraph)
+	*		Optional dedicated update thread with its own tick rate
 	*		Per-subsystem settings via combined 'hecate.json'
 	*		
 	*	Considerations:
@@ -36,12 +39,18 @@ namespace hecate {
 			std::function<void(const nlohmann::json&)> m_SetFn;
 		};
 
+		struct ResourceAccess {
+			std::string m_Resource;
+			bool        m_Write = false;
+		};
+
 	public:
 		friend class Engine;
 		friend class Settings;
 
 		using Dependencies = std::vector<std::string>; // based on System names (which must be unique)
-		using Settings = std::vector<JsonProperties>;
+		using Settings     = std::vector<JsonProperties>;
+		using Resources    = std::vector<ResourceAccess>; // arbitrary resource names, only used for update ordering
 
 		explicit System(const std::string& unique_system_name);
 		virtual ~System() = default;
@@ -60,6 +69,13 @@ namespace hecate {
 
 		const Dependencies& get_dependencies()     const;
 		const Settings&     get_settings()         const;
+		const Resources&    get_resource_access()  const;
+
+		bool   is_main_thread_only()  const;
+		bool   has_dedicated_thread() const;
+		double get_tick_rate()        const; // only relevant for systems with a dedicated thread
+
+		Mailbox& get_mailbox(); // drained right before update(), on the thread that runs it
 		
 		void operator()(const RequestShutdown& req);
 
@@ -68,6 +84,17 @@ namespace hecate {
 	protected:
 		void add_dependency(const std::string& system_name);
 
+		// systems touching the same resource are ordered within a frame (readers may run at the same time)
+		void add_read_access (const std::string& resource_name);
+		void add_write_access(const std::string& resource_name);
+
+		// update() will only be called from the main thread (f.e. for OS message pumps)
+		void require_main_thread();
+
+		// update() will be called from a separate thread at the given rate (in Hz, 0 for back-to-back),
+		// independent of the frame rate; the rate can be overridden via the 'tick_rate' setting
+		void run_on_dedicated_thread(double tick_rate);
+
 		template <typename T>
 		void register_setting(
 			const std::string& json_key, 
@@ -80,6 +107,12 @@ namespace hecate {
 		std::string  m_Name;
 		Dependencies m_Dependencies;
 		Settings     m_Settings;		
+		Resources    m_ResourceAccess;
+		bool         m_MainThreadOnly  = false;
+		bool         m_DedicatedThread = false;
+		double       m_TickRate        = 0;
+
+		std::unique_ptr<Mailbox> m_Mailbox = std::make_unique<Mailbox>(); // heap allocated to keep System movable
 	};
 
 	template <typename T>
@@ -0,0 +1,271 @@
+#include "system_startup.h"
+#include "system.h"
+#include "logger.h"
+#include "../util/algorithm.h"
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace hecate {
+	void SystemStartup::run(
+		const std::vector<System*>& systems,
+		Scheduler&                  scheduler
+	) {
+		build(systems);
+
+		const size_t num_systems = m_Systems.size();
+
+		auto pending = std::make_unique<std::atomic<size_t>[]>(num_systems);
+
+		for (size_t i = 0; i < num_systems; ++i)
+			pending[i].store(m_Predecessors[i].size(), std::memory_order_relaxed);
+
+		std::vector<size_t> main_thread_ready;
+		std::mutex          mutex;
+		std::exception_ptr  failure;
+		std::atomic_bool    failed        = false;
+		std::atomic<size_t> num_completed = 0;
+
+		Scheduler::TaskGroup group(scheduler);
+
+		std::function<void(size_t)> schedule;
+		std::function<void(size_t)> run;
+
+		schedule = [&](size_t idx) {
+			if (m_Systems[idx]->is_main_thread_only()) {
+				std::lock_guard guard(mutex);
+				main_thread_ready.push_back(idx);
+			}
+			else
+				group.run([&run, idx] { run(idx); });
+		};
+
+		run = [&](size_t idx) {
+			auto* current_system = m_Systems[idx];
+
+			// after a failure the remaining systems are skipped, but still 'completed' so everything winds down
+			if (!failed) {
+				auto start = Clock::now();
+
+				try {
+					if (!current_system->init())
+						throw std::runtime_error("Failed to start subsystem " + current_system->get_name());
+
+					m_Durations[idx] = Clock::now() - start;
+
+					std::lock_guard guard(mutex);
+					m_CompletionOrder.push_back(idx);
+				}
+				catch (...) {
+					std::lock_guard guard(mutex);
+
+					if (!failure)
+						failure = std::current_exception();
+
+					failed = true;
+				}
+			}
+
+			for (auto succ : m_Successors[idx])
+				if (pending[succ].fetch_sub(1, std::memory_order_acq_rel) == 1)
+					schedule(succ);
+
+			num_completed.fetch_add(1, std::memory_order_release);
+		};
+
+		const auto startup_begin = Clock::now();
+
+		for (size_t i = 0; i < num_systems; ++i)
+			if (m_Predecessors[i].empty())
+				schedule(i);
+
+		// main-thread-only systems (f.e. Platform) are initialized here, otherwise help out
+		while (num_completed.load(std::memory_order_acquire) < num_systems) {
+			size_t idx = num_systems;
+
+			{
+				std::lock_guard guard(mutex);
+
+				if (!main_thread_ready.empty()) {
+					idx = main_thread_ready.back();
+					main_thread_ready.pop_back();
+				}
+			}
+
+			if (idx < num_systems)
+				run(idx);
+			else if (!scheduler.try_execute_one())
+				std::this_thread::yield();
+		}
+
+		group.wait();
+
+		m_WallTime = Clock::now() - startup_begin;
+
+		if (failure) {
+			// [NOTE] the completion order is a topological order, so in reverse nothing is shut down
+			//        before the systems that depend on it
+			for (auto it = std::rbegin(m_CompletionOrder); it != std::rend(m_CompletionOrder); ++it) {
+				auto* current_system = m_Systems[*it];
+
+				try {
+					current_system->shutdown();
+				}
+				catch (const std::exception& ex) {
+					g_LogError << "Exception while shutting down " << current_system->get_name() << ": " << ex.what();
+				}
+				catch (...) {
+					g_LogError << "Unknown exception while shutting down " << current_system->get_name();
+				}
+			}
+
+			m_CompletionOrder.clear();
+
+			std::rethrow_exception(failure);
+		}
+
+		for (auto idx : m_CompletionOrder)
+			m_InitOrder.push_back(m_Systems[idx]);
+	}
+
+	const std::vector<System*>& SystemStartup::get_init_order() const noexcept {
+		return m_InitOrder;
+	}
+
+	void SystemStartup::build(const std::vector<System*>& systems) {
+		const size_t num_systems = systems.size();
+
+		m_Systems = systems;
+
+		m_Predecessors.assign(num_systems, {});
+		m_Successors  .assign(num_systems, {});
+		m_Durations   .assign(num_systems, {});
+
+		m_CompletionOrder.clear();
+		m_InitOrder      .clear();
+
+		m_WallTime = {};
+
+		{
+			bool missing = false;
+
+			for (size_t i = 0; i < num_systems; ++i)
+				for (const auto& dep : m_Systems[i]->get_dependencies()) {
+					auto jt = util::find_if(
+						m_Systems,
+						[&dep](const System* s) {
+							return s->get_name() == dep;
+						}
+					);
+
+					if (jt == std::end(m_Systems)) {
+						g_Log << "\tFailed to initialize: " << m_Systems[i]->get_name() << ", missing dependency '" << dep << "'";
+						missing = true;
+					}
+					else {
+						size_t j = static_cast<size_t>(std::distance(std::cbegin(m_Systems), jt));
+
+						m_Predecessors[i].push_back(j);
+						m_Successors  [j].push_back(i);
+					}
+				}
+
+			if (missing)
+				throw std::runtime_error("Missing subsystem dependencies");
+		}
+
+		// verify that the dependencies form a DAG before starting anything
+		std::vector<size_t> in_degree(num_systems);
+		std::vector<size_t> ready;
+		std::vector<bool>   visited(num_systems, false);
+
+		for (size_t i = 0; i < num_systems; ++i)
+			if ((in_degree[i] = m_Predecessors[i].size()) == 0)
+				ready.push_back(i);
+
+		while (!ready.empty()) {
+			size_t idx = ready.back();
+			ready.pop_back();
+
+			visited[idx] = true;
+
+			for (auto succ : m_Successors[idx])
+				if (--in_degree[succ] == 0)
+					ready.push_back(succ);
+		}
+
+		if (util::contains(visited, false)) {
+			g_Log << "Stalled during system initialization";
+
+			for (size_t i = 0; i < num_systems; ++i)
+				if (!visited[i]) {
+					// try to be specific about what's blocking
+					std::stringstream sstr;
+
+					sstr << "\tFailed to initialize: " << m_Systems[i]->get_name() << ", waiting for ";
+
+					for (auto pred : m_Predecessors[i])
+						if (!visited[pred])
+							sstr << "'" << m_Systems[pred]->get_name() << "' ";
+
+					g_Log << sstr.str();
+				}
+
+			throw std::runtime_error("Stalled during system initialization");
+		}
+	}
+
+	std::ostream& operator << (std::ostream& os, const SystemStartup& startup) {
+		using Milliseconds = std::chrono::duration<double, std::milli>;
+		using Clock        = SystemStartup::Clock;
+
+		const size_t num_systems = startup.m_Systems.size();
+
+		std::vector<Clock::duration> path_length(num_systems);
+		std::vector<size_t>          previous   (num_systems, num_systems);
+		Clock::duration              total = {};
+		size_t                       last  = num_systems;
+
+		for (auto idx : startup.m_CompletionOrder) {
+			for (auto pred : startup.m_Predecessors[idx])
+				if (path_length[pred] > path_length[idx]) {
+					path_length[idx] = path_length[pred];
+					previous   [idx] = pred;
+				}
+
+			path_length[idx] += startup.m_Durations[idx];
+			total            += startup.m_Durations[idx];
+
+			if ((last == num_systems) || (path_length[idx] > path_length[last]))
+				last = idx;
+		}
+
+		os
+			<< "Startup report: " << Milliseconds(startup.m_WallTime).count() << " ms wall time, "
+			<< Milliseconds(total).count() << " ms total init time\n";
+
+		for (auto idx : startup.m_CompletionOrder)
+			os << "\t" << startup.m_Systems[idx]->get_name() << ": " << Milliseconds(startup.m_Durations[idx]).count() << " ms\n";
+
+		if (last < num_systems) {
+			std::vector<size_t> path;
+
+			for (size_t idx = last; idx < num_systems; idx = previous[idx])
+				path.insert(path.begin(), idx);
+
+			os << "\tCritical path (" << Milliseconds(path_length[last]).count() << " ms):";
+
+			for (size_t i = 0; i < path.size(); ++i)
+				os << (i == 0 ? " " : " -> ") << startup.m_Systems[path[i]]->get_name();
+		}
+
+		return os;
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <iosfwd>
+#include <vector>
+
+#include "scheduler.h"
+
+namespace hecate {
+	class System;
+
+	/*
+	*	Initializes a set of systems in dependency order
+	*
+	*	Systems that don't depend on each other are initialized at the same time on the scheduler
+	*	(Kahn's algorithm); systems that require the main thread are initialized by the calling
+	*	thread, which otherwise helps out. When a system fails to initialize the ones that haven't
+	*	started yet are skipped, and the ones that did initialize are shut down again in reverse
+	*	order before the failure is rethrown.
+	*/
+	class SystemStartup {
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		void run(
+			const std::vector<System*>& systems,
+			Scheduler&                  scheduler
+		); // throws if a dependency is missing, if there is a cycle or if a system fails to initialize
+
+		[[nodiscard]] const std::vector<System*>& get_init_order() const noexcept; // a topological order
+
+		// startup report, including the critical path (longest chain of dependent init times)
+		friend std::ostream& operator << (std::ostream& os, const SystemStartup& startup);
+
+	private:
+		void build(const std::vector<System*>& systems); // throws if a dependency is missing or if there is a cycle
+
+		std::vector<System*>             m_Systems;
+		std::vector<std::vector<size_t>> m_Predecessors;
+		std::vector<std::vector<size_t>> m_Successors;
+		std::vector<Clock::duration>     m_Durations;
+		std::vector<size_t>              m_CompletionOrder;
+		std::vector<System*>             m_InitOrder;
+		Clock::duration                  m_WallTime = {};
+	};
+}
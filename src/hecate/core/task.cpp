@@ -0,0 +1,143 @@
+#include "task.h"
+#include "scheduler.h"
+
+namespace hecate {
+	namespace core::detail {
+		void TaskPromiseBase::unhandled_exception() noexcept {
+			m_Exception = std::current_exception();
+		}
+
+		void TaskPromiseBase::rethrow_if_exception() {
+			if (m_Exception)
+				std::rethrow_exception(m_Exception);
+		}
+
+		std::coroutine_handle<> WhenAllItem::promise_type::FinalAwaiter::await_suspend(
+			std::coroutine_handle<promise_type> handle
+		) noexcept {
+			auto* state = handle.promise().m_State;
+
+			// the parent owns this coroutine; it can only be resumed (and destroy us) when we're suspended here
+			if (state->m_Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				return state->m_Parent;
+
+			return std::noop_coroutine();
+		}
+
+		WhenAllItem WhenAllItem::promise_type::get_return_object() noexcept {
+			return WhenAllItem(Handle::from_promise(*this));
+		}
+
+		void WhenAllItem::promise_type::unhandled_exception() noexcept {
+			std::lock_guard guard(m_State->m_Mutex);
+
+			if (!m_State->m_Exception)
+				m_State->m_Exception = std::current_exception();
+		}
+
+		WhenAllItem::WhenAllItem(Handle h) noexcept:
+			m_Handle(h)
+		{
+		}
+
+		WhenAllItem::~WhenAllItem() {
+			if (m_Handle)
+				m_Handle.destroy();
+		}
+
+		WhenAllItem::WhenAllItem(WhenAllItem&& other) noexcept:
+			m_Handle(std::exchange(other.m_Handle, nullptr))
+		{
+		}
+
+		WhenAllItem& WhenAllItem::operator = (WhenAllItem&& other) noexcept {
+			if (this != &other) {
+				if (m_Handle)
+					m_Handle.destroy();
+
+				m_Handle = std::exchange(other.m_Handle, nullptr);
+			}
+
+			return *this;
+		}
+
+		void WhenAllItem::start(WhenAllState* state) {
+			m_Handle.promise().m_State = state;
+			m_Handle.resume();
+		}
+	}
+
+	void ResumeQueue::push(std::coroutine_handle<> handle) {
+		std::lock_guard guard(m_Mutex);
+		m_Handles.push_back(handle);
+	}
+
+	size_t ResumeQueue::resume_all() {
+		std::vector<std::coroutine_handle<>> handles;
+
+		{
+			std::lock_guard guard(m_Mutex);
+			std::swap(handles, m_Handles);
+		}
+
+		for (auto h : handles)
+			h.resume();
+
+		return handles.size();
+	}
+
+	void ResumeQueue::clear() {
+		std::lock_guard guard(m_Mutex);
+		m_Handles.clear();
+	}
+
+	size_t ResumeQueue::size() const {
+		std::lock_guard guard(m_Mutex);
+		return m_Handles.size();
+	}
+
+	WhenAll::WhenAll(std::vector<core::detail::WhenAllItem> items):
+		m_Items(std::move(items))
+	{
+	}
+
+	bool WhenAll::await_ready() const noexcept {
+		return m_Items.empty();
+	}
+
+	bool WhenAll::await_suspend(std::coroutine_handle<> waiter) {
+		m_State.m_Parent = waiter;
+
+		// the extra count keeps the waiter from being resumed before everything has been started
+		m_State.m_Remaining.store(m_Items.size() + 1, std::memory_order_relaxed);
+
+		for (auto& item : m_Items)
+			item.start(&m_State);
+
+		// if everything already completed, don't suspend at all
+		return m_State.m_Remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+	}
+
+	void WhenAll::await_resume() {
+		if (m_State.m_Exception)
+			std::rethrow_exception(m_State.m_Exception);
+	}
+
+	void ResumeOnScheduler::await_suspend(std::coroutine_handle<> handle) {
+		m_Scheduler->submit([handle] {
+			handle.resume();
+		});
+	}
+
+	void ResumeOnQueue::await_suspend(std::coroutine_handle<> handle) {
+		m_Queue->push(handle);
+	}
+
+	ResumeOnScheduler resume_on(Scheduler& scheduler) {
+		return ResumeOnScheduler{ &scheduler };
+	}
+
+	ResumeOnQueue resume_on(ResumeQueue& queue) {
+		return ResumeOnQueue{ &queue };
+	}
+}
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+/*
+*	Coroutine tasks
+*
+*	Task<T> is a lazily started coroutine; it runs when it is co_await'ed (the awaiting
+*	coroutine resumes once it completes) or when it is started explicitly, typically through
+*	Engine::spawn. Where a task continues after a suspension depends on what it awaited:
+*
+*		co_await resume_on(scheduler)   continue on a worker thread
+*		co_await resume_on(queue)       continue when the queue is resumed (Engine::next_frame uses this)
+*		co_await completion             continue on whichever thread completes it (f.e. an I/O callback)
+*		co_await other_task             continue when the other task is done
+*		co_await when_all(tasks)        run tasks concurrently, continue when all of them are done
+*
+*	Exceptions propagate to whoever awaits the task (or calls get() on it).
+*/
+namespace hecate {
+	class Scheduler;
+
+	template <typename T = void>
+	class Task;
+
+	namespace core::detail {
+		struct TaskPromiseBase {
+			struct FinalAwaiter {
+				bool await_ready() const noexcept { return false; }
+
+				template <typename t_Promise>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<t_Promise> handle) noexcept;
+
+				void await_resume() const noexcept {}
+			};
+
+			std::suspend_always initial_suspend() const noexcept { return {}; }
+			FinalAwaiter        final_suspend()   const noexcept { return {}; }
+
+			void unhandled_exception() noexcept;
+			void rethrow_if_exception();
+
+			std::coroutine_handle<> m_Continuation; // resumed when this task completes
+			std::exception_ptr      m_Exception;
+			std::atomic_bool        m_Done = false;
+		};
+
+		template <typename T>
+		struct TaskPromise:
+			TaskPromiseBase
+		{
+			Task<T> get_return_object() noexcept;
+
+			template <typename U>
+			requires std::convertible_to<U, T>
+			void return_value(U&& value);
+
+			T get_result();
+
+			std::optional<T> m_Value;
+		};
+
+		template <>
+		struct TaskPromise<void>:
+			TaskPromiseBase
+		{
+			Task<void> get_return_object() noexcept;
+
+			void return_void() noexcept {}
+			void get_result();
+		};
+
+		// used by when_all; the last one to finish resumes the waiting coroutine
+		struct WhenAllState {
+			std::atomic<size_t>     m_Remaining = 0;
+			std::coroutine_handle<> m_Parent;
+			std::mutex              m_Mutex;
+			std::exception_ptr      m_Exception; // the first one
+		};
+
+		class WhenAllItem {
+		public:
+			struct promise_type {
+				struct FinalAwaiter {
+					bool                    await_ready() const noexcept { return false; }
+					std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+					void                    await_resume() const noexcept {}
+				};
+
+				WhenAllItem         get_return_object() noexcept;
+				std::suspend_always initial_suspend() const noexcept { return {}; }
+				FinalAwaiter        final_suspend()   const noexcept { return {}; }
+				void                return_void() noexcept {}
+				void                unhandled_exception() noexcept;
+
+				WhenAllState* m_State = nullptr;
+			};
+
+			using Handle = std::coroutine_handle<promise_type>;
+
+			explicit WhenAllItem(Handle h) noexcept;
+			~WhenAllItem();
+
+			WhenAllItem             (const WhenAllItem&) = delete;
+			WhenAllItem& operator = (const WhenAllItem&) = delete;
+			WhenAllItem             (WhenAllItem&& other) noexcept;
+			WhenAllItem& operator = (WhenAllItem&& other) noexcept;
+
+			void start(WhenAllState* state);
+
+		private:
+			Handle m_Handle;
+		};
+
+		template <typename T>
+		WhenAllItem make_when_all_item(Task<T>& task);
+	}
+
+	template <typename T>
+	class [[nodiscard]] Task {
+	public:
+		using promise_type = core::detail::TaskPromise<T>;
+		using Handle       = std::coroutine_handle<promise_type>;
+
+		Task() = default;
+		explicit Task(Handle h) noexcept;
+		~Task();
+
+		Task             (const Task&) = delete;
+		Task& operator = (const Task&) = delete;
+		Task             (Task&& other) noexcept;
+		Task& operator = (Task&& other) noexcept;
+
+		[[nodiscard]] bool is_valid() const noexcept;
+		[[nodiscard]] bool is_ready() const noexcept; // true once the coroutine has completed
+
+		void start(); // run until the first suspension; for tasks that are not awaited by another coroutine
+		T    get();   // the result of a completed task; rethrows if the coroutine threw
+
+		auto operator co_await() noexcept; // starts the task, resumes the awaiting coroutine when done
+
+	private:
+		Handle m_Handle;
+	};
+
+	// thread-safe set of suspended coroutines, resumed on demand
+	class ResumeQueue {
+	public:
+		void   push(std::coroutine_handle<> handle);
+		size_t resume_all(); // resumes on the calling thread; coroutines queued while doing so wait for the next call
+		void   clear();      // drops everything without resuming
+
+		[[nodiscard]] size_t size() const;
+
+	private:
+		mutable std::mutex                   m_Mutex;
+		std::vector<std::coroutine_handle<>> m_Handles;
+	};
+
+	// one-shot result that can be provided from any thread (f.e. an I/O callback); supports a single waiter
+	template <typename T = void>
+	class Completion {
+	public:
+		Completion() = default;
+
+		Completion             (const Completion&) = delete;
+		Completion& operator = (const Completion&) = delete;
+		Completion             (Completion&&)      = delete;
+		Completion& operator = (Completion&&)      = delete;
+
+		template <typename U>
+		requires (!std::is_void_v<T> && std::convertible_to<U, T>)
+		void set_value(U&& value);
+
+		void set_value() requires std::is_void_v<T>;
+		void set_exception(std::exception_ptr ex);
+
+		[[nodiscard]] bool is_ready() const;
+
+		bool await_ready() const;
+		bool await_suspend(std::coroutine_handle<> waiter);
+		T    await_resume();
+
+	private:
+		using Storage = std::conditional_t<std::is_void_v<T>, bool, T>;
+
+		void complete();
+
+		mutable std::mutex      m_Mutex;
+		bool                    m_Ready = false;
+		std::optional<Storage>  m_Value;
+		std::exception_ptr      m_Exception;
+		std::coroutine_handle<> m_Waiter;
+	};
+
+	// starts all tasks at the same time, resumes once all of them are done; results are available through Task::get
+	// (if any of them threw, the first exception is rethrown)
+	class [[nodiscard]] WhenAll {
+	public:
+		explicit WhenAll(std::vector<core::detail::WhenAllItem> items);
+
+		WhenAll             (const WhenAll&) = delete;
+		WhenAll& operator = (const WhenAll&) = delete;
+		WhenAll             (WhenAll&&)      = delete;
+		WhenAll& operator = (WhenAll&&)      = delete;
+
+		bool await_ready() const noexcept;
+		bool await_suspend(std::coroutine_handle<> waiter);
+		void await_resume();
+
+	private:
+		std::vector<core::detail::WhenAllItem> m_Items;
+		core::detail::WhenAllState             m_State;
+	};
+
+	template <typename T>
+	WhenAll when_all(std::vector<Task<T>>& tasks);
+
+	template <typename... Ts>
+	WhenAll when_all(Task<Ts>&... tasks);
+
+	// awaitables that move the awaiting coroutine elsewhere
+	struct [[nodiscard]] ResumeOnScheduler {
+		Scheduler* m_Scheduler = nullptr;
+
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle);
+		void await_resume() const noexcept {}
+	};
+
+	struct [[nodiscard]] ResumeOnQueue {
+		ResumeQueue* m_Queue = nullptr;
+
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle);
+		void await_resume() const noexcept {}
+	};
+
+	ResumeOnScheduler resume_on(Scheduler&   scheduler);
+	ResumeOnQueue     resume_on(ResumeQueue& queue);
+}
+
+#include "task.inl"
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "task.h"
+
+#include <cassert>
+#include <utility>
+
+namespace hecate {
+	namespace core::detail {
+		template <typename t_Promise>
+		std::coroutine_handle<> TaskPromiseBase::FinalAwaiter::await_suspend(std::coroutine_handle<t_Promise> handle) noexcept {
+			auto& promise      = handle.promise();
+			auto  continuation = promise.m_Continuation;
+
+			// [NOTE] once m_Done is set the owner may destroy the coroutine, so the frame
+			//        must not be touched afterwards
+			promise.m_Done.store(true, std::memory_order_release);
+
+			if (continuation)
+				return continuation;
+
+			return std::noop_coroutine();
+		}
+
+		template <typename T>
+		Task<T> TaskPromise<T>::get_return_object() noexcept {
+			return Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+		}
+
+		template <typename T>
+		template <typename U>
+		requires std::convertible_to<U, T>
+		void TaskPromise<T>::return_value(U&& value) {
+			m_Value.emplace(std::forward<U>(value));
+		}
+
+		template <typename T>
+		T TaskPromise<T>::get_result() {
+			rethrow_if_exception();
+
+			return std::move(*m_Value);
+		}
+
+		inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+			return Task<void>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+		}
+
+		inline void TaskPromise<void>::get_result() {
+			rethrow_if_exception();
+		}
+
+		template <typename T>
+		WhenAllItem make_when_all_item(Task<T>& task) {
+			co_await task;
+		}
+	}
+
+	template <typename T>
+	Task<T>::Task(Handle h) noexcept:
+		m_Handle(h)
+	{
+	}
+
+	template <typename T>
+	Task<T>::~Task() {
+		if (m_Handle)
+			m_Handle.destroy();
+	}
+
+	template <typename T>
+	Task<T>::Task(Task&& other) noexcept:
+		m_Handle(std::exchange(other.m_Handle, nullptr))
+	{
+	}
+
+	template <typename T>
+	Task<T>& Task<T>::operator = (Task&& other) noexcept {
+		if (this != &other) {
+			if (m_Handle)
+				m_Handle.destroy();
+
+			m_Handle = std::exchange(other.m_Handle, nullptr);
+		}
+
+		return *this;
+	}
+
+	template <typename T>
+	bool Task<T>::is_valid() const noexcept {
+		return static_cast<bool>(m_Handle);
+	}
+
+	template <typename T>
+	bool Task<T>::is_ready() const noexcept {
+		return m_Handle && m_Handle.promise().m_Done.load(std::memory_order_acquire);
+	}
+
+	template <typename T>
+	void Task<T>::start() {
+		assert(m_Handle);
+		m_Handle.resume();
+	}
+
+	template <typename T>
+	T Task<T>::get() {
+		assert(is_ready());
+		return m_Handle.promise().get_result();
+	}
+
+	template <typename T>
+	auto Task<T>::operator co_await() noexcept {
+		struct Awaiter {
+			Handle m_Handle;
+
+			bool await_ready() const noexcept {
+				return !m_Handle || m_Handle.promise().m_Done.load(std::memory_order_acquire);
+			}
+
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+				// tasks are lazy, so nothing can complete before the continuation is set
+				m_Handle.promise().m_Continuation = awaiting;
+				return m_Handle;
+			}
+
+			T await_resume() {
+				return m_Handle.promise().get_result();
+			}
+		};
+
+		return Awaiter{ m_Handle };
+	}
+
+	template <typename T>
+	template <typename U>
+	requires (!std::is_void_v<T> && std::convertible_to<U, T>)
+	void Completion<T>::set_value(U&& value) {
+		{
+			std::lock_guard guard(m_Mutex);
+
+			assert(!m_Ready);
+			m_Value.emplace(std::forward<U>(value));
+		}
+
+		complete();
+	}
+
+	template <typename T>
+	void Completion<T>::set_value() requires std::is_void_v<T> {
+		{
+			std::lock_guard guard(m_Mutex);
+
+			assert(!m_Ready);
+			m_Value.emplace(true);
+		}
+
+		complete();
+	}
+
+	template <typename T>
+	void Completion<T>::set_exception(std::exception_ptr ex) {
+		{
+			std::lock_guard guard(m_Mutex);
+
+			assert(!m_Ready);
+			m_Exception = std::move(ex);
+		}
+
+		complete();
+	}
+
+	template <typename T>
+	bool Completion<T>::is_ready() const {
+		std::lock_guard guard(m_Mutex);
+		return m_Ready;
+	}
+
+	template <typename T>
+	bool Completion<T>::await_ready() const {
+		return is_ready();
+	}
+
+	template <typename T>
+	bool Completion<T>::await_suspend(std::coroutine_handle<> waiter) {
+		std::lock_guard guard(m_Mutex);
+
+		if (m_Ready)
+			return false; // completed in the meantime, continue right away
+
+		assert(!m_Waiter); // only a single waiter is supported
+		m_Waiter = waiter;
+
+		return true;
+	}
+
+	template <typename T>
+	T Completion<T>::await_resume() {
+		std::lock_guard guard(m_Mutex);
+
+		if (m_Exception)
+			std::rethrow_exception(m_Exception);
+
+		if constexpr (!std::is_void_v<T>)
+			return std::move(*m_Value);
+	}
+
+	template <typename T>
+	void Completion<T>::complete() {
+		std::coroutine_handle<> waiter;
+
+		{
+			std::lock_guard guard(m_Mutex);
+
+			m_Ready = true;
+			waiter  = std::exchange(m_Waiter, nullptr);
+		}
+
+		if (waiter)
+			waiter.resume(); // on the completing thread
+	}
+
+	template <typename T>
+	WhenAll when_all(std::vector<Task<T>>& tasks) {
+		std::vector<core::detail::WhenAllItem> items;
+		items.reserve(tasks.size());
+
+		for (auto& task : tasks)
+			items.push_back(core::detail::make_when_all_item(task));
+
+		return WhenAll(std::move(items));
+	}
+
+	template <typename... Ts>
+	WhenAll when_all(Task<Ts>&... tasks) {
+		std::vector<core::detail::WhenAllItem> items;
+		items.reserve(sizeof...(Ts));
+
+		(items.push_back(core::detail::make_when_all_item(tasks)), ...);
+
+		return WhenAll(std::move(items));
+	}
+}
@@ -8,7 +8,7 @@
 #if HECATE_PLATFORM == HECATE_PLATFORM_WINDOWS
 	#define VK_USE_PLATFORM_WIN32_KHR
 #else
-	#error "Please specify which vulkan platform to use...""
+	// the linux platform is headless (no window system), so no WSI platform is needed
 #endif
 
 #if HECATE_COMPILER == HECATE_COMPILER_MSVC
@@ -25,8 +25,6 @@
 
 #if HECATE_PLATFORM == HECATE_PLATFORM_WINDOWS
 	#include <vulkan/vulkan_win32.h>
-#else
-	#error "Please included the appropriate vulkan platform header..."
 #endif
 
 #if HECATE_COMPILER == HECATE_COMPILER_MSVC
@@ -1,24 +1,110 @@
 #include "input.h"
+#include "keyboard.h"
+#include "mouse.h"
 #include "../util/algorithm.h"
+#include "../core/engine.h"
+#include "../core/static_bus.h"
 #include "../core/logger.h"
 
+namespace {
+    using hecate::input::Keyboard;
+    using hecate::input::Mouse;
+
+    using InputEvents = hecate::MessageList<
+        Keyboard::OnKeyPressed,
+        Keyboard::OnKeyReleased,
+        Mouse::OnMoved,
+        Mouse::OnButtonPressed,
+        Mouse::OnButtonReleased,
+        Mouse::OnDoubleClick,
+        Mouse::OnScroll
+    >;
+
+    template <typename... Ts>
+    void record_events(hecate::MessageRecorder& recorder, hecate::MessageList<Ts...>) {
+        (recorder.record<Ts>(), ...);
+    }
+
+    template <typename... Ts>
+    void replay_events(hecate::MessageReplayer& replayer, hecate::MessageList<Ts...>) {
+        (replayer.replay<Ts>(), ...);
+    }
+}
+
 namespace hecate {
     Input::Input(): 
         System("Input") 
     {
+        register_setting("record_file",  &m_RecordFile);
+        register_setting("replay_file",  &m_ReplayFile);
+        register_setting("replay_speed", &m_ReplaySpeed);
+        register_setting("replay_exit",  &m_ReplayExit);
     }
 
     bool Input::init() {
         System::init();
 
+        if (!m_RecordFile.empty()) {
+            record_events(m_Recorder, InputEvents{});
+
+            if (m_Recorder.start(m_RecordFile))
+                g_Log << "Recording input to " << m_RecordFile;
+            else
+                g_LogWarning << "Failed to open " << m_RecordFile << " for recording input";
+        }
+
+        if (!m_ReplayFile.empty()) {
+            replay_events(m_Replayer, InputEvents{});
+
+            if (m_Replayer.open(m_ReplayFile)) {
+                g_Log << "Replaying " << m_Replayer.get_num_messages() << " input events from " << m_ReplayFile;
+
+                // devices deliver their events on the main thread, so replayed events do the same
+                require_main_thread();
+
+                m_Replaying = true;
+            }
+            else
+                g_LogWarning << "Failed to open " << m_ReplayFile << " for replaying input";
+        }
+
         return true;
     }
 
     void Input::update() {
+        if (!m_Replaying)
+            return;
+
+        // the clock starts at the first update, so that engine startup doesn't count towards the replay
+        auto now = std::chrono::steady_clock::now();
+
+        if (m_ReplayStart == std::chrono::steady_clock::time_point())
+            m_ReplayStart = now;
+
+        if (m_ReplaySpeed > 0) {
+            auto elapsed = std::chrono::duration<double, std::nano>(now - m_ReplayStart) * m_ReplaySpeed;
+            m_Replayer.advance(std::chrono::duration_cast<MessageReplayer::Duration>(elapsed));
+        }
+        else
+            m_Replayer.replay_all();
+
+        if (m_Replayer.is_finished()) {
+            g_Log << "Input replay finished";
+
+            m_Replaying = false;
+
+            if (m_ReplayExit)
+                m_Engine->stop();
+        }
     }
 
     void Input::shutdown() {
         System::shutdown();
+
+        if (m_Recorder.is_recording()) {
+            m_Recorder.stop();
+            g_Log << "Recorded " << m_Recorder.get_num_messages() << " input events";
+        }
     }
 
     void Input::register_device(Keyboard* kbd) {
@@ -68,4 +154,12 @@ namespace hecate {
     const Input::Mouse& Input::get_mouse() const {
         return *m_Mice.front();
     }
+
+    const MessageRecorder& Input::get_recorder() const {
+        return m_Recorder;
+    }
+
+    const MessageReplayer& Input::get_replayer() const {
+        return m_Replayer;
+    }
 }
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "../core/system.h"
+#include "../core/message_recording.h"
 
+#include <chrono>
+#include <string>
 #include <vector>
 
 namespace hecate::input {
@@ -34,9 +37,24 @@ namespace hecate {
         const std::vector<Keyboard*>& get_keyboards() const;
         const std::vector<Mouse*>&    get_mice()      const;
 
+        // all keyboard and mouse events can be recorded to a file and replayed later (f.e. in a headless
+        // engine), configured via the 'Input' section in the settings
+        const MessageRecorder& get_recorder() const;
+        const MessageReplayer& get_replayer() const;
+
     private:
         // NOTE these are non-owning; the owner is the Platform object
         std::vector<Keyboard*> m_Keyboards;
         std::vector<Mouse*>    m_Mice;
+
+        std::string m_RecordFile;           // if set, input events are recorded here
+        std::string m_ReplayFile;           // if set, input events are replayed from here
+        double      m_ReplaySpeed = 1.0;    // 1 for the original timing, 0 to replay everything in the first frame
+        bool        m_ReplayExit  = false;  // stop the engine when the replay has finished
+
+        MessageRecorder                       m_Recorder;
+        MessageReplayer                       m_Replayer;
+        std::chrono::steady_clock::time_point m_ReplayStart;
+        bool                                  m_Replaying = false;
     };
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "input.h"
 
 #include "../core/mediator.h"
+#include "../core/message_recording.h"
 
 #include <ostream>
 #include <type_traits>
@@ -155,4 +156,28 @@ namespace hecate::input {
 
         return os;
     }
-}
\ No newline at end of file
+}
+
+namespace hecate {
+    void RecordedMessage<input::Keyboard::OnKeyPressed>::save(
+        RecordWriter&                        writer,
+        const input::Keyboard::OnKeyPressed& message
+    ) {
+        writer.write(static_cast<uint16_t>(message.key));
+    }
+
+    input::Keyboard::OnKeyPressed RecordedMessage<input::Keyboard::OnKeyPressed>::load(RecordReader& reader) {
+        return { nullptr, static_cast<input::Keyboard::e_Key>(reader.read<uint16_t>()), nullptr };
+    }
+
+    void RecordedMessage<input::Keyboard::OnKeyReleased>::save(
+        RecordWriter&                         writer,
+        const input::Keyboard::OnKeyReleased& message
+    ) {
+        writer.write(static_cast<uint16_t>(message.key));
+    }
+
+    input::Keyboard::OnKeyReleased RecordedMessage<input::Keyboard::OnKeyReleased>::load(RecordReader& reader) {
+        return { nullptr, static_cast<input::Keyboard::e_Key>(reader.read<uint16_t>()), nullptr };
+    }
+}
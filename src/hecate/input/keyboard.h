@@ -2,9 +2,15 @@
 
 #include <iosfwd>
 #include <array>
+#include <utility>
 
 namespace hecate {
     class Input;
+    class RecordWriter;
+    class RecordReader;
+
+    template <typename T>
+    struct RecordedMessage;
 
     namespace platform {
         class Window;
@@ -153,4 +159,22 @@ namespace hecate {
         std::ostream& operator << (std::ostream& os, const Keyboard::OnKeyPressed&  kp);
         std::ostream& operator << (std::ostream& os, const Keyboard::OnKeyReleased& kr);
     }
+
+    // keyboard events can be recorded and replayed (see core/message_recording.h);
+    // the keyboard and window pointers are not recorded, replayed events carry nullptr
+    template <>
+    struct RecordedMessage<input::Keyboard::OnKeyPressed> {
+        static constexpr const char* k_Name = "input::Keyboard::OnKeyPressed";
+
+        static void                          save(RecordWriter& writer, const input::Keyboard::OnKeyPressed& message);
+        static input::Keyboard::OnKeyPressed load(RecordReader& reader);
+    };
+
+    template <>
+    struct RecordedMessage<input::Keyboard::OnKeyReleased> {
+        static constexpr const char* k_Name = "input::Keyboard::OnKeyReleased";
+
+        static void                           save(RecordWriter& writer, const input::Keyboard::OnKeyReleased& message);
+        static input::Keyboard::OnKeyReleased load(RecordReader& reader);
+    };
 }
\ No newline at end of file
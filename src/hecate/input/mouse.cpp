@@ -1,6 +1,7 @@
 #include "mouse.h"
 #include "input.h"
 #include "../core/mediator.h"
+#include "../core/message_recording.h"
 
 #include <ostream>
 #include <format>
@@ -141,4 +142,116 @@ namespace hecate::input {
 
         return os;
     }
-}
\ No newline at end of file
+}
+
+namespace hecate {
+    void DeliveryPolicy<input::Mouse::OnMoved>::accumulate(
+        input::Mouse::OnMoved&       pending,
+        const input::Mouse::OnMoved& message
+    ) {
+        // [NOTE] movement of different mice isn't merged; if that happens within a frame, the last mouse wins
+        if (pending.m_Mouse != message.m_Mouse) {
+            pending = message;
+            return;
+        }
+
+        pending.m_X = message.m_X;
+        pending.m_Y = message.m_Y;
+
+        pending.m_DeltaX += message.m_DeltaX;
+        pending.m_DeltaY += message.m_DeltaY;
+    }
+
+    void RecordedMessage<input::Mouse::OnMoved>::save(
+        RecordWriter&                writer,
+        const input::Mouse::OnMoved& message
+    ) {
+        writer.write(message.m_X);
+        writer.write(message.m_Y);
+        writer.write(message.m_DeltaX);
+        writer.write(message.m_DeltaY);
+    }
+
+    input::Mouse::OnMoved RecordedMessage<input::Mouse::OnMoved>::load(RecordReader& reader) {
+        input::Mouse::OnMoved result = {};
+
+        result.m_X      = reader.read<float>();
+        result.m_Y      = reader.read<float>();
+        result.m_DeltaX = reader.read<float>();
+        result.m_DeltaY = reader.read<float>();
+
+        return result;
+    }
+
+    void RecordedMessage<input::Mouse::OnButtonPressed>::save(
+        RecordWriter&                        writer,
+        const input::Mouse::OnButtonPressed& message
+    ) {
+        writer.write(message.m_X);
+        writer.write(message.m_Y);
+        writer.write(static_cast<uint8_t>(message.m_Button));
+    }
+
+    input::Mouse::OnButtonPressed RecordedMessage<input::Mouse::OnButtonPressed>::load(RecordReader& reader) {
+        input::Mouse::OnButtonPressed result = {};
+
+        result.m_X      = reader.read<float>();
+        result.m_Y      = reader.read<float>();
+        result.m_Button = static_cast<input::Mouse::e_Button>(reader.read<uint8_t>());
+
+        return result;
+    }
+
+    void RecordedMessage<input::Mouse::OnButtonReleased>::save(
+        RecordWriter&                         writer,
+        const input::Mouse::OnButtonReleased& message
+    ) {
+        writer.write(message.m_X);
+        writer.write(message.m_Y);
+        writer.write(static_cast<uint8_t>(message.m_Button));
+    }
+
+    input::Mouse::OnButtonReleased RecordedMessage<input::Mouse::OnButtonReleased>::load(RecordReader& reader) {
+        input::Mouse::OnButtonReleased result = {};
+
+        result.m_X      = reader.read<float>();
+        result.m_Y      = reader.read<float>();
+        result.m_Button = static_cast<input::Mouse::e_Button>(reader.read<uint8_t>());
+
+        return result;
+    }
+
+    void RecordedMessage<input::Mouse::OnDoubleClick>::save(
+        RecordWriter&                      writer,
+        const input::Mouse::OnDoubleClick& message
+    ) {
+        writer.write(message.m_X);
+        writer.write(message.m_Y);
+        writer.write(static_cast<uint8_t>(message.m_Button));
+    }
+
+    input::Mouse::OnDoubleClick RecordedMessage<input::Mouse::OnDoubleClick>::load(RecordReader& reader) {
+        input::Mouse::OnDoubleClick result = {};
+
+        result.m_X      = reader.read<float>();
+        result.m_Y      = reader.read<float>();
+        result.m_Button = static_cast<input::Mouse::e_Button>(reader.read<uint8_t>());
+
+        return result;
+    }
+
+    void RecordedMessage<input::Mouse::OnScroll>::save(
+        RecordWriter&                 writer,
+        const input::Mouse::OnScroll& message
+    ) {
+        writer.write(static_cast<int32_t>(message.m_ScrollAmount));
+    }
+
+    input::Mouse::OnScroll RecordedMessage<input::Mouse::OnScroll>::load(RecordReader& reader) {
+        input::Mouse::OnScroll result = {};
+
+        result.m_ScrollAmount = reader.read<int32_t>();
+
+        return result;
+    }
+}
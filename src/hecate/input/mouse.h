@@ -4,8 +4,15 @@
 #include <utility>
 #include <array>
 
+#include "../core/delivery_policy.h"
+
 namespace hecate {
     class Input;
+    class RecordWriter;
+    class RecordReader;
+
+    template <typename T>
+    struct RecordedMessage;
 
     namespace input {
         // [TODO] when I've got some math basics in place, the XY stuff should be some
@@ -97,4 +104,55 @@ namespace hecate {
 
         std::ostream& operator << (std::ostream& os, const Mouse& m);
     }
+
+    // mouse movement can arrive at the polling rate of the device (1000Hz+), so it's coalesced into
+    // a single event per frame with the final position and the summed deltas
+    template <>
+    struct DeliveryPolicy<input::Mouse::OnMoved> {
+        static constexpr e_Delivery k_Delivery = e_Delivery::accumulate;
+
+        static void accumulate(input::Mouse::OnMoved& pending, const input::Mouse::OnMoved& message);
+    };
+
+    // mouse events can be recorded and replayed (see core/message_recording.h);
+    // the mouse pointer is not recorded, replayed events carry nullptr
+    template <>
+    struct RecordedMessage<input::Mouse::OnMoved> {
+        static constexpr const char* k_Name = "input::Mouse::OnMoved";
+
+        static void                  save(RecordWriter& writer, const input::Mouse::OnMoved& message);
+        static input::Mouse::OnMoved load(RecordReader& reader);
+    };
+
+    template <>
+    struct RecordedMessage<input::Mouse::OnButtonPressed> {
+        static constexpr const char* k_Name = "input::Mouse::OnButtonPressed";
+
+        static void                          save(RecordWriter& writer, const input::Mouse::OnButtonPressed& message);
+        static input::Mouse::OnButtonPressed load(RecordReader& reader);
+    };
+
+    template <>
+    struct RecordedMessage<input::Mouse::OnButtonReleased> {
+        static constexpr const char* k_Name = "input::Mouse::OnButtonReleased";
+
+        static void                           save(RecordWriter& writer, const input::Mouse::OnButtonReleased& message);
+        static input::Mouse::OnButtonReleased load(RecordReader& reader);
+    };
+
+    template <>
+    struct RecordedMessage<input::Mouse::OnDoubleClick> {
+        static constexpr const char* k_Name = "input::Mouse::OnDoubleClick";
+
+        static void                        save(RecordWriter& writer, const input::Mouse::OnDoubleClick& message);
+        static input::Mouse::OnDoubleClick load(RecordReader& reader);
+    };
+
+    template <>
+    struct RecordedMessage<input::Mouse::OnScroll> {
+        static constexpr const char* k_Name = "input::Mouse::OnScroll";
+
+        static void                   save(RecordWriter& writer, const input::Mouse::OnScroll& message);
+        static input::Mouse::OnScroll load(RecordReader& reader);
+    };
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../preprocessor.h"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+
+namespace hecate::platform {
+	/*
+	*	Read/write shared mapping of an entire file
+	*
+	*	Writes through the mapping end up in the OS page cache right away, so they survive the
+	*	process crashing; sync() only matters for surviving the machine going down.
+	*/
+	class MappedFile {
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile             (const MappedFile&) = delete;
+		MappedFile& operator = (const MappedFile&) = delete;
+		MappedFile             (MappedFile&&)      = delete;
+		MappedFile& operator = (MappedFile&&)      = delete;
+
+		bool open(const std::filesystem::path& p); // creates the file if it doesn't exist yet; returns false on failure
+		void close(size_t final_size);             // truncates the file to final_size bytes
+
+		bool resize(size_t num_bytes); // reserves disk space and remaps, returns false on failure (the old mapping stays valid)
+		void sync(
+			size_t offset,
+			size_t num_bytes,
+			bool   wait      // block until the range was written to disk
+		);
+
+		[[nodiscard]] bool   is_open() const noexcept;
+		[[nodiscard]] char*  get_data() const noexcept;
+		[[nodiscard]] size_t get_size() const noexcept;
+
+		// when the file was created; if the file system doesn't keep track of that, when it was last modified
+		[[nodiscard]] std::chrono::system_clock::time_point get_creation_time() const;
+
+	private:
+		void unmap();
+
+		char*  m_Data = nullptr;
+		size_t m_Size = 0;
+
+#if HECATE_PLATFORM == HECATE_PLATFORM_WINDOWS
+		void* m_File    = nullptr; // HANDLE
+		void* m_Mapping = nullptr; // HANDLE
+#else
+		int   m_File    = -1;
+#endif
+	};
+}
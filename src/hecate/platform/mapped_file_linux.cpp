@@ -0,0 +1,156 @@
+#include "mapped_file.h"
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if HECATE_PLATFORM != HECATE_PLATFORM_LINUX
+	#error "This is platform-specific, please remove it from the CMakeList so that it doesn't get compiled for any platform other than linux"
+#endif
+
+namespace hecate::platform {
+	MappedFile::~MappedFile() {
+		if (is_open())
+			close(m_Size);
+	}
+
+	bool MappedFile::open(const std::filesystem::path& p) {
+		if (is_open())
+			close(m_Size);
+
+		m_File = ::open(p.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+		if (m_File < 0)
+			return false;
+
+		struct stat info = {};
+
+		if (fstat(m_File, &info) != 0) {
+			::close(m_File);
+			m_File = -1;
+
+			return false;
+		}
+
+		m_Size = static_cast<size_t>(info.st_size);
+
+		if (m_Size == 0)
+			return true;
+
+		void* data = mmap(nullptr, m_Size, PROT_READ | PROT_WRITE, MAP_SHARED, m_File, 0);
+
+		if (data == MAP_FAILED) {
+			::close(m_File);
+			m_File = -1;
+			m_Size = 0;
+
+			return false;
+		}
+
+		m_Data = static_cast<char*>(data);
+
+		return true;
+	}
+
+	void MappedFile::close(size_t final_size) {
+		if (!is_open())
+			return;
+
+		unmap();
+
+		if (ftruncate(m_File, static_cast<off_t>(final_size)) != 0) {
+			// nothing sensible to do here; the file keeps its padding
+		}
+
+		::close(m_File);
+
+		m_File = -1;
+		m_Size = 0;
+	}
+
+	bool MappedFile::resize(size_t num_bytes) {
+		if (!is_open())
+			return false;
+
+		if (num_bytes > m_Size) {
+			// [NOTE] actually reserve the blocks; writing to a sparse mapping on a full disk raises SIGBUS
+			int result = posix_fallocate(m_File, 0, static_cast<off_t>(num_bytes));
+
+			if (result == EOPNOTSUPP || result == EINVAL) {
+				if (ftruncate(m_File, static_cast<off_t>(num_bytes)) != 0)
+					return false;
+			}
+			else if (result != 0)
+				return false;
+		}
+		else if (ftruncate(m_File, static_cast<off_t>(num_bytes)) != 0)
+			return false;
+
+		void* data = nullptr;
+
+		if (m_Data)
+			data = mremap(m_Data, m_Size, num_bytes, MREMAP_MAYMOVE);
+		else
+			data = mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_File, 0);
+
+		if (data == MAP_FAILED)
+			return false;
+
+		m_Data = static_cast<char*>(data);
+		m_Size = num_bytes;
+
+		return true;
+	}
+
+	void MappedFile::sync(
+		size_t offset,
+		size_t num_bytes,
+		bool   wait
+	) {
+		if (!m_Data || num_bytes == 0)
+			return;
+
+		// msync wants a page aligned address
+		static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+		size_t begin = offset - (offset % page_size);
+
+		msync(m_Data + begin, offset + num_bytes - begin, wait ? MS_SYNC : MS_ASYNC);
+	}
+
+	bool MappedFile::is_open() const noexcept {
+		return m_File >= 0;
+	}
+
+	std::chrono::system_clock::time_point MappedFile::get_creation_time() const {
+		struct statx info = {};
+
+		if (statx(m_File, "", AT_EMPTY_PATH, STATX_BTIME | STATX_MTIME, &info) != 0)
+			return std::chrono::system_clock::now();
+
+		const auto& time = (info.stx_mask & STATX_BTIME) ? info.stx_btime : info.stx_mtime;
+
+		return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+			std::chrono::seconds(time.tv_sec) +
+			std::chrono::nanoseconds(time.tv_nsec)
+		));
+	}
+
+	char* MappedFile::get_data() const noexcept {
+		return m_Data;
+	}
+
+	size_t MappedFile::get_size() const noexcept {
+		return m_Size;
+	}
+
+	void MappedFile::unmap() {
+		if (m_Data)
+			munmap(m_Data, m_Size);
+
+		m_Data = nullptr;
+	}
+}
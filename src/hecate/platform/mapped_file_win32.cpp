@@ -0,0 +1,184 @@
+#include "mapped_file.h"
+
+#include <cstdint>
+
+#include <memoryapi.h>
+
+#if HECATE_PLATFORM != HECATE_PLATFORM_WINDOWS
+	#error This is platform-specific, please remove it from the CMakeList so that it doesn't get compiled for any platform other than windows
+#endif
+
+namespace hecate::platform {
+	MappedFile::~MappedFile() {
+		if (is_open())
+			close(m_Size);
+	}
+
+	bool MappedFile::open(const std::filesystem::path& p) {
+		if (is_open())
+			close(m_Size);
+
+		// [NOTE] FILE_SHARE_DELETE so the file can be renamed while it's open (log rotation)
+		HANDLE file = CreateFileW(
+			p.c_str(),
+			GENERIC_READ | GENERIC_WRITE,
+			FILE_SHARE_READ | FILE_SHARE_DELETE,
+			nullptr,
+			OPEN_ALWAYS,
+			FILE_ATTRIBUTE_NORMAL,
+			nullptr
+		);
+
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		// [NOTE] a file that is created right after another one with the same name was renamed away gets
+		//        the old creation time ('file tunneling'), which would make a rotated log look old
+		if (GetLastError() != ERROR_ALREADY_EXISTS) {
+			FILETIME now = {};
+
+			GetSystemTimeAsFileTime(&now);
+			SetFileTime(file, &now, nullptr, nullptr);
+		}
+
+		LARGE_INTEGER size = {};
+
+		if (!GetFileSizeEx(file, &size)) {
+			CloseHandle(file);
+			return false;
+		}
+
+		m_File = file;
+
+		if (size.QuadPart == 0)
+			return true;
+
+		if (!resize(static_cast<size_t>(size.QuadPart))) {
+			CloseHandle(file);
+			m_File = nullptr;
+
+			return false;
+		}
+
+		return true;
+	}
+
+	void MappedFile::close(size_t final_size) {
+		if (!is_open())
+			return;
+
+		unmap();
+
+		LARGE_INTEGER position = {};
+		position.QuadPart = static_cast<LONGLONG>(final_size);
+
+		if (SetFilePointerEx(m_File, position, nullptr, FILE_BEGIN))
+			SetEndOfFile(m_File);
+
+		CloseHandle(m_File);
+
+		m_File = nullptr;
+		m_Size = 0;
+	}
+
+	bool MappedFile::resize(size_t num_bytes) {
+		if (!is_open())
+			return false;
+
+		// a file mapping can't change size; make a new one
+		unmap();
+
+		LARGE_INTEGER position = {};
+		position.QuadPart = static_cast<LONGLONG>(num_bytes);
+
+		bool resized =
+			SetFilePointerEx(m_File, position, nullptr, FILE_BEGIN) &&
+			SetEndOfFile(m_File);
+
+		if (!resized)
+			num_bytes = m_Size; // map the old size again
+
+		if (num_bytes == 0)
+			return false;
+
+		m_Mapping = CreateFileMappingW(
+			m_File,
+			nullptr,
+			PAGE_READWRITE,
+			static_cast<DWORD>(static_cast<uint64_t>(num_bytes) >> 32),
+			static_cast<DWORD>(num_bytes & 0xFFFFFFFF),
+			nullptr
+		);
+
+		if (!m_Mapping)
+			return false;
+
+		m_Data = static_cast<char*>(MapViewOfFile(m_Mapping, FILE_MAP_WRITE, 0, 0, num_bytes));
+
+		if (!m_Data) {
+			CloseHandle(m_Mapping);
+			m_Mapping = nullptr;
+
+			return false;
+		}
+
+		m_Size = num_bytes;
+
+		return resized;
+	}
+
+	void MappedFile::sync(
+		size_t offset,
+		size_t num_bytes,
+		bool   wait
+	) {
+		if (!m_Data || num_bytes == 0)
+			return;
+
+		FlushViewOfFile(m_Data + offset, num_bytes);
+
+		if (wait)
+			FlushFileBuffers(m_File);
+	}
+
+	bool MappedFile::is_open() const noexcept {
+		return m_File != nullptr;
+	}
+
+	std::chrono::system_clock::time_point MappedFile::get_creation_time() const {
+		FILETIME creation = {};
+
+		if (!GetFileTime(m_File, &creation, nullptr, nullptr))
+			return std::chrono::system_clock::now();
+
+		// 100ns intervals since 1601-01-01
+		constexpr uint64_t k_UnixEpoch = 116444736000000000ull;
+
+		uint64_t ticks =
+			(static_cast<uint64_t>(creation.dwHighDateTime) << 32) |
+			creation.dwLowDateTime;
+
+		return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+			std::chrono::duration<int64_t, std::ratio<1, 10'000'000>>(static_cast<int64_t>(ticks - k_UnixEpoch))
+		));
+	}
+
+	char* MappedFile::get_data() const noexcept {
+		return m_Data;
+	}
+
+	size_t MappedFile::get_size() const noexcept {
+		return m_Size;
+	}
+
+	void MappedFile::unmap() {
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+
+		if (m_Mapping)
+			CloseHandle(m_Mapping);
+
+		m_Data    = nullptr;
+		m_Mapping = nullptr;
+	}
+}
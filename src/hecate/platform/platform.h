@@ -22,6 +22,7 @@ namespace hecate {
 	//
 	// This is responsible for platform-specific stuff, WSI etc
 	// The idea is to have this be the interface, while using CMake to differentiate which cpp to implement it
+	// (platform_win32.cpp, or the headless platform_linux.cpp)
 	// 
 	// NOTE there is some bundling of responsibilities here, might be better to factor some stuff out
 	// 
@@ -30,6 +31,7 @@ namespace hecate {
 	{
 	public:
 		Platform();
+		~Platform() override;
 
 		bool init()     override;
 		void update()   override;
@@ -38,6 +40,8 @@ namespace hecate {
 		// WSI
 		void close(platform::Window* window);
 
+		bool is_headless() const noexcept; // no windows, the engine runs until it is stopped (or gets SIGINT/SIGTERM)
+
 		// Filesystem
 
 		// Clock
@@ -45,15 +49,16 @@ namespace hecate {
 		static void   sleep_ms(uint64_t milliseconds);
 
 		// Vulkan
-		static std::vector<const char*> get_required_vulkan_extensions();
+		std::vector<const char*> get_required_vulkan_extensions() const; // empty when headless
 
 	private:
 		using WindowPtr = std::unique_ptr<platform::Window>;
 
 		// persistent variables
-		int m_MainWindowWidth  = -1; // use -1 for OS default
-		int m_MainWindowHeight = -1; // use -1 for OS default
-		int m_DisplayDeviceIdx = 0;
+		int  m_MainWindowWidth  = -1;    // use -1 for OS default
+		int  m_MainWindowHeight = -1;    // use -1 for OS default
+		int  m_DisplayDeviceIdx = 0;
+		bool m_Headless         = false; // always true on linux
 
 		std::vector<WindowPtr>         m_Windows;
 		std::vector<platform::Window*> m_ShouldClose;
@@ -0,0 +1,140 @@
+#include "platform.h"
+#include "window.h"
+#include "../dependencies.h"
+#include "../core/engine.h"
+#include "../core/logger.h"
+
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+
+#include <dlfcn.h>
+
+#if HECATE_PLATFORM != HECATE_PLATFORM_LINUX
+	#error "This is platform-specific, please remove it from the CMakeList so that it doesn't get compiled for any platform other than linux"
+#endif
+
+// [NOTE] this is a headless platform; there is no window system, so no windows, keyboard or mouse
+//        the engine runs until it is stopped explicitly or the process receives SIGINT/SIGTERM
+
+namespace {
+	volatile std::sig_atomic_t g_StopRequested = 0;
+
+	struct sigaction g_PreviousSigInt  = {};
+	struct sigaction g_PreviousSigTerm = {};
+
+	void signal_handler(int) {
+		g_StopRequested = 1;
+	}
+
+	timespec get_monotonic_time() {
+		timespec result;
+		clock_gettime(CLOCK_MONOTONIC, &result);
+		return result;
+	}
+
+	const timespec g_StartTime = get_monotonic_time();
+}
+
+namespace hecate {
+	Platform::Platform():
+		System("Platform")
+	{
+		add_dependency("Input"); // we need this system to be available so that we can do keybinding etc
+		require_main_thread();   // keep the same threading guarantees as the other platforms
+
+		// not used when headless, but kept so that settings files can be shared between platforms
+		register_setting("main_window_width",  &m_MainWindowWidth);
+		register_setting("main_window_height", &m_MainWindowHeight);
+		register_setting("display_device",     &m_DisplayDeviceIdx);
+
+		m_Headless = true;
+	}
+
+	Platform::~Platform() {
+	}
+
+	bool Platform::init() {
+		System::init();
+
+		g_Log << "Running headless";
+
+		struct sigaction action = {};
+
+		action.sa_handler = signal_handler;
+		sigemptyset(&action.sa_mask);
+
+		sigaction(SIGINT,  &action, &g_PreviousSigInt);
+		sigaction(SIGTERM, &action, &g_PreviousSigTerm);
+
+		return true;
+	}
+
+	void Platform::update() {
+		if (g_StopRequested)
+			m_Engine->stop();
+	}
+
+	void Platform::shutdown() {
+		System::shutdown();
+
+		sigaction(SIGINT,  &g_PreviousSigInt,  nullptr);
+		sigaction(SIGTERM, &g_PreviousSigTerm, nullptr);
+	}
+
+	namespace platform {
+		void* load_dynamic_library(const char* name) {
+			void* result = dlopen(name, RTLD_NOW | RTLD_LOCAL);
+
+			if (!result)
+				g_LogWarning << "Failed to load " << name << ": " << dlerror();
+
+			return result;
+		}
+
+		void unload_dynamic_library(void* handle) {
+			dlclose(handle);
+		}
+
+		DynamicFunction get_dynamic_symbol(void* handle, const char* name) {
+			return reinterpret_cast<DynamicFunction>(dlsym(handle, name));
+		}
+	}
+
+	void Platform::close(platform::Window*) {
+		g_LogWarning << "Cannot close a window on a headless platform";
+	}
+
+	bool Platform::is_headless() const noexcept {
+		return m_Headless;
+	}
+
+	double Platform::get_absolute_time() {
+		timespec now = get_monotonic_time();
+
+		return
+			static_cast<double>(now.tv_sec  - g_StartTime.tv_sec) +
+			static_cast<double>(now.tv_nsec - g_StartTime.tv_nsec) * 1e-9;
+	}
+
+	void Platform::sleep_ms(uint64_t milliseconds) {
+		// sleep until an absolute deadline so that interruptions (signals) don't extend the total duration
+		timespec deadline = get_monotonic_time();
+
+		deadline.tv_sec  += static_cast<time_t>(milliseconds / 1000);
+		deadline.tv_nsec += static_cast<long>((milliseconds % 1000) * 1'000'000);
+
+		if (deadline.tv_nsec >= 1'000'000'000) {
+			deadline.tv_sec  += 1;
+			deadline.tv_nsec -= 1'000'000'000;
+		}
+
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+		}
+	}
+
+	std::vector<const char*> Platform::get_required_vulkan_extensions() const {
+		return {}; // no surfaces when headless
+	}
+}
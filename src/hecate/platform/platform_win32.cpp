@@ -7,6 +7,7 @@
 #include "../input/input.h"
 #include "../util/flat_map.h"
 
+#include <atomic>
 #include <thread>
 #include <chrono>
 
@@ -25,6 +26,22 @@ namespace {
 	HMODULE                 g_XInputDLL           = nullptr;
 	hecate::DynamicFunction XInputGetCapabilities = nullptr;
 	hecate::DynamicFunction XInputGetState        = nullptr;
+
+	// console close requests while running headless
+	std::atomic_bool g_StopRequested = false;
+
+	BOOL WINAPI console_handler(DWORD ctrl_type) {
+		switch (ctrl_type) {
+		case CTRL_C_EVENT:
+		case CTRL_BREAK_EVENT:
+		case CTRL_CLOSE_EVENT:
+			g_StopRequested = true;
+			return TRUE;
+
+		default:
+			return FALSE;
+		}
+	}
 }
 
 namespace hecate {
@@ -32,10 +49,15 @@ namespace hecate {
 		System("Platform")
 	{
 		add_dependency("Input"); // we need this system to be available so that we can do keybinding etc
+		require_main_thread();   // the message pump must run on the thread that created the windows
 
 		register_setting("main_window_width",  &m_MainWindowWidth);
 		register_setting("main_window_height", &m_MainWindowHeight);
 		register_setting("display_device",     &m_DisplayDeviceIdx);
+		register_setting("headless",           &m_Headless);
+	}
+
+	Platform::~Platform() {
 	}
 
 	bool Platform::init() {
@@ -65,6 +87,14 @@ namespace hecate {
 			DirectInput8Create = platform::get_dynamic_symbol(g_DirectInputDLL, "DirectInput8Create");
 		}
 
+		if (m_Headless) {
+			g_Log << "Running headless";
+
+			SetConsoleCtrlHandler(console_handler, TRUE);
+
+			return true;
+		}
+
 		// create main window
 		m_Windows.push_back(std::make_unique<platform::Window>(
 			"Hecate",
@@ -78,7 +108,11 @@ namespace hecate {
 	}
 
 	void Platform::update() {
-		if (m_Windows.empty())
+		if (m_Headless) {
+			if (g_StopRequested)
+				m_Engine->stop();
+		}
+		else if (m_Windows.empty())
 			m_Engine->stop();
 		else {
 			MSG msg = {};
@@ -111,6 +145,9 @@ namespace hecate {
 	void Platform::shutdown() {
 		System::shutdown();
 
+		if (m_Headless)
+			SetConsoleCtrlHandler(console_handler, FALSE);
+
 		if (g_DirectInputDLL)
 			platform::unload_dynamic_library(g_DirectInputDLL);
 	}
@@ -140,6 +177,10 @@ namespace hecate {
 		m_ShouldClose.push_back(window);
 	}
 
+	bool Platform::is_headless() const noexcept {
+		return m_Headless;
+	}
+
 	double Platform::get_absolute_time() {
 		if (!g_ClockFrequency) {
 			g_LogWarning << "Clock frequency is unknown";
@@ -157,7 +198,10 @@ namespace hecate {
 		Sleep(static_cast<DWORD>(milliseconds));
 	}
 
-	std::vector<const char*> Platform::get_required_vulkan_extensions() {
+	std::vector<const char*> Platform::get_required_vulkan_extensions() const {
+		if (m_Headless)
+			return {};
+
 		return {
 			"VK_KHR_win32_surface" // https://www.khronos.org/registry/vulkan/specs/1.2-extensions/html/vkspec.html#VK_KHR_win32_surface
 		};
@@ -0,0 +1,95 @@
+#include "window.h"
+#include "platform.h"
+
+#include "../preprocessor.h"
+#include "../input/mouse.h"
+#include "../input/keyboard.h"
+
+#include <stdexcept>
+
+#if HECATE_PLATFORM != HECATE_PLATFORM_LINUX
+	#error This cpp is specific to linux
+#endif
+
+// [NOTE] the linux platform is headless, so windows cannot be created; this only exists so that
+//        code referring to windows (f.e. input handlers) still links
+
+namespace hecate::platform {
+	Window::Window(
+		const std::string&,
+		Platform* owner,
+		int       width,
+		int       height,
+		int       display_device_idx
+	):
+		m_Width           (width),
+		m_Height          (height),
+		m_DisplayDeviceIdx(display_device_idx),
+		m_Owner           (owner)
+	{
+		throw std::runtime_error("Windows are not available on a headless platform");
+	}
+
+	Window::~Window() {
+	}
+
+	bool Window::is_main_window() const noexcept {
+		return false;
+	}
+
+	bool Window::is_minimized() const noexcept {
+		return false;
+	}
+
+	int Window::get_width()  const noexcept {
+		return m_Width;
+	}
+
+	int Window::get_height() const noexcept {
+		return m_Height;
+	}
+
+	int Window::get_display_device_idx() const noexcept {
+		return m_DisplayDeviceIdx;
+	}
+
+	void Window::update_size(int new_width, int new_height) {
+		m_Width  = new_width;
+		m_Height = new_height;
+	}
+
+	void Window::set_size(int, int) {
+	}
+
+	void Window::set_position(int, int) {
+	}
+
+	void Window::close() {
+		m_Owner->close(this);
+	}
+
+	void Window::maximize() {
+	}
+
+	void Window::minimize() {
+	}
+
+	void Window::restore() {
+	}
+
+	Window::Keyboard* Window::get_keyboard() noexcept {
+		return m_Keyboard.get();
+	}
+
+	const Window::Keyboard* Window::get_keyboard() const noexcept {
+		return m_Keyboard.get();
+	}
+
+	Window::Mouse* Window::get_mouse() noexcept {
+		return m_Mouse.get();
+	}
+
+	const Window::Mouse* Window::get_mouse() const noexcept {
+		return m_Mouse.get();
+	}
+}
@@ -97,6 +97,21 @@
 	#undef max
 #endif
 
+// profiling zones (see core/profiler.h) are compiled in unless disabled explicitly
+#ifndef HECATE_PROFILING
+	#define HECATE_PROFILING 1
+#endif
+
+// per message type counters and handler latencies (see core/message_stats.h), same deal
+#ifndef HECATE_MESSAGE_STATS
+	#define HECATE_MESSAGE_STATS 1
+#endif
+
+// log messages below this category are compiled out (0 debug, 1 info, 2 warning, 3 error, 4 fatal; see core/logger.h)
+#ifndef HECATE_LOG_MIN_CATEGORY
+	#define HECATE_LOG_MIN_CATEGORY 0
+#endif
+
 #define NOT_IMPLEMENTED throw std::runtime_error("Not implemented");
 
 // compiler related
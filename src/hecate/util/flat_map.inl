@@ -53,7 +53,7 @@ namespace hecate::util {
 		}
 		else {
 			// key found, update entry
-			auto idx = std::distance(std::begin(m_Keys), it);
+			auto idx = std::distance(std::cbegin(m_Keys), it);
 			m_Values[idx] = value;
 		}
 	}
@@ -121,7 +121,7 @@ namespace hecate::util {
 		if (it == std::end(m_Keys))
 			g_LogWarning << "Key not found";
 		else {
-			auto idx = std::distance(std::begin(m_Keys), it);
+			auto idx = std::distance(std::cbegin(m_Keys), it);
 			m_Keys.erase(it);
 			m_Values.erase(std::begin(m_Values) + idx);
 		}
@@ -0,0 +1,113 @@
+#include "linear_allocator.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+	// chunks are aligned generously so that typical over-aligned types don't need padding at the start
+	constexpr size_t k_ChunkAlignment = 64;
+}
+
+namespace hecate::util {
+	LinearAllocator::LinearAllocator(
+		size_t                     initial_size,
+		std::pmr::memory_resource* upstream
+	):
+		m_Upstream(upstream)
+	{
+		add_chunk(initial_size);
+	}
+
+	LinearAllocator::~LinearAllocator() {
+		release_chunks();
+	}
+
+	void LinearAllocator::reset() {
+		if (m_Chunks.size() > 1) {
+			// replace everything with a single chunk big enough for all of it
+			size_t total = m_Capacity;
+
+			release_chunks();
+			add_chunk(total);
+		}
+		else if (!m_Chunks.empty()) {
+			m_Current = m_Chunks.back().m_Data;
+			m_End     = m_Current + m_Chunks.back().m_Size;
+		}
+
+		m_BytesAllocated = 0;
+		m_NumAllocations = 0;
+	}
+
+	size_t LinearAllocator::get_bytes_allocated() const noexcept {
+		return m_BytesAllocated;
+	}
+
+	size_t LinearAllocator::get_num_allocations() const noexcept {
+		return m_NumAllocations;
+	}
+
+	size_t LinearAllocator::get_capacity() const noexcept {
+		return m_Capacity;
+	}
+
+	size_t LinearAllocator::get_num_chunks() const noexcept {
+		return m_Chunks.size();
+	}
+
+	void* LinearAllocator::do_allocate(size_t bytes, size_t alignment) {
+		auto align_up = [alignment](std::byte* ptr) {
+			auto value = reinterpret_cast<uintptr_t>(ptr);
+			return reinterpret_cast<std::byte*>((value + alignment - 1) & ~(uintptr_t(alignment) - 1));
+		};
+
+		std::byte* result = align_up(m_Current);
+
+		if ((result > m_End) || (static_cast<size_t>(m_End - result) < bytes)) {
+			// grow geometrically, and make sure the request fits including alignment
+			add_chunk(std::max(m_Capacity, bytes + alignment));
+
+			result = align_up(m_Current);
+		}
+
+		m_Current         = result + bytes;
+		m_BytesAllocated += bytes;
+		++m_NumAllocations;
+
+		return result;
+	}
+
+	void LinearAllocator::do_deallocate(void*, size_t, size_t) {
+		// everything is released at once in reset()
+	}
+
+	bool LinearAllocator::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+		return this == &other;
+	}
+
+	void LinearAllocator::add_chunk(size_t min_size) {
+		size_t size = std::max<size_t>(min_size, k_ChunkAlignment);
+
+		Chunk chunk;
+
+		chunk.m_Data = static_cast<std::byte*>(m_Upstream->allocate(size, k_ChunkAlignment));
+		chunk.m_Size = size;
+
+		m_Chunks.push_back(chunk);
+
+		m_Current   = chunk.m_Data;
+		m_End       = chunk.m_Data + size;
+		m_Capacity += size;
+	}
+
+	void LinearAllocator::release_chunks() {
+		for (const auto& chunk : m_Chunks)
+			m_Upstream->deallocate(chunk.m_Data, chunk.m_Size, k_ChunkAlignment);
+
+		m_Chunks.clear();
+
+		m_Current  = nullptr;
+		m_End      = nullptr;
+		m_Capacity = 0;
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hecate::util {
+	// Bump allocator; allocation is a pointer increment, deallocation does nothing and all memory
+	// is released at once via reset()
+	//
+	// [NOTE] not thread-safe, use one per thread
+	// [NOTE] destructors are never run for objects created in here, so prefer trivially destructible types
+	//        (or types that only hold memory from this same allocator)
+	// [NOTE] when an allocation doesn't fit, a new (larger) chunk is requested upstream; reset() consolidates
+	//        all chunks into a single one so that steady-state usage doesn't hit the upstream resource at all
+	class LinearAllocator:
+		public std::pmr::memory_resource
+	{
+	public:
+		static constexpr size_t k_DefaultChunkSize = 64 * 1024;
+
+		explicit LinearAllocator(
+			size_t                     initial_size = k_DefaultChunkSize,
+			std::pmr::memory_resource* upstream     = std::pmr::new_delete_resource()
+		);
+		~LinearAllocator() override;
+
+		LinearAllocator             (const LinearAllocator&) = delete;
+		LinearAllocator& operator = (const LinearAllocator&) = delete;
+		LinearAllocator             (LinearAllocator&&)      = delete;
+		LinearAllocator& operator = (LinearAllocator&&)      = delete;
+
+		void reset(); // invalidates everything allocated so far
+
+		template <typename T, typename... t_Args>
+		T* create(t_Args&&... args);
+
+		template <typename T>
+		requires std::is_trivially_destructible_v<T>
+		std::span<T> create_array(size_t count); // value-initialized
+
+		[[nodiscard]] size_t get_bytes_allocated() const noexcept; // since the last reset, excluding alignment padding
+		[[nodiscard]] size_t get_num_allocations() const noexcept; // since the last reset
+		[[nodiscard]] size_t get_capacity()        const noexcept; // total size of all chunks
+		[[nodiscard]] size_t get_num_chunks()      const noexcept;
+
+	protected:
+		void* do_allocate(size_t bytes, size_t alignment) override;
+		void  do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+		bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+	private:
+		struct Chunk {
+			std::byte* m_Data = nullptr;
+			size_t     m_Size = 0;
+		};
+
+		void add_chunk(size_t min_size);
+		void release_chunks();
+
+		std::pmr::memory_resource* m_Upstream = nullptr;
+		std::vector<Chunk>         m_Chunks;
+
+		std::byte* m_Current = nullptr; // in the last chunk
+		std::byte* m_End     = nullptr;
+
+		size_t m_BytesAllocated = 0;
+		size_t m_NumAllocations = 0;
+		size_t m_Capacity       = 0;
+	};
+}
+
+#include "linear_allocator.inl"
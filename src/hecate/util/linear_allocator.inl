@@ -0,0 +1,28 @@
+#pragma once
+
+#include "linear_allocator.h"
+
+#include <new>
+
+namespace hecate::util {
+	template <typename T, typename... t_Args>
+	T* LinearAllocator::create(t_Args&&... args) {
+		void* ptr = allocate(sizeof(T), alignof(T));
+
+		return ::new (ptr) T(std::forward<t_Args>(args)...);
+	}
+
+	template <typename T>
+	requires std::is_trivially_destructible_v<T>
+	std::span<T> LinearAllocator::create_array(size_t count) {
+		if (count == 0)
+			return {};
+
+		T* ptr = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+
+		for (size_t i = 0; i < count; ++i)
+			::new (ptr + i) T();
+
+		return std::span<T>(ptr, count);
+	}
+}
@@ -0,0 +1,26 @@
+#include "type_name.h"
+#include "../preprocessor.h"
+
+#include <cstdlib>
+#include <memory>
+
+#if HECATE_COMPILER != HECATE_COMPILER_MSVC
+	#include <cxxabi.h>
+#endif
+
+namespace hecate::util {
+	std::string demangle(const char* name) {
+#if HECATE_COMPILER != HECATE_COMPILER_MSVC
+		int status = 0;
+
+		std::unique_ptr<char, decltype(&std::free)> result(
+			abi::__cxa_demangle(name, nullptr, nullptr, &status),
+			&std::free
+		);
+
+		if ((status == 0) && result)
+			return result.get();
+#endif
+		return name;
+	}
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string>
+#include <typeinfo>
+
+namespace hecate::util {
+	// readable form of a typeid(...).name(); MSVC names are readable already
+	std::string demangle(const char* name);
+
+	// demangled typeid(T).name(), computed once
+	template <typename T>
+	const std::string& get_type_name() {
+		static const std::string name = demangle(typeid(T).name());
+		return name;
+	}
+}
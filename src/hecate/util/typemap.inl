@@ -27,7 +27,7 @@ namespace hecate::util {
         auto it = find(m_Keys, key);
 
         if (it != m_Keys.end()) {
-            size_t position = std::distance(std::begin(m_Keys), it);
+            size_t position = std::distance(std::cbegin(m_Keys), it);
 
             m_Keys.erase(it);
             m_Values.erase(std::begin(m_Values) + position);
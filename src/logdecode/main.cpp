@@ -0,0 +1,49 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "core/logger/binary_log.h"
+#include "core/logger/log_sink.h"
+
+using namespace hecate::core::logger;
+
+// hecate-logdecode <binary log> [output file]
+// writes the same layout as the regular log file, to the output file or to std::cout
+int main(int argc, char* argv[]) {
+	if (argc < 2) {
+		std::cerr << "Usage: hecate-logdecode <binary log> [output file]\n";
+		return 1;
+	}
+
+	BinaryLogReader reader;
+
+	if (!reader.open(argv[1])) {
+		std::cerr << "Failed to open binary log " << argv[1] << "\n";
+		return 1;
+	}
+
+	try {
+		LogSink sink = (argc > 2) ?
+			makeFileSink(argv[2]) :
+			makeStreamSink(std::cout);
+
+		LogMessage::MetaInfo info;
+		std::string          message;
+		size_t               num_messages = 0;
+
+		while (reader.next(info, message)) {
+			sink.write(info, message);
+			++num_messages;
+		}
+
+		sink.flush();
+
+		std::cerr << "Decoded " << num_messages << " messages from " << reader.getNumCallsites() << " callsites\n";
+	}
+	catch (const std::exception& ex) {
+		std::cerr << ex.what() << "\n";
+		return 1;
+	}
+
+	return 0;
+}
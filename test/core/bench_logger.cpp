@@ -0,0 +1,94 @@
+#include "../unittest.h"
+
+#include "core/logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// [NOTE] these are hidden by default, run with `unittest [benchmark]`
+
+namespace {
+	constexpr size_t k_NumLines = 50'000; // per thread
+
+	struct NullSink {
+		void operator()(
+			const hecate::core::logger::LogMessage::MetaInfo&,
+			std::string_view message
+		) {
+			m_NumBytes += message.size();
+		}
+
+		size_t m_NumBytes = 0;
+	};
+
+	// lines per second, with every thread logging k_NumLines
+	double measure(hecate::Logger& logger, size_t num_threads) {
+		using clock = std::chrono::steady_clock;
+
+		std::atomic<bool> go = false;
+		std::vector<std::jthread> threads;
+
+		for (size_t t = 0; t < num_threads; ++t)
+			threads.emplace_back([&logger, &go, t] {
+				while (!go.load(std::memory_order_acquire))
+					std::this_thread::yield();
+
+				for (size_t i = 0; i < k_NumLines; ++i)
+					logger(hecate::Logger::e_LogCategory::info, __FILE__, __LINE__) << "thread " << t << " line " << i << " value " << 0.5 * i;
+			});
+
+		auto start = clock::now();
+
+		go.store(true, std::memory_order_release);
+		threads.clear(); // joins
+
+		logger.sync();
+
+		std::chrono::duration<double> elapsed = clock::now() - start;
+
+		return static_cast<double>(k_NumLines * num_threads) / elapsed.count();
+	}
+}
+
+namespace test {
+	TEST_CASE("logger_throughput", "[.][benchmark][hecate::core]") {
+		auto path = std::filesystem::temp_directory_path() / "hecate_bench_logger.log";
+
+		for (bool async : { false, true }) {
+			for (bool file : { false, true }) {
+				for (size_t num_threads : { 1, 8, 32 }) {
+					double lines_per_second = 0;
+
+					{
+						hecate::Logger logger;
+
+						if (file)
+							logger.add(hecate::core::logger::makeFileSink(path));
+						else
+							logger.add(NullSink());
+
+						if (async)
+							logger.startAsync();
+
+						lines_per_second = measure(logger, num_threads);
+					}
+
+					std::printf(
+						"%-5s  %-4s  threads: %3zu  lines/s: %12.0f\n",
+						async ? "async" : "sync",
+						file  ? "file"  : "null",
+						num_threads,
+						lines_per_second
+					);
+				}
+			}
+		}
+
+		std::filesystem::remove(path);
+	}
+}
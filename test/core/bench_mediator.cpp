@@ -0,0 +1,202 @@
+#include "../unittest.h"
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "core/mediator.h"
+#include "core/message_stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// [NOTE] these are hidden by default, run with `unittest [benchmark]`
+
+namespace {
+	constexpr size_t k_NumBroadcasts = 200'000;
+
+	struct BenchMessage {
+		int m_Value = 0;
+	};
+
+	struct BenchHandler {
+		void operator()(const BenchMessage& msg) {
+			m_Sum.fetch_add(msg.m_Value, std::memory_order_relaxed);
+		}
+
+		std::atomic<int64_t> m_Sum = 0;
+	};
+
+	struct TrappedMessage {
+		int m_Value = 0;
+	};
+
+	struct PlainHandler {
+		void operator()(const BenchMessage& msg) {
+			m_Sum += msg.m_Value;
+		}
+
+		void operator()(const TrappedMessage& msg) {
+			m_Sum += msg.m_Value;
+		}
+
+		int64_t m_Sum = 0;
+	};
+
+	struct NullHandler {
+		void operator()(const BenchMessage&) {
+		}
+	};
+
+	std::vector<size_t> get_thread_counts() {
+		size_t hw = std::max(1u, std::thread::hardware_concurrency());
+
+		std::vector<size_t> result;
+
+		for (size_t n = 1; n < hw; n *= 2)
+			result.push_back(n);
+
+		result.push_back(hw);
+
+		return result;
+	}
+}
+
+namespace test {
+	TEST_CASE("mediator_broadcast_handlers", "[.][benchmark][hecate::core]") {
+		using clock = std::chrono::steady_clock;
+
+		for (size_t num_handlers : { 0, 1, 4, 16, 64 }) {
+			std::vector<std::unique_ptr<BenchHandler>> handlers;
+
+			for (size_t i = 0; i < num_handlers; ++i) {
+				handlers.push_back(std::make_unique<BenchHandler>());
+				hecate::attach_handler<BenchMessage>(handlers.back().get());
+			}
+
+			auto start = clock::now();
+
+			for (size_t i = 0; i < k_NumBroadcasts; ++i)
+				hecate::broadcast(BenchMessage{ 1 });
+
+			std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+
+			std::printf(
+				"handlers: %3zu  ns/broadcast: %8.1f\n",
+				num_handlers,
+				elapsed.count() / k_NumBroadcasts
+			);
+
+			for (auto& h : handlers)
+				hecate::detach_handler<BenchMessage>(h.get());
+		}
+	}
+
+	TEST_CASE("mediator_broadcast_threads", "[.][benchmark][hecate::core]") {
+		using clock = std::chrono::steady_clock;
+
+		// the handlers don't touch shared state, so this only measures the dispatch itself
+		for (size_t num_threads : get_thread_counts()) {
+			std::vector<std::unique_ptr<NullHandler>> handlers;
+
+			for (size_t i = 0; i < 4; ++i) {
+				handlers.push_back(std::make_unique<NullHandler>());
+				hecate::attach_handler<BenchMessage>(handlers.back().get());
+			}
+
+			std::atomic<bool> go = false;
+			std::vector<std::jthread> threads;
+
+			for (size_t t = 0; t < num_threads; ++t)
+				threads.emplace_back([&go] {
+					while (!go.load(std::memory_order_acquire))
+						std::this_thread::yield();
+
+					for (size_t i = 0; i < k_NumBroadcasts; ++i)
+						hecate::broadcast(BenchMessage{ 0 });
+				});
+
+			auto start = clock::now();
+
+			go.store(true, std::memory_order_release);
+			threads.clear(); // joins
+
+			std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+
+			std::printf(
+				"threads: %3zu  broadcasts/s: %12.0f  ns/broadcast per thread: %8.1f\n",
+				num_threads,
+				static_cast<double>(k_NumBroadcasts * num_threads) / (elapsed.count() * 1e-9),
+				elapsed.count() / k_NumBroadcasts
+			);
+
+			for (auto& h : handlers)
+				hecate::detach_handler<BenchMessage>(h.get());
+		}
+	}
+
+	// compares the handler table with the previous approach (std::function wrapping a lambda with a try/catch)
+	TEST_CASE("mediator_handler_dispatch", "[.][benchmark][hecate::core]") {
+		for (size_t num_handlers : { 1, 16, 64 }) {
+			std::vector<std::unique_ptr<PlainHandler>> handlers;
+
+			for (size_t i = 0; i < num_handlers; ++i)
+				handlers.push_back(std::make_unique<PlainHandler>());
+
+			std::vector<std::function<void(const BenchMessage&)>> wrapped;
+
+			for (auto& h : handlers)
+				wrapped.push_back([ptr = h.get()](const BenchMessage& msg) {
+					try {
+						(*ptr)(msg);
+					}
+					catch (...) {
+					}
+				});
+
+			for (auto& h : handlers) {
+				hecate::attach_handler<BenchMessage>  (h.get());
+				hecate::attach_handler<TrappedMessage>(h.get(), hecate::Executor::immediate(), hecate::e_HandlerExceptions::trap);
+			}
+
+			std::string suffix = " x" + std::to_string(num_handlers);
+
+			BENCHMARK("std::function" + suffix) {
+				BenchMessage msg{ 1 };
+
+				for (const auto& fn : wrapped)
+					fn(msg);
+
+				return handlers[0]->m_Sum;
+			};
+
+			BENCHMARK("broadcast" + suffix) {
+				hecate::broadcast(BenchMessage{ 1 });
+				return handlers[0]->m_Sum;
+			};
+
+			BENCHMARK("broadcast (trap)" + suffix) {
+				hecate::broadcast(TrappedMessage{ 1 });
+				return handlers[0]->m_Sum;
+			};
+
+			// with handler latencies (see core/message_stats.h)
+			hecate::set_handler_timing(true);
+
+			BENCHMARK("broadcast (timed)" + suffix) {
+				hecate::broadcast(BenchMessage{ 1 });
+				return handlers[0]->m_Sum;
+			};
+
+			hecate::set_handler_timing(false);
+
+			for (auto& h : handlers) {
+				hecate::detach_handler<BenchMessage>  (h.get());
+				hecate::detach_handler<TrappedMessage>(h.get());
+			}
+		}
+	}
+}
@@ -0,0 +1,105 @@
+#include "../unittest.h"
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "core/scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// [NOTE] these are hidden by default, run with `unittest [benchmark]`
+
+namespace {
+	constexpr size_t k_NumTasks = 200'000;
+
+	std::vector<size_t> get_worker_counts() {
+		size_t hw = std::max(1u, std::thread::hardware_concurrency());
+
+		std::vector<size_t> result;
+
+		for (size_t n = 1; n < hw; n *= 2)
+			result.push_back(n);
+
+		result.push_back(hw);
+
+		return result;
+	}
+
+	void report(
+		const char*                        label,
+		size_t                             num_workers,
+		size_t                             num_tasks,
+		std::chrono::duration<double>      elapsed,
+		const hecate::Scheduler::Stats&    stats
+	) {
+		uint64_t attempts = 0;
+		for (const auto& w : stats.m_Workers)
+			attempts += w.m_StealAttempts;
+
+		std::printf(
+			"%-16s workers: %3zu  tasks/s: %12.0f  stolen: %5.1f%%  steal attempts: %10llu  executed externally: %llu\n",
+			label,
+			num_workers,
+			static_cast<double>(num_tasks) / elapsed.count(),
+			stats.get_steal_ratio() * 100.0,
+			static_cast<unsigned long long>(attempts),
+			static_cast<unsigned long long>(stats.m_ExecutedExternally)
+		);
+	}
+}
+
+namespace test {
+	TEST_CASE("scheduler_throughput", "[.][benchmark][hecate::core]") {
+		using clock = std::chrono::steady_clock;
+
+		for (size_t num_workers : get_worker_counts()) {
+			hecate::Scheduler s(num_workers);
+
+			// flat: everything is submitted from the main thread via the injection queue
+			{
+				s.reset_stats();
+
+				auto start = clock::now();
+				{
+					hecate::Scheduler::TaskGroup group(s);
+
+					for (size_t i = 0; i < k_NumTasks; ++i)
+						group.run([] {});
+				}
+				report("flat", num_workers, k_NumTasks, clock::now() - start, s.get_stats());
+			}
+
+			// recursive: tasks spawn tasks on the worker deques, work spreads by stealing
+			{
+				s.reset_stats();
+
+				auto start = clock::now();
+				s.parallel_for(0, k_NumTasks, [](size_t) {}, 1);
+				report("parallel_for", num_workers, k_NumTasks, clock::now() - start, s.get_stats());
+			}
+		}
+	}
+
+	TEST_CASE("scheduler_parallel_for_benchmark", "[.][benchmark][hecate::core]") {
+		hecate::Scheduler s;
+
+		std::vector<float> data(1 << 22, 1.0f);
+
+		BENCHMARK("serial transform") {
+			for (auto& x : data)
+				x = x * 1.0001f + 0.5f;
+
+			return data[0];
+		};
+
+		BENCHMARK("parallel_for transform") {
+			s.parallel_for(0, data.size(), [&data](size_t i) {
+				data[i] = data[i] * 1.0001f + 0.5f;
+			}, 4096);
+
+			return data[0];
+		};
+	}
+}
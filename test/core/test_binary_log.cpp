@@ -0,0 +1,133 @@
+#include "../unittest.h"
+
+#include "core/logger.h"
+#include "core/logger/binary_log.h"
+#include "core/logger/log_sink.h"
+#include "core/logger/rotating_log_file.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace test {
+	TEST_CASE("binary_log", "[hecate::core]") {
+		using namespace hecate::core::logger;
+
+		auto path = std::filesystem::temp_directory_path() / "hecate_test_binary_log.hcl";
+		auto& log = BinaryLog::instance();
+
+		REQUIRE(log.open(path));
+		REQUIRE(log.isOpen());
+
+		std::string name = "texture.png";
+
+		for (int i = 0; i < 3; ++i)
+			g_LogFormat(info, "Loaded {} in {:.2f} ms ({} of {})", name, 1.5 * i, i, 3u);
+
+		g_LogFormat(warning, "{{braces}} {1}-{0} {2} {3:>4}|{4:#x}", 'a', true, std::string_view("sv"), int8_t(-5), uint64_t(255));
+
+		// regular (preformatted) messages keep the time they were created at, not when they're written
+		auto created = std::chrono::time_point_cast<std::chrono::seconds>(std::chrono::system_clock::now() - std::chrono::hours(1));
+
+		log.write(
+			LogMessage::MetaInfo{ e_LogCategory::err, __FILE__, 42, created },
+			"plain text"
+		);
+
+		REQUIRE(log.getNumEvents() == 5);
+
+		log.close();
+
+		REQUIRE(!log.isOpen());
+
+		// not recorded while closed
+		g_LogFormat(debug, "not recorded {}", 1);
+
+		BinaryLogReader reader;
+		REQUIRE(reader.open(path));
+
+		LogMessage::MetaInfo     info;
+		std::string              message;
+		std::vector<std::string> messages;
+		std::vector<e_LogCategory> categories;
+
+		while (reader.next(info, message)) {
+			messages.push_back(message);
+			categories.push_back(info.m_Category);
+		}
+
+		REQUIRE(messages.size() == 5);
+		REQUIRE(reader.getNumCallsites() == 3);
+
+		for (int i = 0; i < 3; ++i) {
+			REQUIRE(messages[i] == std::format("Loaded {} in {:.2f} ms ({} of {})", name, 1.5 * i, i, 3u));
+			REQUIRE(categories[i] == e_LogCategory::info);
+		}
+
+		REQUIRE(messages[3] == std::format("{{braces}} {1}-{0} {2} {3:>4}|{4:#x}", 'a', true, std::string_view("sv"), int8_t(-5), uint64_t(255)));
+		REQUIRE(categories[3] == e_LogCategory::warning);
+
+		REQUIRE(messages[4]   == "plain text");
+		REQUIRE(categories[4] == e_LogCategory::err);
+		REQUIRE(info.m_SourceLine == 42);
+		REQUIRE(info.m_Time       == created);
+
+		std::filesystem::remove(path);
+	}
+
+	TEST_CASE("binary_log_async", "[hecate::core]") {
+		using namespace hecate::core::logger;
+
+		auto  path   = std::filesystem::temp_directory_path() / "hecate_test_binary_log_async.hcl";
+		auto& logger = hecate::Logger::instance();
+
+		// route the global logger into the binary log only, and write it from the background thread
+		logger.removeAll();
+		logger.add(makeBinaryFileSink(path));
+		logger.startAsync(64);
+
+		for (int i = 0; i < 200; ++i) {
+			g_LogFormat(info, "event {}", i);
+			g_Log << "text " << i;
+		}
+
+		logger.stopAsync();
+
+		REQUIRE(BinaryLog::instance().getNumEvents() == 400);
+
+		logger.removeAll();
+		logger.add(makeRotatingFileSink(logger.getLogFile()));
+
+		BinaryLog::instance().close();
+
+		// deferred events and regular messages share the queue, so the file is in logging order
+		BinaryLogReader reader;
+		REQUIRE(reader.open(path));
+
+		LogMessage::MetaInfo                  info;
+		std::string                           message;
+		std::chrono::system_clock::time_point previous;
+
+		for (int i = 0; i < 200; ++i) {
+			REQUIRE(reader.next(info, message));
+			REQUIRE(message == std::format("event {}", i));
+			REQUIRE(info.m_Time >= previous);
+
+			previous = info.m_Time;
+
+			REQUIRE(reader.next(info, message));
+			REQUIRE(message == std::format("text {}", i));
+			REQUIRE(info.m_Time >= previous);
+
+			previous = info.m_Time;
+		}
+
+		REQUIRE(!reader.next(info, message));
+
+		std::filesystem::remove(path);
+	}
+}
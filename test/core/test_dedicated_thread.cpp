@@ -0,0 +1,126 @@
+#include "../unittest.h"
+
+#include "core/dedicated_thread.h"
+#include "core/system.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+	class TestSystem:
+		public hecate::System
+	{
+	public:
+		TestSystem(const std::string& name, double tick_rate):
+			System(name)
+		{
+			run_on_dedicated_thread(tick_rate);
+		}
+
+		void update() override {
+			m_Updating  = true;
+			m_UpdatedOn = std::this_thread::get_id();
+
+			++m_NumUpdates;
+
+			if (m_Throw)
+				throw std::runtime_error("update failed");
+
+			m_Updating = false;
+		}
+
+		std::atomic<int>             m_NumUpdates = 0;
+		std::atomic_bool             m_Updating   = false;
+		std::atomic_bool             m_Throw      = false;
+		std::atomic<std::thread::id> m_UpdatedOn;
+	};
+
+	template <typename tPredicate>
+	bool wait_for(tPredicate pred) {
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+		while (!pred())
+			if (std::chrono::steady_clock::now() > deadline)
+				return false;
+			else
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		return true;
+	}
+}
+
+namespace test {
+	TEST_CASE("dedicated_thread_runs_off_main", "[hecate::core]") {
+		TestSystem sys("Dedicated", 1000.0);
+
+		auto thread = std::make_unique<hecate::DedicatedThread>(&sys);
+
+		REQUIRE(thread->get_system() == &sys);
+		REQUIRE(wait_for([&] { return sys.m_NumUpdates >= 3; }));
+
+		REQUIRE(sys.m_UpdatedOn.load() != std::this_thread::get_id());
+		REQUIRE(sys.m_UpdatedOn.load() == thread->get_id());
+
+		// destruction stops and joins; nothing runs afterwards
+		thread.reset();
+
+		int num_updates = sys.m_NumUpdates;
+
+		REQUIRE(!sys.m_Updating);
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+		REQUIRE(sys.m_NumUpdates == num_updates);
+	}
+
+	TEST_CASE("dedicated_thread_stop_wakes", "[hecate::core]") {
+		// one update every 100 seconds; a stop request should not have to wait for the next tick
+		TestSystem sys("Slow", 0.01);
+
+		hecate::DedicatedThread thread(&sys);
+
+		REQUIRE(wait_for([&] { return sys.m_NumUpdates == 1; }));
+
+		auto start = std::chrono::steady_clock::now();
+
+		thread.request_stop();
+		thread.join();
+
+		REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+		REQUIRE(sys.m_NumUpdates == 1);
+	}
+
+	TEST_CASE("dedicated_thread_mailbox", "[hecate::core]") {
+		TestSystem sys("Mailbox", 1000.0);
+
+		std::atomic<std::thread::id> drained_on;
+
+		hecate::DedicatedThread thread(&sys);
+
+		sys.get_mailbox().push([&] { drained_on = std::this_thread::get_id(); });
+
+		REQUIRE(wait_for([&] { return drained_on.load() != std::thread::id(); }));
+		REQUIRE(drained_on.load() == thread.get_id());
+	}
+
+	TEST_CASE("dedicated_thread_error", "[hecate::core]") {
+		TestSystem sys("Failing", 1000.0);
+
+		sys.m_Throw = true;
+
+		std::atomic_bool reported = false;
+
+		hecate::DedicatedThread thread(&sys, [&] { reported = true; });
+
+		REQUIRE(wait_for([&] { return reported.load(); }));
+
+		// the thread exits after the first failure
+		thread.join();
+
+		REQUIRE(sys.m_NumUpdates == 1);
+	}
+}
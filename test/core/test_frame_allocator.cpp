@@ -0,0 +1,59 @@
+#include "../unittest.h"
+
+#include "core/frame_allocator.h"
+#include "core/scheduler.h"
+
+#include <atomic>
+#include <memory_resource>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace test {
+	TEST_CASE("frame_allocator_per_thread", "[hecate::core]") {
+		hecate::FrameAllocator fa(1024);
+		hecate::Scheduler      s(4);
+
+		std::mutex                             mutex;
+		std::set<std::pmr::memory_resource*>   resources;
+		std::atomic<int>                       errors = 0;
+
+		s.parallel_for(0, 1000, [&](size_t i) {
+			auto* resource = fa.get_resource();
+
+			{
+				std::lock_guard guard(mutex);
+				resources.insert(resource);
+			}
+
+			// the same thread keeps getting the same arena
+			if (fa.get_resource() != resource)
+				++errors;
+
+			auto values = fa.create_array<size_t>(16);
+
+			for (auto& x : values)
+				x = i;
+
+			for (auto x : values)
+				if (x != i)
+					++errors;
+		}, 1);
+
+		REQUIRE(errors == 0);
+		REQUIRE(resources.size() == fa.get_num_arenas());
+		REQUIRE(fa.get_bytes_allocated() == 1000 * 16 * sizeof(size_t));
+
+		fa.reset();
+		REQUIRE(fa.get_bytes_allocated() == 0);
+
+		// multiple allocators on the same thread don't share arenas
+		hecate::FrameAllocator other;
+
+		auto* a = fa   .get_resource();
+		auto* b = other.get_resource();
+
+		REQUIRE(a != b);
+		REQUIRE(fa.get_resource() == a);
+	}
+}
@@ -0,0 +1,128 @@
+#include "../unittest.h"
+
+#include "core/frame_graph.h"
+#include "core/scheduler.h"
+#include "core/system.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+	struct Recorder {
+		std::atomic<int> m_Counter = 0;
+	};
+
+	class TestSystem:
+		public hecate::System
+	{
+	public:
+		TestSystem(const std::string& name, Recorder* rec):
+			System(name),
+			m_Recorder(rec)
+		{
+		}
+
+		void update() override {
+			m_UpdatedOn = std::this_thread::get_id();
+			m_Order     = m_Recorder->m_Counter++;
+		}
+
+		using System::add_dependency;
+		using System::add_read_access;
+		using System::add_write_access;
+		using System::require_main_thread;
+
+		Recorder*       m_Recorder = nullptr;
+		int             m_Order    = -1;
+		std::thread::id m_UpdatedOn;
+	};
+}
+
+namespace test {
+	TEST_CASE("frame_graph_dependencies", "[hecate::core]") {
+		hecate::Scheduler  s(2);
+		hecate::FrameGraph fg;
+		Recorder           rec;
+
+		TestSystem a("A", &rec);
+		TestSystem b("B", &rec);
+		TestSystem c("C", &rec);
+
+		b.add_dependency("A");
+		c.add_dependency("B");
+
+		fg.build({ &c, &b, &a });
+		fg.execute(s);
+
+		REQUIRE(a.m_Order == 0);
+		REQUIRE(b.m_Order == 1);
+		REQUIRE(c.m_Order == 2);
+		REQUIRE(fg.get_critical_path().size() == 3);
+	}
+
+	TEST_CASE("frame_graph_resources", "[hecate::core]") {
+		hecate::Scheduler  s(2);
+		hecate::FrameGraph fg;
+		Recorder           rec;
+
+		TestSystem writer ("Writer",  &rec);
+		TestSystem reader1("Reader1", &rec);
+		TestSystem reader2("Reader2", &rec);
+		TestSystem rewrite("Rewrite", &rec);
+
+		writer .add_write_access("buffer");
+		reader1.add_read_access ("buffer");
+		reader2.add_read_access ("buffer");
+		rewrite.add_write_access("buffer");
+
+		fg.build({ &writer, &reader1, &reader2, &rewrite });
+
+		for (int i = 0; i < 10; ++i) {
+			rec.m_Counter = 0;
+			fg.execute(s);
+
+			REQUIRE(writer.m_Order == 0);
+			REQUIRE(reader1.m_Order >= 1);
+			REQUIRE(reader2.m_Order >= 1);
+			REQUIRE(rewrite.m_Order == 3);
+		}
+	}
+
+	TEST_CASE("frame_graph_main_thread", "[hecate::core]") {
+		hecate::Scheduler  s(2);
+		hecate::FrameGraph fg;
+		Recorder           rec;
+
+		TestSystem pump ("Pump",  &rec);
+		TestSystem other("Other", &rec);
+		TestSystem app  ("App",   &rec);
+
+		pump.require_main_thread();
+
+		fg.build({ &pump, &other }, &app);
+
+		for (int i = 0; i < 10; ++i) {
+			rec.m_Counter = 0;
+			fg.execute(s);
+
+			REQUIRE(pump.m_UpdatedOn == std::this_thread::get_id());
+			REQUIRE(app .m_UpdatedOn == std::this_thread::get_id());
+			REQUIRE(app .m_Order     == 2);
+		}
+	}
+
+	TEST_CASE("frame_graph_cycle", "[hecate::core]") {
+		hecate::FrameGraph fg;
+		Recorder           rec;
+
+		TestSystem a("A", &rec);
+		TestSystem b("B", &rec);
+
+		a.add_dependency("B");
+		b.add_dependency("A");
+
+		REQUIRE_THROWS(fg.build({ &a, &b }));
+	}
+}
@@ -0,0 +1,161 @@
+#include "../unittest.h"
+
+#include "core/frame_pacer.h"
+
+#include <cmath>
+#include <cstdint>
+
+namespace {
+	// every reading advances the time a little, like a real clock would while spinning
+	struct FakeClock {
+		double   m_Time      = 0;
+		double   m_Tick      = 1e-5; // seconds per reading
+		double   m_Oversleep = 0;    // seconds added to every sleep
+		uint64_t m_NumSleeps = 0;
+
+		hecate::FramePacer::Clock get() {
+			return {
+				[this] { return m_Time += m_Tick; },
+				[this](uint64_t ms) {
+					m_Time += static_cast<double>(ms) * 0.001 + m_Oversleep;
+					++m_NumSleeps;
+				}
+			};
+		}
+
+		void work(double seconds) {
+			m_Time += seconds;
+		}
+	};
+
+	bool is_close(double a, double b, double tolerance = 0.0005) {
+		return std::abs(a - b) <= tolerance;
+	}
+}
+
+namespace test {
+	TEST_CASE("frame_pacer_variable", "[hecate::core]") {
+		FakeClock          clock;
+		hecate::FramePacer pacer(clock.get());
+
+		pacer.set_target_rate(100.0);
+		pacer.start();
+
+		SECTION("waits for the deadline") {
+			for (int i = 0; i < 10; ++i) {
+				double frame_start = clock.m_Time;
+
+				clock.work(0.002);
+
+				REQUIRE(pacer.end_frame() == 1);
+				REQUIRE(is_close(clock.m_Time - frame_start, 0.01));
+				REQUIRE(is_close(pacer.get_delta_time(), 0.01));
+			}
+
+			auto stats = pacer.get_statistics();
+
+			REQUIRE(stats.m_NumFrames       == 10);
+			REQUIRE(stats.m_MissedDeadlines == 0);
+			REQUIRE(is_close(stats.m_MeanFrameTime, 0.01));
+			REQUIRE(is_close(stats.m_MeanWorkTime,  0.002));
+			REQUIRE(clock.m_NumSleeps > 0);
+		}
+
+		SECTION("long frames are not padded") {
+			clock.work(0.015);
+
+			REQUIRE(pacer.end_frame() == 1);
+			REQUIRE(is_close(pacer.get_delta_time(), 0.015));
+			REQUIRE(pacer.get_statistics().m_MissedDeadlines == 1);
+
+			// the next frame gets a full period again instead of trying to catch up
+			double frame_start = clock.m_Time;
+
+			clock.work(0.002);
+
+			REQUIRE(pacer.end_frame() == 1);
+			REQUIRE(is_close(clock.m_Time - frame_start, 0.01));
+			REQUIRE(pacer.get_statistics().m_MissedDeadlines == 1);
+		}
+	}
+
+	TEST_CASE("frame_pacer_fixed", "[hecate::core]") {
+		FakeClock          clock;
+		hecate::FramePacer pacer(clock.get());
+
+		pacer.set_target_rate(100.0);
+		pacer.set_mode(hecate::FramePacer::e_Mode::fixed);
+		pacer.set_max_catch_up_steps(4);
+		pacer.start();
+
+		SECTION("on time") {
+			clock.work(0.002);
+
+			REQUIRE(pacer.end_frame() == 1);
+			REQUIRE(pacer.get_delta_time() == 0.01);
+		}
+
+		SECTION("catches up") {
+			clock.work(0.025); // 1.5 periods late
+
+			REQUIRE(pacer.end_frame() == 2);
+			REQUIRE(pacer.get_delta_time() == 0.01);
+
+			// back on schedule
+			clock.work(0.002);
+
+			REQUIRE(pacer.end_frame() == 1);
+		}
+
+		SECTION("drops the backlog when too far behind") {
+			clock.work(1.0);
+
+			REQUIRE(pacer.end_frame() == 4);
+
+			clock.work(0.002);
+
+			REQUIRE(pacer.end_frame() == 1);
+			REQUIRE(pacer.get_statistics().m_MissedDeadlines == 1);
+		}
+	}
+
+	TEST_CASE("frame_pacer_unlimited", "[hecate::core]") {
+		FakeClock          clock;
+		hecate::FramePacer pacer(clock.get());
+
+		pacer.set_target_rate(0);
+		pacer.start();
+
+		for (int i = 0; i < 10; ++i) {
+			clock.work(0.003);
+
+			REQUIRE(pacer.end_frame() == 1);
+			REQUIRE(is_close(pacer.get_delta_time(), 0.003));
+		}
+
+		REQUIRE(clock.m_NumSleeps == 0);
+		REQUIRE(pacer.get_statistics().m_MissedDeadlines == 0);
+	}
+
+	TEST_CASE("frame_pacer_oversleep", "[hecate::core]") {
+		FakeClock          clock;
+		hecate::FramePacer pacer(clock.get());
+
+		// every sleep takes 3 ms longer than asked for; the pacer should learn to stop sleeping earlier
+		clock.m_Oversleep = 0.003;
+
+		pacer.set_target_rate(100.0);
+		pacer.start();
+
+		for (int i = 0; i < 20; ++i) {
+			double frame_start = clock.m_Time;
+
+			clock.work(0.001);
+			pacer.end_frame();
+
+			REQUIRE(is_close(clock.m_Time - frame_start, 0.01));
+		}
+
+		REQUIRE(pacer.get_statistics().m_MissedDeadlines == 0);
+	}
+}
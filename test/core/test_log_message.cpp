@@ -0,0 +1,138 @@
+#include "../unittest.h"
+
+#include "core/logger.h"
+
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+// [NOTE] counts the allocations made by the current thread while enabled; this replaces the global
+//        operator new/delete for the entire unittest executable
+namespace {
+	thread_local bool   t_CountAllocations = false;
+	thread_local size_t t_NumAllocations   = 0;
+}
+
+void* operator new(std::size_t size) {
+	if (t_CountAllocations)
+		++t_NumAllocations;
+
+	if (void* ptr = std::malloc(size ? size : 1))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	if (t_CountAllocations)
+		++t_NumAllocations;
+
+	return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+namespace test {
+	namespace {
+		using e_LogCategory = hecate::Logger::e_LogCategory;
+
+		struct LastLine {
+			void operator()(
+				const hecate::core::logger::LogMessage::MetaInfo&,
+				std::string_view message
+			) {
+				m_Text->assign(message);
+			}
+
+			std::string* m_Text;
+		};
+
+		struct Streamable {
+			int m_Value;
+		};
+
+		std::ostream& operator << (std::ostream& os, const Streamable& s) {
+			return os << "<" << s.m_Value << ">";
+		}
+
+		size_t count_allocations(hecate::Logger& logger) {
+			t_NumAllocations   = 0;
+			t_CountAllocations = true;
+
+			logger(e_LogCategory::info, __FILE__, __LINE__) << "Frame " << 42 << " took " << 16.6667 << " ms, " << Streamable{ 7 } << ' ' << true;
+
+			t_CountAllocations = false;
+
+			return t_NumAllocations;
+		}
+	}
+
+	TEST_CASE("log_message_text", "[hecate::core]") {
+		std::string text;
+
+		hecate::Logger logger;
+		logger.add(LastLine{ &text });
+
+		// the same output as std::ostream
+		logger(e_LogCategory::info, __FILE__, __LINE__) << "a" << 1 << ' ' << -2.5 << ' ' << 1.0 / 3.0 << ' ' << 1e20 << ' ' << false << ' ' << 'c' << ' ' << Streamable{ 3 } << std::string(" s");
+
+		std::stringstream expected;
+		expected << "a" << 1 << ' ' << -2.5 << ' ' << 1.0 / 3.0 << ' ' << 1e20 << ' ' << false << ' ' << 'c' << ' ' << "<3>" << std::string(" s");
+
+		REQUIRE(text == expected.str());
+
+		// manipulators
+		logger(e_LogCategory::info, __FILE__, __LINE__) << std::boolalpha << true << std::hex << ' ' << 255 << std::endl;
+		REQUIRE(text == "true ff\n");
+
+		// messages that don't fit the inline buffer
+		std::string long_text(hecate::core::logger::LogMessage::k_InlineCapacity * 3, 'x');
+
+		logger(e_LogCategory::info, __FILE__, __LINE__) << "long " << long_text << " " << 123;
+		REQUIRE(text == "long " + long_text + " 123");
+	}
+
+	TEST_CASE("log_message_allocations", "[hecate::core]") {
+		std::string text;
+		text.reserve(1024);
+
+		hecate::Logger logger;
+		logger.add(LastLine{ &text });
+
+		// the counter itself
+		t_NumAllocations   = 0;
+		t_CountAllocations = true;
+		auto heap          = std::make_unique<std::string>(1024, 'x');
+		t_CountAllocations = false;
+
+		REQUIRE(t_NumAllocations > 0);
+
+		// warm up (metrics, the per-thread stream, the slots in the staging queue)
+		for (size_t i = 0; i < hecate::Logger::k_StagingSize; ++i)
+			count_allocations(logger);
+
+		REQUIRE(count_allocations(logger) == 0);
+		REQUIRE(text == "Frame 42 took 16.6667 ms, <7> 1");
+
+		// asynchronous, once every slot in the ring was used
+		logger.startAsync(16);
+
+		for (int i = 0; i < 64; ++i)
+			count_allocations(logger);
+
+		logger.sync();
+
+		REQUIRE(count_allocations(logger) == 0);
+
+		logger.stopAsync();
+	}
+}
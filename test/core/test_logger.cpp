@@ -0,0 +1,418 @@
+#include "../unittest.h"
+
+#include "core/logger.h"
+#include "core/logger/rotating_log_file.h"
+
+#include <atomic>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace test {
+	namespace {
+		using e_LogCategory = hecate::Logger::e_LogCategory;
+		using e_LogOverflow = hecate::Logger::e_LogOverflow;
+
+		struct CapturedLines {
+			std::mutex               m_Mutex;
+			std::vector<std::string> m_Lines;
+			std::atomic_bool         m_Blocked    = false; // holds up the writer thread while set
+			std::atomic<int>         m_NumCalls   = 0;
+			std::atomic<int>         m_NumFlushes = 0;
+		};
+
+		struct CaptureSink {
+			void operator()(
+				const hecate::core::logger::LogMessage::MetaInfo&,
+				const std::string& message
+			) {
+				++m_Captured->m_NumCalls;
+
+				while (m_Captured->m_Blocked)
+					std::this_thread::yield();
+
+				std::lock_guard guard(m_Captured->m_Mutex);
+				m_Captured->m_Lines.push_back(message);
+			}
+
+			void flush() {
+				++m_Captured->m_NumFlushes;
+			}
+
+			CapturedLines* m_Captured;
+		};
+
+		struct SharedSinkState {
+			std::atomic_bool m_Busy        = false;
+			std::atomic<int> m_NumOverlaps  = 0; // sinks that were called while another one was busy
+			std::atomic<int> m_NumReordered = 0;
+			std::atomic<int> m_NumLines     = 0;
+		};
+
+		// checks that sinks are never called concurrently, and that lines from a single thread stay in order
+		struct ExclusiveSink {
+			void operator()(
+				const hecate::core::logger::LogMessage::MetaInfo&,
+				std::string_view message
+			) {
+				if (m_Shared->m_Busy.exchange(true))
+					++m_Shared->m_NumOverlaps;
+
+				auto separator = message.find(':');
+				int  thread    = 0;
+				int  index     = 0;
+
+				std::from_chars(message.data(),                 message.data() + separator,      thread);
+				std::from_chars(message.data() + separator + 1, message.data() + message.size(), index);
+
+				if (m_Last.size() <= static_cast<size_t>(thread))
+					m_Last.resize(thread + 1, -1);
+
+				if (index <= m_Last[thread])
+					++m_Shared->m_NumReordered;
+
+				m_Last[thread] = index;
+
+				++m_Shared->m_NumLines;
+				m_Shared->m_Busy = false;
+			}
+
+			SharedSinkState* m_Shared;
+			std::vector<int> m_Last; // per thread
+		};
+
+		void log_line(hecate::Logger& logger, const std::string& message) {
+			logger(e_LogCategory::info, __FILE__, __LINE__) << message;
+		}
+
+		// logs every line it receives once more, through the logger that is calling it
+		struct EchoSink {
+			void operator()(
+				const hecate::core::logger::LogMessage::MetaInfo& info,
+				const std::string& message
+			) {
+				if (!message.starts_with("echo "))
+					log_line(*m_Logger, "echo " + message);
+
+				m_Captured(info, message);
+			}
+
+			hecate::Logger* m_Logger;
+			CaptureSink     m_Captured;
+		};
+	}
+
+	TEST_CASE("logger_async_order", "[hecate::core]") {
+		CapturedLines captured;
+
+		hecate::Logger logger;
+		logger.add(CaptureSink{ &captured });
+		logger.startAsync(64);
+
+		REQUIRE(logger.isAsync());
+
+		constexpr int k_NumThreads = 4;
+		constexpr int k_NumLines   = 1000;
+
+		{
+			std::vector<std::jthread> threads;
+
+			for (int t = 0; t < k_NumThreads; ++t)
+				threads.emplace_back([&logger, t] {
+					for (int i = 0; i < k_NumLines; ++i)
+						log_line(logger, std::to_string(t) + ":" + std::to_string(i));
+				});
+		}
+
+		logger.sync();
+
+		REQUIRE(captured.m_Lines.size() == k_NumThreads * k_NumLines);
+		REQUIRE(captured.m_NumFlushes > 0);
+		REQUIRE(logger.getNumDropped() == 0);
+
+		// lines from a single thread should arrive in order
+		std::vector<int> next(k_NumThreads, 0);
+
+		for (const auto& line : captured.m_Lines) {
+			auto separator = line.find(':');
+			int  thread    = std::stoi(line.substr(0, separator));
+			int  index     = std::stoi(line.substr(separator + 1));
+
+			REQUIRE(index == next[thread]++);
+		}
+
+		// after stopping, lines are written immediately again
+		logger.stopAsync();
+
+		REQUIRE(!logger.isAsync());
+
+		log_line(logger, "sync");
+		REQUIRE(captured.m_Lines.back() == "sync");
+	}
+
+	TEST_CASE("logger_async_overflow", "[hecate::core]") {
+		constexpr int k_NumLines = 100;
+
+		auto run = [](e_LogOverflow overflow, CapturedLines& captured) {
+			hecate::Logger logger;
+			logger.add(CaptureSink{ &captured });
+			logger.startAsync(4, overflow);
+
+			captured.m_Blocked = true;
+
+			// once the writer thread picked this up, it's stuck in the sink
+			log_line(logger, "first");
+
+			while (captured.m_NumCalls == 0)
+				std::this_thread::yield();
+
+			std::jthread producer([&] {
+				for (int i = 0; i < k_NumLines; ++i)
+					log_line(logger, std::to_string(i));
+			});
+
+			if (overflow != e_LogOverflow::block)
+				producer.join(); // should not have to wait for the writer
+
+			captured.m_Blocked = false;
+
+			if (producer.joinable())
+				producer.join();
+
+			uint64_t num_dropped = logger.getNumDropped();
+
+			logger.stopAsync(); // writes whatever is left
+
+			REQUIRE(captured.m_Lines.size() + num_dropped == k_NumLines + 1);
+
+			return num_dropped;
+		};
+
+		SECTION("block") {
+			CapturedLines captured;
+
+			REQUIRE(run(e_LogOverflow::block, captured) == 0);
+			REQUIRE(captured.m_Lines.back() == std::to_string(k_NumLines - 1));
+		}
+
+		SECTION("drop") {
+			CapturedLines captured;
+
+			REQUIRE(run(e_LogOverflow::drop, captured) > 0);
+			REQUIRE(captured.m_Lines.front() == "first");
+			REQUIRE(captured.m_Lines.back() != std::to_string(k_NumLines - 1)); // the newest lines were discarded
+		}
+
+		SECTION("drop_oldest") {
+			CapturedLines captured;
+
+			REQUIRE(run(e_LogOverflow::drop_oldest, captured) > 0);
+			REQUIRE(captured.m_Lines.back() == std::to_string(k_NumLines - 1)); // the newest lines were kept
+		}
+	}
+
+	TEST_CASE("logger_async_sink_logs", "[hecate::core]") {
+		constexpr int k_NumLines = 100;
+
+		CapturedLines captured;
+
+		{
+			hecate::Logger logger;
+			logger.add(EchoSink{ &logger, CaptureSink{ &captured } });
+			logger.startAsync(4, e_LogOverflow::block);
+
+			captured.m_Blocked = true;
+
+			log_line(logger, "first");
+
+			while (captured.m_NumCalls == 0)
+				std::this_thread::yield();
+
+			// keeps the ring full while the writer thread logs from the sink
+			std::jthread producer([&] {
+				for (int i = 0; i < k_NumLines; ++i)
+					log_line(logger, std::to_string(i));
+			});
+
+			captured.m_Blocked = false;
+
+			producer.join();
+			logger.sync();
+
+			REQUIRE(captured.m_Lines.size() == 2 * (k_NumLines + 1));
+			REQUIRE(logger.getNumDropped() == 0);
+		}
+
+		REQUIRE(captured.m_Lines.front() == "first");
+		REQUIRE(captured.m_Lines.back()  == "echo " + std::to_string(k_NumLines - 1));
+	}
+
+	TEST_CASE("logger_async_fatal", "[hecate::core]") {
+		CapturedLines captured;
+
+		hecate::Logger logger;
+		logger.add(CaptureSink{ &captured });
+		logger.startAsync();
+
+		// fatal messages are written before the logging thread continues
+		logger(e_LogCategory::fatal, __FILE__, __LINE__) << "fatal";
+
+		std::lock_guard guard(captured.m_Mutex);
+		REQUIRE(captured.m_Lines.size() == 1);
+	}
+
+	TEST_CASE("logger_file", "[hecate::core]") {
+		namespace fs = std::filesystem;
+
+		auto directory = fs::temp_directory_path() / "hecate_test_logger_file";
+
+		fs::remove_all(directory);
+		fs::create_directories(directory);
+
+		auto path = directory / "hecate.log";
+
+		{
+			std::ofstream out(path, std::ios::binary);
+			out << "previous run\n";
+		}
+
+		// the way the global logger is set up; the previous log is continued, not truncated
+		{
+			hecate::Logger logger(path.string());
+
+			REQUIRE(logger.getLogFile());
+			REQUIRE(logger.getLogFile()->get_config().m_Path == path);
+
+			log_line(logger, "this run");
+
+			// reconfiguring doesn't replace the sink
+			auto config = logger.getLogFile()->get_config();
+			config.m_MaxFiles = 1;
+			logger.getLogFile()->configure(config);
+
+			REQUIRE(logger.getNumSinks() == 1);
+
+			log_line(logger, "after configure");
+		}
+
+		std::ifstream in(path, std::ios::binary);
+		std::string   text(std::istreambuf_iterator<char>(in), {});
+
+		REQUIRE(text.starts_with("previous run\n"));
+		REQUIRE(text.find("this run")        != std::string::npos);
+		REQUIRE(text.find("after configure") != std::string::npos);
+
+		in.close();
+		fs::remove_all(directory);
+	}
+
+	TEST_CASE("logger_min_category", "[hecate::core]") {
+		int num_evaluated = 0;
+
+		auto evaluate = [&num_evaluated] {
+			return ++num_evaluated;
+		};
+
+		auto previous = hecate::Logger::getMinCategory();
+
+		hecate::Logger::setMinCategory(e_LogCategory::warning);
+
+		REQUIRE(!hecate::Logger::isEnabled(e_LogCategory::debug));
+		REQUIRE(!hecate::Logger::isEnabled(e_LogCategory::info));
+		REQUIRE( hecate::Logger::isEnabled(e_LogCategory::warning));
+		REQUIRE( hecate::Logger::isEnabled(e_LogCategory::err));
+
+		// disabled categories don't evaluate their arguments
+		g_LogDebug << "skipped " << evaluate();
+		g_Log      << "skipped " << evaluate();
+
+		REQUIRE(num_evaluated == 0);
+
+		// the macros are single statements, even without braces
+		if (num_evaluated == 0)
+			g_LogDebug << evaluate();
+		else
+			evaluate();
+
+		REQUIRE(num_evaluated == 0);
+
+		hecate::Logger::setMinCategory(e_LogCategory::debug);
+
+		g_LogDebug << "logger_min_category " << evaluate();
+
+		REQUIRE(num_evaluated == (HECATE_LOG_MIN_CATEGORY == 0 ? 1 : 0));
+
+		hecate::Logger::setMinCategory(previous);
+	}
+
+	TEST_CASE("logger_threads", "[hecate::core]") {
+		constexpr int k_NumThreads = 8;
+		constexpr int k_NumLines   = 2000;
+
+		auto log_from_threads = [](hecate::Logger& logger) {
+			std::vector<std::jthread> threads;
+
+			for (int t = 0; t < k_NumThreads; ++t)
+				threads.emplace_back([&logger, t] {
+					for (int i = 0; i < k_NumLines; ++i)
+						logger(e_LogCategory::info, __FILE__, __LINE__) << t << ':' << i;
+				});
+		};
+
+		auto run = [&](hecate::Logger& logger) {
+			SharedSinkState shared;
+
+			// while sinks are being added and removed
+			{
+				std::atomic_bool done = false;
+
+				std::jthread registration([&] {
+					while (!done) {
+						logger.add(ExclusiveSink{ &shared });
+						logger.add(ExclusiveSink{ &shared });
+						logger.getNumSinks();
+						logger.removeAll();
+					}
+				});
+
+				log_from_threads(logger);
+
+				done = true;
+			}
+
+			logger.sync();
+
+			REQUIRE(shared.m_NumOverlaps  == 0);
+			REQUIRE(shared.m_NumReordered == 0);
+
+			// every line arrives exactly once
+			shared.m_NumLines = 0;
+
+			logger.add(ExclusiveSink{ &shared });
+
+			log_from_threads(logger);
+
+			logger.sync();
+
+			REQUIRE(shared.m_NumLines     == k_NumThreads * k_NumLines);
+			REQUIRE(shared.m_NumOverlaps  == 0);
+			REQUIRE(shared.m_NumReordered == 0);
+		};
+
+		SECTION("sync") {
+			hecate::Logger logger;
+			run(logger);
+		}
+
+		SECTION("async") {
+			hecate::Logger logger;
+			logger.startAsync(64);
+			run(logger);
+		}
+	}
+}
@@ -0,0 +1,459 @@
+#include "../unittest.h"
+
+#include "core/mediator.h"
+#include "core/metrics.h"
+#include "core/scheduler.h"
+#include "util/type_name.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace test {
+	namespace {
+		struct LatestMsg     { int m_Value = 0; };
+		struct AccumulateMsg { int m_Last = 0; int m_Sum = 0; };
+		struct BoundedMsg    { int m_Value = 0; };
+
+		// without a default constructor
+		struct BoundedHandle {
+			explicit BoundedHandle(int value): m_Value(value) {}
+			int m_Value;
+		};
+	}
+}
+
+namespace hecate {
+	template <>
+	struct DeliveryPolicy<test::LatestMsg> {
+		static constexpr e_Delivery k_Delivery = e_Delivery::latest;
+	};
+
+	template <>
+	struct DeliveryPolicy<test::AccumulateMsg> {
+		static constexpr e_Delivery k_Delivery = e_Delivery::accumulate;
+
+		static void accumulate(test::AccumulateMsg& pending, const test::AccumulateMsg& message) {
+			pending.m_Last  = message.m_Last;
+			pending.m_Sum  += message.m_Sum;
+		}
+	};
+
+	template <>
+	struct DeliveryPolicy<test::BoundedMsg> {
+		static constexpr e_Delivery k_Delivery = e_Delivery::bounded;
+		static constexpr size_t     k_Capacity = 4;
+	};
+
+	template <>
+	struct DeliveryPolicy<test::BoundedHandle> {
+		static constexpr e_Delivery k_Delivery = e_Delivery::bounded;
+		static constexpr size_t     k_Capacity = 2;
+	};
+}
+
+namespace test {
+	namespace {
+		template <typename T>
+		struct Collector {
+			void operator()(const T& message) {
+				m_Received.push_back(message);
+			}
+
+			std::vector<T> m_Received;
+		};
+
+		struct Ping {
+			int m_Value = 0;
+		};
+
+		struct Posted {
+			int m_Value = 0;
+		};
+
+		struct PostedHandle {
+			explicit PostedHandle(int value): m_Value(value) {}
+			int m_Value;
+		};
+
+		struct Counter {
+			void operator()(const Ping& p) {
+				m_Total += p.m_Value;
+			}
+
+			std::atomic<int> m_Total = 0;
+		};
+
+		struct Routed {
+			int m_Value = 0;
+		};
+
+		struct ThreadRecorder {
+			void operator()(const Routed& r) {
+				m_Thread = std::this_thread::get_id();
+				m_Total += r.m_Value; // publishes m_Thread
+			}
+
+			std::atomic<int> m_Total = 0;
+			std::thread::id  m_Thread;
+		};
+
+		struct Slow {
+			int m_Value = 0;
+		};
+
+		struct SlowHandler {
+			void operator()(const Slow&) {
+				m_Running = true;
+				std::this_thread::sleep_for(std::chrono::milliseconds(50));
+				m_Running = false;
+
+				++m_Calls;
+
+				if (m_DetachSelf) {
+					hecate::detach_handler<Slow>(this); // shouldn't wait for itself
+					m_Detached = true;
+				}
+			}
+
+			std::atomic_bool m_Running    = false;
+			std::atomic_bool m_Detached   = false;
+			std::atomic<int> m_Calls      = 0;
+			bool             m_DetachSelf = false;
+		};
+
+		struct Faulty {
+			int m_Value = 0;
+		};
+
+		struct Thrower {
+			void operator()(const Faulty&) {
+				++m_Calls;
+				throw std::runtime_error("handler failure");
+			}
+
+			int m_Calls = 0;
+		};
+
+		struct PostedCounter {
+			void operator()(const Posted& p) {
+				m_Total += p.m_Value;
+				++m_Calls;
+
+				// this one should not be delivered during the current dispatch
+				if (m_Repost)
+					hecate::post(Posted{ 0 });
+			}
+
+			int  m_Total  = 0;
+			int  m_Calls  = 0;
+			bool m_Repost = false;
+		};
+
+		// detaches itself the first time it is called
+		struct OneShot {
+			void operator()(const Ping&) {
+				++m_Calls;
+				hecate::detach_handler<Ping>(this);
+
+				if (m_Nested)
+					hecate::broadcast(Ping{ 100 });
+			}
+
+			int  m_Calls  = 0;
+			bool m_Nested = false;
+		};
+	}
+
+	TEST_CASE("mediator_broadcast", "[hecate::core]") {
+		Counter a;
+		Counter b;
+
+		hecate::attach_handler<Ping>(&a);
+		hecate::attach_handler<Ping>(&b);
+
+		hecate::broadcast(Ping{ 1 });
+		REQUIRE(a.m_Total == 1);
+		REQUIRE(b.m_Total == 1);
+
+		hecate::detach_handler<Ping>(&a);
+
+		hecate::broadcast(Ping{ 2 });
+		REQUIRE(a.m_Total == 1);
+		REQUIRE(b.m_Total == 3);
+
+		hecate::detach_handler<Ping>(&b);
+	}
+
+	TEST_CASE("mediator_detach_during_broadcast", "[hecate::core]") {
+		Counter before;
+		OneShot once;
+		Counter after;
+
+		hecate::attach_handler<Ping>(&before);
+		hecate::attach_handler<Ping>(&once);
+		hecate::attach_handler<Ping>(&after);
+
+		// the handler list for the broadcast in progress is not affected by the detach
+		hecate::broadcast(Ping{ 1 });
+		REQUIRE(once.m_Calls    == 1);
+		REQUIRE(before.m_Total  == 1);
+		REQUIRE(after.m_Total   == 1);
+
+		hecate::broadcast(Ping{ 1 });
+		REQUIRE(once.m_Calls    == 1);
+		REQUIRE(after.m_Total   == 2);
+
+		// a nested broadcast sees the new list, while the outer one keeps iterating the old one
+		OneShot nested;
+		nested.m_Nested = true;
+
+		hecate::attach_handler<Ping>(&nested);
+		hecate::broadcast(Ping{ 1 });
+
+		REQUIRE(nested.m_Calls == 1);
+		REQUIRE(before.m_Total == 3 + 100);
+		REQUIRE(after.m_Total  == 3 + 100);
+
+		hecate::detach_handler<Ping>(&before);
+		hecate::detach_handler<Ping>(&after);
+	}
+
+	TEST_CASE("mediator_concurrent_broadcast", "[hecate::core]") {
+		Counter c;
+		hecate::attach_handler<Ping>(&c);
+
+		{
+			hecate::Scheduler s(4);
+
+			s.parallel_for(0, 10000, [](size_t) {
+				hecate::broadcast(Ping{ 1 });
+			});
+		}
+
+		REQUIRE(c.m_Total == 10000);
+
+		hecate::detach_handler<Ping>(&c);
+	}
+
+	TEST_CASE("mediator_post", "[hecate::core]") {
+		PostedCounter c;
+		hecate::attach_handler<Posted>(&c);
+
+		{
+			hecate::Scheduler s(4);
+
+			s.parallel_for(0, 1000, [](size_t) {
+				hecate::post(Posted{ 1 });
+			});
+		}
+
+		// nothing is delivered until the queue is dispatched
+		REQUIRE(c.m_Calls == 0);
+
+		c.m_Repost = true;
+		hecate::dispatch_posted_messages();
+
+		REQUIRE(c.m_Calls == 1000);
+		REQUIRE(c.m_Total == 1000);
+
+		c.m_Repost = false;
+		hecate::dispatch_posted_messages();
+
+		REQUIRE(c.m_Calls == 2000);
+
+		hecate::dispatch_posted_messages();
+
+		REQUIRE(c.m_Calls == 2000);
+
+		hecate::detach_handler<Posted>(&c);
+	}
+
+	TEST_CASE("mediator_post_no_default_constructor", "[hecate::core]") {
+		Collector<PostedHandle>  posted;
+		Collector<BoundedHandle> bounded;
+
+		hecate::attach_handler<PostedHandle> (&posted);
+		hecate::attach_handler<BoundedHandle>(&bounded);
+
+		for (int i = 1; i <= 100; ++i) {
+			hecate::post(PostedHandle{ i });
+			hecate::broadcast(BoundedHandle{ i });
+		}
+
+		hecate::dispatch_posted_messages();
+
+		REQUIRE(posted.m_Received.size() == 100);
+		REQUIRE(posted.m_Received.back().m_Value == 100);
+
+		REQUIRE(bounded.m_Received.size() == 2);
+		REQUIRE(bounded.m_Received[0].m_Value == 99);
+		REQUIRE(bounded.m_Received[1].m_Value == 100);
+
+		// the dropped messages are counted under the readable type name
+		const auto name = "messages.dropped." + hecate::util::get_type_name<BoundedHandle>();
+
+		uint64_t num_dropped = 0;
+
+		for (const auto& v : hecate::Metrics::instance().take_snapshot().m_Values)
+			if (v.m_Name == name)
+				num_dropped = v.m_Counter;
+
+		REQUIRE(name.find("test::") != std::string::npos);
+		REQUIRE(num_dropped >= 98);
+
+		hecate::detach_handler<PostedHandle> (&posted);
+		hecate::detach_handler<BoundedHandle>(&bounded);
+	}
+
+	TEST_CASE("mediator_executor_mailbox", "[hecate::core]") {
+		hecate::Mailbox mailbox;
+		ThreadRecorder  rec;
+
+		hecate::attach_handler<Routed>(&rec, hecate::Executor::on(mailbox));
+
+		{
+			hecate::Scheduler s(4);
+
+			s.parallel_for(0, 100, [](size_t) {
+				hecate::broadcast(Routed{ 1 });
+			});
+		}
+
+		// nothing is delivered until the owner drains the mailbox, on its own thread
+		REQUIRE(rec.m_Total == 0);
+		REQUIRE(mailbox.drain() == 100);
+		REQUIRE(rec.m_Total == 100);
+		REQUIRE(rec.m_Thread == std::this_thread::get_id());
+
+		// pending deliveries are dropped once the handler is detached
+		hecate::broadcast(Routed{ 1 });
+		hecate::detach_handler<Routed>(&rec);
+
+		mailbox.drain();
+		REQUIRE(rec.m_Total == 100);
+	}
+
+	TEST_CASE("mediator_executor_scheduler", "[hecate::core]") {
+		hecate::Scheduler s(2);
+		ThreadRecorder    rec;
+
+		hecate::attach_handler<Routed>(&rec, hecate::Executor::on(s));
+		hecate::broadcast(Routed{ 1 });
+
+		while (rec.m_Total == 0)
+			std::this_thread::yield();
+
+		REQUIRE(rec.m_Thread != std::this_thread::get_id());
+
+		hecate::detach_handler<Routed>(&rec);
+	}
+
+	TEST_CASE("mediator_executor_detach", "[hecate::core]") {
+		hecate::Scheduler s(2);
+
+		SECTION("waits for a running delivery") {
+			SlowHandler handler;
+
+			hecate::attach_handler<Slow>(&handler, hecate::Executor::on(s));
+			hecate::broadcast(Slow{});
+
+			while (!handler.m_Running)
+				std::this_thread::yield();
+
+			hecate::detach_handler<Slow>(&handler);
+
+			// so the handler could be destroyed at this point
+			REQUIRE(!handler.m_Running);
+			REQUIRE(handler.m_Calls == 1);
+		}
+
+		SECTION("from the delivery itself") {
+			SlowHandler handler;
+			handler.m_DetachSelf = true;
+
+			hecate::attach_handler<Slow>(&handler, hecate::Executor::on(s));
+			hecate::broadcast(Slow{});
+
+			while (!handler.m_Detached)
+				std::this_thread::yield();
+
+			REQUIRE(handler.m_Calls == 1);
+			REQUIRE(hecate::core::detail::MediatorQueue<Slow>::instance().get_num_handlers() == 0);
+		}
+	}
+
+	TEST_CASE("mediator_exception_policy", "[hecate::core]") {
+		Thrower first;
+		Thrower second;
+
+		hecate::attach_handler<Faulty>(&first);
+		hecate::attach_handler<Faulty>(&second);
+
+		// by default, exceptions propagate and the remaining handlers are skipped
+		REQUIRE_THROWS_AS(hecate::broadcast(Faulty{}), std::runtime_error);
+		REQUIRE(first.m_Calls  == 1);
+		REQUIRE(second.m_Calls == 0);
+
+		hecate::detach_all_handlers<Faulty>();
+
+		hecate::attach_handler<Faulty>(&first,  hecate::Executor::immediate(), hecate::e_HandlerExceptions::trap);
+		hecate::attach_handler<Faulty>(&second, hecate::Executor::immediate(), hecate::e_HandlerExceptions::trap);
+
+		REQUIRE_NOTHROW(hecate::broadcast(Faulty{}));
+		REQUIRE(first.m_Calls  == 2);
+		REQUIRE(second.m_Calls == 1);
+
+		hecate::detach_all_handlers<Faulty>();
+	}
+
+	TEST_CASE("mediator_delivery_policies", "[hecate::core]") {
+		Collector<LatestMsg>     latest;
+		Collector<AccumulateMsg> accumulated;
+		Collector<BoundedMsg>    bounded;
+
+		hecate::attach_handler<LatestMsg>    (&latest);
+		hecate::attach_handler<AccumulateMsg>(&accumulated);
+		hecate::attach_handler<BoundedMsg>   (&bounded);
+
+		for (int i = 1; i <= 10; ++i) {
+			hecate::broadcast(LatestMsg{ i });
+			hecate::broadcast(AccumulateMsg{ i, i });
+			hecate::broadcast(BoundedMsg{ i });
+		}
+
+		// nothing is delivered until the next dispatch
+		REQUIRE(latest.m_Received.empty());
+		REQUIRE(accumulated.m_Received.empty());
+		REQUIRE(bounded.m_Received.empty());
+
+		hecate::dispatch_posted_messages();
+
+		REQUIRE(latest.m_Received.size() == 1);
+		REQUIRE(latest.m_Received[0].m_Value == 10);
+
+		REQUIRE(accumulated.m_Received.size() == 1);
+		REQUIRE(accumulated.m_Received[0].m_Last == 10);
+		REQUIRE(accumulated.m_Received[0].m_Sum  == 55);
+
+		// the oldest ones are dropped
+		REQUIRE(bounded.m_Received.size() == 4);
+		REQUIRE(bounded.m_Received[0].m_Value == 7);
+		REQUIRE(bounded.m_Received[3].m_Value == 10);
+
+		// and the next frame starts empty
+		hecate::dispatch_posted_messages();
+
+		REQUIRE(latest.m_Received.size()      == 1);
+		REQUIRE(accumulated.m_Received.size() == 1);
+		REQUIRE(bounded.m_Received.size()     == 4);
+
+		hecate::detach_handler<LatestMsg>    (&latest);
+		hecate::detach_handler<AccumulateMsg>(&accumulated);
+		hecate::detach_handler<BoundedMsg>   (&bounded);
+	}
+}
@@ -0,0 +1,228 @@
+#include "../unittest.h"
+
+#include "core/mediator.h"
+#include "core/message_stats.h"
+
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#if HECATE_MESSAGE_STATS
+
+namespace test {
+	namespace {
+		struct StatsMsg {
+			int m_Value;
+		};
+
+		struct FastStatsHandler {
+			void operator()(const StatsMsg&) {
+				++m_Count;
+			}
+
+			int m_Count = 0;
+		};
+
+		struct SlowStatsHandler {
+			void operator()(const StatsMsg&) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			}
+		};
+
+		struct ThrowingStatsHandler {
+			void operator()(const StatsMsg& msg) {
+				if (msg.m_Value < 0)
+					throw std::runtime_error("negative");
+			}
+		};
+
+		struct KeyedMsg {
+			int m_Key;
+		};
+
+		struct KeyedHandler {
+			void operator()(const KeyedMsg& msg) {
+				if (m_Throw)
+					throw std::runtime_error("topic");
+
+				++m_Count;
+				(void)msg;
+			}
+
+			int  m_Count = 0;
+			bool m_Throw = false;
+		};
+
+		struct DynamicMsg {
+			int m_Value;
+		};
+
+		// both attach themselves as a MessageHandler<DynamicMsg>*
+		class QuickDynamicHandler:
+			public hecate::MessageHandler<DynamicMsg>
+		{
+		public:
+			void operator()(const DynamicMsg&) override {
+			}
+		};
+
+		class SlowDynamicHandler:
+			public hecate::MessageHandler<DynamicMsg>
+		{
+		public:
+			void operator()(const DynamicMsg&) override {
+				std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			}
+		};
+
+		hecate::MessageStatistics find_stats(const std::string& name) {
+			for (auto& stats : hecate::get_message_statistics())
+				if (stats.m_Message.find(name) != std::string::npos)
+					return stats;
+
+			return {};
+		}
+	}
+
+	TEST_CASE("message_stats", "[hecate::core]") {
+		FastStatsHandler     fast;
+		SlowStatsHandler     slow;
+		ThrowingStatsHandler trapped;
+
+		hecate::set_handler_timing(true);
+
+		hecate::attach_handler<StatsMsg>(&fast);
+		hecate::attach_handler<StatsMsg>(&slow);
+		hecate::attach_handler<StatsMsg>(&trapped, hecate::Executor::immediate(), hecate::e_HandlerExceptions::trap);
+
+		hecate::broadcast(StatsMsg{ 1 });
+		hecate::broadcast(StatsMsg{ -1 }); // trapped
+
+		auto stats = find_stats("StatsMsg");
+
+		REQUIRE(stats.m_Broadcasts   == 2);
+		REQUIRE(stats.m_HandlerCalls == 6);
+		REQUIRE(stats.m_Exceptions   == 1);
+		REQUIRE(stats.m_Handlers.size() == 3);
+
+		// the slow handler should be listed first
+		REQUIRE(stats.m_Handlers.front().m_Handler.find("SlowStatsHandler") != std::string::npos);
+		REQUIRE(stats.m_Handlers.front().m_Latency.m_Count == 2);
+		REQUIRE(stats.m_Handlers.front().m_Latency.m_Sum   >= 4'000'000);
+
+		// propagated exceptions are counted as well
+		hecate::detach_handler<StatsMsg>(&trapped);
+		hecate::attach_handler<StatsMsg>(&trapped);
+
+		REQUIRE_THROWS_AS(hecate::broadcast(StatsMsg{ -1 }), std::runtime_error);
+		REQUIRE(find_stats("StatsMsg").m_Exceptions == 2);
+
+		// without timing only the counters are updated
+		hecate::set_handler_timing(false);
+		hecate::broadcast(StatsMsg{ 1 });
+
+		stats = find_stats("StatsMsg");
+
+		REQUIRE(stats.m_Broadcasts == 4);
+		REQUIRE(fast.m_Count       == 4);
+
+		for (const auto& h : stats.m_Handlers)
+			if (h.m_Handler.find("FastStatsHandler") != std::string::npos)
+				REQUIRE(h.m_Latency.m_Count == 3);
+
+		std::stringstream sstr;
+		hecate::write_message_statistics(sstr);
+
+		REQUIRE(sstr.str().find("SlowStatsHandler") != std::string::npos);
+
+		hecate::detach_all_handlers<StatsMsg>();
+	}
+
+	TEST_CASE("message_stats_dynamic_handlers", "[hecate::core]") {
+		hecate::set_handler_timing(true);
+
+		{
+			QuickDynamicHandler quick;
+			SlowDynamicHandler  slow;
+
+			hecate::broadcast(DynamicMsg{ 1 });
+			hecate::broadcast(DynamicMsg{ 2 });
+		}
+
+		hecate::set_handler_timing(false);
+
+		// one histogram per derived type, not a single one for MessageHandler<DynamicMsg>
+		auto stats = find_stats("DynamicMsg");
+
+		REQUIRE(stats.m_HandlerCalls    == 4);
+		REQUIRE(stats.m_Handlers.size() == 2);
+
+		REQUIRE(stats.m_Handlers[0].m_Handler.find("SlowDynamicHandler")  != std::string::npos);
+		REQUIRE(stats.m_Handlers[1].m_Handler.find("QuickDynamicHandler") != std::string::npos);
+
+		for (const auto& h : stats.m_Handlers) {
+			REQUIRE(h.m_Handler.find("MessageHandler") == std::string::npos);
+			REQUIRE(h.m_Latency.m_Count == 2);
+		}
+
+		REQUIRE(stats.m_Handlers[0].m_Latency.m_Sum >= 4'000'000);
+	}
+
+	TEST_CASE("message_stats_names", "[hecate::core]") {
+		FastStatsHandler fast;
+
+		hecate::attach_handler<StatsMsg>(&fast);
+		hecate::broadcast(StatsMsg{ 1 });
+		hecate::detach_handler<StatsMsg>(&fast);
+
+		// the metrics are named after the readable type names, not the mangled ones
+		bool found = false;
+
+		for (const auto& v : hecate::Metrics::instance().take_snapshot().m_Values)
+			if (v.m_Name.starts_with("messages.") && v.m_Name.find("StatsMsg") != std::string::npos) {
+				REQUIRE(v.m_Name.find("test::") != std::string::npos);
+				found = true;
+			}
+
+		REQUIRE(found);
+	}
+
+	TEST_CASE("message_stats_counting", "[hecate::core]") {
+		KeyedHandler first;
+		KeyedHandler second;
+
+		// the TopicIndex in between isn't counted, only the subscribers that are actually called
+		hecate::subscribe<&KeyedMsg::m_Key>(&first,  1);
+		hecate::subscribe<&KeyedMsg::m_Key>(&second, 1);
+
+		hecate::broadcast(KeyedMsg{ 1 });
+		hecate::broadcast(KeyedMsg{ 2 });
+
+		auto stats = find_stats("KeyedMsg");
+
+		REQUIRE(stats.m_Broadcasts   == 2);
+		REQUIRE(stats.m_HandlerCalls == 2);
+		REQUIRE(stats.m_Exceptions   == 0);
+
+		for (const auto& h : stats.m_Handlers)
+			REQUIRE(h.m_Handler.find("TopicIndex") == std::string::npos);
+
+		// an exception is counted once, and the handler after it isn't called
+		first.m_Throw = true;
+
+		REQUIRE_THROWS_AS(hecate::broadcast(KeyedMsg{ 1 }), std::runtime_error);
+
+		stats = find_stats("KeyedMsg");
+
+		REQUIRE(stats.m_HandlerCalls == 3);
+		REQUIRE(stats.m_Exceptions   == 1);
+		REQUIRE(second.m_Count       == 1);
+
+		hecate::unsubscribe<&KeyedMsg::m_Key>(&first,  1);
+		hecate::unsubscribe<&KeyedMsg::m_Key>(&second, 1);
+	}
+}
+
+#endif
@@ -0,0 +1,191 @@
+#include "../unittest.h"
+
+#include "core/metrics.h"
+#include "core/scheduler.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace test {
+	namespace {
+		const hecate::Metrics::Value* find_value(
+			const hecate::Metrics::Snapshot& snapshot,
+			const std::string&               name
+		) {
+			for (const auto& v : snapshot.m_Values)
+				if (v.m_Name == name)
+					return &v;
+
+			return nullptr;
+		}
+	}
+
+	TEST_CASE("metrics_counter_threads", "[hecate::core]") {
+		auto& m = hecate::Metrics::instance();
+
+		auto counter = m.get_counter("test.counter_threads");
+
+		{
+			hecate::Scheduler s(4);
+
+			s.parallel_for(0, 10000, [&](size_t) {
+				counter.add();
+			});
+		}
+
+		auto snapshot = m.take_snapshot(7, 1.5);
+
+		REQUIRE(snapshot.m_Frame == 7);
+		REQUIRE(snapshot.m_Time  == 1.5);
+
+		auto* v = find_value(snapshot, "test.counter_threads");
+
+		REQUIRE(v != nullptr);
+		REQUIRE(v->m_Type    == hecate::Metrics::e_Type::counter);
+		REQUIRE(v->m_Counter == 10000);
+
+		// registering again yields the same counter
+		m.get_counter("test.counter_threads").add(5);
+
+		REQUIRE(find_value(m.take_snapshot(), "test.counter_threads")->m_Counter == 10005);
+	}
+
+	TEST_CASE("metrics_thread_churn", "[hecate::core]") {
+		auto& m = hecate::Metrics::instance();
+
+		auto counter   = m.get_counter  ("test.thread_churn");
+		auto histogram = m.get_histogram("test.thread_churn_histogram");
+
+		// make sure this thread has a shard of its own already
+		counter.add(0);
+
+		const size_t num_shards = m.get_num_shards();
+
+		for (int i = 0; i < 50; ++i) {
+			std::thread t([&] {
+				counter.add(2);
+				histogram.record(100);
+			});
+
+			t.join();
+		}
+
+		// the shards of the threads that exited are reused, their counts are kept
+		REQUIRE(m.get_num_shards() == num_shards);
+
+		auto snapshot = m.take_snapshot();
+
+		REQUIRE(find_value(snapshot, "test.thread_churn")->m_Counter                     == 100);
+		REQUIRE(find_value(snapshot, "test.thread_churn_histogram")->m_Histogram.m_Count == 50);
+		REQUIRE(find_value(snapshot, "test.thread_churn_histogram")->m_Histogram.m_Sum   == 5000);
+	}
+
+	TEST_CASE("metrics_default_handles", "[hecate::core]") {
+		auto& m = hecate::Metrics::instance();
+
+		m.get_counter("test.default_handles");
+
+		auto before = m.take_snapshot();
+
+		// default-constructed handles record into scratch slots that are never reported
+		hecate::Metrics::Counter   counter;
+		hecate::Metrics::Histogram histogram;
+
+		counter.add(100);
+		histogram.record(12345);
+
+		auto after = m.take_snapshot();
+
+		for (const auto& v : after.m_Values) {
+			auto* previous = find_value(before, v.m_Name);
+
+			if (!previous || v.m_Name.starts_with("log."))
+				continue;
+
+			REQUIRE(v.m_Counter           == previous->m_Counter);
+			REQUIRE(v.m_Histogram.m_Count == previous->m_Histogram.m_Count);
+		}
+	}
+
+	TEST_CASE("metrics_gauge", "[hecate::core]") {
+		auto& m = hecate::Metrics::instance();
+
+		auto gauge = m.get_gauge("test.gauge");
+
+		gauge.set(3.0);
+		gauge.set(4.5);
+
+		auto  snapshot = m.take_snapshot();
+		auto* v        = find_value(snapshot, "test.gauge");
+
+		REQUIRE(v != nullptr);
+		REQUIRE(v->m_Gauge == 4.5);
+
+		REQUIRE_THROWS_AS(m.get_counter("test.gauge"), std::runtime_error);
+	}
+
+	TEST_CASE("metrics_histogram", "[hecate::core]") {
+		auto& m = hecate::Metrics::instance();
+
+		auto histogram = m.get_histogram("test.histogram");
+
+		// 98 small values, 2 large ones
+		for (int i = 0; i < 98; ++i)
+			histogram.record(10);
+
+		histogram.record(1000);
+		histogram.record(1000);
+
+		auto  snapshot = m.take_snapshot();
+		auto* v        = find_value(snapshot, "test.histogram");
+
+		REQUIRE(v != nullptr);
+
+		const auto& h = v->m_Histogram;
+
+		REQUIRE(h.m_Count == 100);
+		REQUIRE(h.m_Sum   == 98 * 10 + 2 * 1000);
+		REQUIRE(h.m_P50   == 15);   // [8, 16)
+		REQUIRE(h.m_P99   == 1023); // [512, 1024)
+		REQUIRE(h.m_Max   == 1023);
+	}
+
+	TEST_CASE("metrics_histogram_range", "[hecate::core]") {
+		auto& m = hecate::Metrics::instance();
+
+		auto histogram = m.get_histogram("test.histogram_range");
+
+		histogram.record(uint64_t(1) << 40);
+		histogram.record(~uint64_t(0));
+
+		auto  snapshot = m.take_snapshot();
+		auto* v        = find_value(snapshot, "test.histogram_range");
+
+		REQUIRE(v != nullptr);
+
+		const auto& h = v->m_Histogram;
+
+		// large values get their own buckets instead of being clamped into the top one
+		REQUIRE(h.m_Buckets[41] == 1);
+		REQUIRE(h.m_Buckets[64] == 1);
+		REQUIRE(h.m_P50         == (uint64_t(1) << 41) - 1);
+		REQUIRE(h.m_Max         == ~uint64_t(0));
+	}
+
+	TEST_CASE("metrics_json", "[hecate::core]") {
+		auto& m = hecate::Metrics::instance();
+
+		m.get_counter("test.json_counter").add(3);
+
+		std::stringstream sstr;
+		hecate::Metrics::write_json(sstr, m.take_snapshot(42, 0.0));
+
+		std::string line = sstr.str();
+
+		REQUIRE(line.find('\n') == std::string::npos);
+		REQUIRE(line.find("\"frame\":42")           != std::string::npos);
+		REQUIRE(line.find("\"test.json_counter\":3") != std::string::npos);
+	}
+}
@@ -0,0 +1,152 @@
+#include "../unittest.h"
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "core/mediator.h"
+#include "core/profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+	size_t count_occurrences(const std::string& haystack, const std::string& needle) {
+		size_t result = 0;
+
+		for (size_t pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + 1))
+			++result;
+
+		return result;
+	}
+
+	std::string get_trace() {
+		std::stringstream sstr;
+		hecate::Profiler::instance().write_chrome_trace(sstr);
+		return sstr.str();
+	}
+}
+
+namespace test {
+	struct ProfiledMsg {
+		int m_Value = 0;
+	};
+
+	TEST_CASE("profiler_zones", "[hecate::core]") {
+		using hecate::Profiler;
+
+		auto& p = Profiler::instance();
+		p.clear();
+
+		{
+			HECATE_PROFILE_SCOPE("test_outer");
+
+			for (int i = 0; i < 3; ++i) {
+				HECATE_PROFILE_SCOPE("test_inner");
+			}
+		}
+
+		std::thread t([&p] {
+			p.set_thread_name("test \"thread\"");
+
+			HECATE_PROFILE_SCOPE(p.intern("test_dynamic"));
+		});
+		t.join();
+
+		auto trace = get_trace();
+
+		REQUIRE(trace.starts_with("{"));
+		REQUIRE(count_occurrences(trace, "\"name\":\"test_outer\"")   == 1);
+		REQUIRE(count_occurrences(trace, "\"name\":\"test_inner\"")   == 3);
+		REQUIRE(count_occurrences(trace, "\"name\":\"test_dynamic\"") == 1);
+		REQUIRE(count_occurrences(trace, "test \\\"thread\\\"")       == 1); // escaped thread name metadata
+
+		REQUIRE(p.intern("test_dynamic") == p.intern(std::string("test_") + "dynamic"));
+
+		// disabled at runtime
+		p.clear();
+		p.set_enabled(false);
+
+		{
+			HECATE_PROFILE_SCOPE("test_disabled");
+		}
+
+		p.set_enabled(true);
+
+		REQUIRE(count_occurrences(get_trace(), "test_disabled") == 0);
+	}
+
+	TEST_CASE("profiler_ring_wraps", "[hecate::core]") {
+		using hecate::Profiler;
+
+		auto& p = Profiler::instance();
+		p.clear();
+
+		// only the most recent zones per thread are kept (the oldest slot may be mid-overwrite, so it is skipped)
+		std::thread t([&p] {
+			for (size_t i = 0; i < Profiler::k_EventsPerThread + 100; ++i)
+				p.record("test_wrap", Profiler::now(), Profiler::now());
+		});
+		t.join();
+
+		REQUIRE(count_occurrences(get_trace(), "\"name\":\"test_wrap\"") == Profiler::k_EventsPerThread - 1);
+
+		p.clear();
+	}
+
+	TEST_CASE("profiler_thread_buffers", "[hecate::core]") {
+		using hecate::Profiler;
+
+		auto& p = Profiler::instance();
+
+		auto run_thread = [] {
+			std::thread t([] {
+				HECATE_PROFILE_SCOPE("test_short_lived");
+			});
+			t.join();
+		};
+
+		run_thread();
+
+		// threads that exited hand their buffer to the next one
+		size_t num_buffers = p.get_num_buffers();
+
+		for (int i = 0; i < 8; ++i)
+			run_thread();
+
+		REQUIRE(p.get_num_buffers() == num_buffers);
+		REQUIRE(count_occurrences(get_trace(), "\"name\":\"test_short_lived\"") >= 1);
+
+		p.clear();
+	}
+
+	TEST_CASE("profiler_readable_names", "[hecate::core]") {
+		auto& p = hecate::Profiler::instance();
+		p.clear();
+
+		hecate::broadcast(ProfiledMsg{ 1 });
+
+		REQUIRE(count_occurrences(get_trace(), "\"name\":\"broadcast test::ProfiledMsg\"") == 1);
+
+		p.clear();
+	}
+
+	// [NOTE] hidden by default, run with `unittest [benchmark]`
+	TEST_CASE("profiler_zone_cost", "[.][benchmark][hecate::core]") {
+		using clock = std::chrono::steady_clock;
+
+		constexpr size_t k_NumZones = 10'000'000;
+
+		auto start = clock::now();
+
+		for (size_t i = 0; i < k_NumZones; ++i) {
+			HECATE_PROFILE_SCOPE("bench_zone");
+		}
+
+		std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+
+		std::printf("profiler zone cost: %.1f ns\n", elapsed.count() / static_cast<double>(k_NumZones));
+
+		hecate::Profiler::instance().clear();
+	}
+}
@@ -0,0 +1,205 @@
+#include "../unittest.h"
+
+#include "core/mediator.h"
+#include "core/message_recording.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace test {
+	struct RecordedTick {
+		int   m_Value;
+		void* m_Source; // not recorded
+	};
+
+	struct RecordedScroll {
+		float m_Amount;
+	};
+
+	struct UnreplayedNote {
+		int m_Value;
+	};
+}
+
+namespace hecate {
+	template <>
+	struct RecordedMessage<test::RecordedTick> {
+		static constexpr const char* k_Name = "test::RecordedTick";
+
+		static void save(RecordWriter& writer, const test::RecordedTick& message) {
+			writer.write(message.m_Value);
+		}
+
+		static test::RecordedTick load(RecordReader& reader) {
+			return { reader.read<int>(), nullptr };
+		}
+	};
+
+	template <>
+	struct RecordedMessage<test::RecordedScroll> {
+		static constexpr const char* k_Name = "test::RecordedScroll";
+
+		static void save(RecordWriter& writer, const test::RecordedScroll& message) {
+			writer.write(message.m_Amount);
+		}
+
+		static test::RecordedScroll load(RecordReader& reader) {
+			return { reader.read<float>() };
+		}
+	};
+
+	template <>
+	struct RecordedMessage<test::UnreplayedNote> {
+		static constexpr const char* k_Name = "test::UnreplayedNote";
+
+		static void save(RecordWriter& writer, const test::UnreplayedNote& message) {
+			writer.write(message.m_Value);
+		}
+
+		static test::UnreplayedNote load(RecordReader& reader) {
+			return { reader.read<int>() };
+		}
+	};
+}
+
+namespace test {
+	namespace {
+		struct Receiver {
+			void operator()(const RecordedTick& t) {
+				m_Log.push_back(t.m_Value);
+
+				if (t.m_Source)
+					++m_NumWithSource;
+			}
+
+			void operator()(const RecordedScroll& s) {
+				m_Log.push_back(static_cast<int>(s.m_Amount * 100));
+			}
+
+			std::vector<int> m_Log;
+			int              m_NumWithSource = 0;
+		};
+
+		std::string get_recording_path(const char* name) {
+			return (std::filesystem::temp_directory_path() / name).string();
+		}
+	}
+
+	TEST_CASE("recording_round_trip", "[hecate::core]") {
+		using namespace std::chrono_literals;
+
+		auto filename = get_recording_path("hecate_test_recording.hcr");
+		int  source   = 0;
+
+		{
+			hecate::MessageRecorder recorder;
+
+			recorder.record<RecordedTick>();
+			recorder.record<RecordedTick>(); // registering twice is harmless
+			recorder.record<UnreplayedNote>();
+
+			hecate::broadcast(RecordedTick{ 1, &source }); // not recording yet
+
+			REQUIRE(recorder.start(filename));
+			REQUIRE(recorder.is_recording());
+
+			hecate::broadcast(RecordedTick{ 2, &source });
+			std::this_thread::sleep_for(5ms);
+
+			recorder.record<RecordedScroll>(); // added while recording
+			hecate::broadcast(RecordedScroll{ 0.5f });
+			hecate::broadcast(UnreplayedNote{ 7 });
+			std::this_thread::sleep_for(5ms);
+
+			hecate::broadcast(RecordedTick{ 3, &source });
+
+			recorder.stop();
+
+			hecate::broadcast(RecordedTick{ 4, &source }); // not recording anymore
+
+			REQUIRE(recorder.get_num_messages() == 4);
+		}
+
+		// the recorder is detached again
+		REQUIRE(hecate::core::detail::MediatorQueue<RecordedTick>::instance().get_num_handlers() == 0);
+
+		Receiver r;
+
+		hecate::attach_handler<RecordedTick>  (&r);
+		hecate::attach_handler<RecordedScroll>(&r);
+
+		hecate::MessageReplayer replayer;
+
+		replayer.replay<RecordedTick>();
+		replayer.replay<RecordedScroll>();
+
+		REQUIRE(replayer.open(filename));
+		REQUIRE(replayer.get_num_messages() == 3);
+		REQUIRE(replayer.get_num_skipped()  == 1);
+		REQUIRE(replayer.get_duration()     >= 10ms);
+
+		// original timing
+		REQUIRE(replayer.advance(4ms) == 1);
+		REQUIRE(r.m_Log == std::vector<int>{ 2 });
+
+		REQUIRE(replayer.advance(replayer.get_duration() - 1ns) == 1);
+		REQUIRE(r.m_Log == std::vector<int>{ 2, 50 });
+		REQUIRE_FALSE(replayer.is_finished());
+
+		REQUIRE(replayer.advance(replayer.get_duration()) == 1);
+		REQUIRE(r.m_Log == std::vector<int>{ 2, 50, 3 });
+		REQUIRE(replayer.is_finished());
+
+		// as fast as possible
+		replayer.rewind();
+
+		REQUIRE(replayer.replay_all() == 3);
+		REQUIRE(r.m_Log == std::vector<int>{ 2, 50, 3, 2, 50, 3 });
+
+		// pointers are not part of the recording
+		REQUIRE(r.m_NumWithSource == 0);
+
+		hecate::detach_handler<RecordedTick>  (&r);
+		hecate::detach_handler<RecordedScroll>(&r);
+
+		std::filesystem::remove(filename);
+	}
+
+	TEST_CASE("recording_invalid_files", "[hecate::core]") {
+		hecate::MessageReplayer replayer;
+
+		replayer.replay<RecordedTick>();
+
+		REQUIRE_FALSE(replayer.open(get_recording_path("hecate_test_missing.hcr")));
+
+		auto filename = get_recording_path("hecate_test_invalid.hcr");
+
+		{
+			std::ofstream out(filename, std::ios::binary);
+			out << "definitely not a recording";
+		}
+
+		REQUIRE_FALSE(replayer.open(filename));
+
+		// a recording that was cut off halfway through a message keeps the complete ones
+		{
+			hecate::MessageRecorder recorder;
+
+			recorder.record<RecordedTick>();
+			recorder.start(filename);
+
+			hecate::broadcast(RecordedTick{ 1, nullptr });
+			hecate::broadcast(RecordedTick{ 2, nullptr });
+		}
+
+		std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 1);
+
+		REQUIRE(replayer.open(filename));
+		REQUIRE(replayer.get_num_messages() == 1);
+
+		std::filesystem::remove(filename);
+	}
+}
@@ -0,0 +1,151 @@
+#include "../unittest.h"
+
+#include "core/logger/rotating_log_file.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+namespace test {
+	namespace {
+		std::string read_file(const std::filesystem::path& p) {
+			std::ifstream in(p, std::ios::binary);
+
+			return std::string(
+				std::istreambuf_iterator<char>(in),
+				std::istreambuf_iterator<char>()
+			);
+		}
+	}
+
+	TEST_CASE("rotating_log_file", "[hecate::core]") {
+		using namespace hecate::core::logger;
+		namespace fs = std::filesystem;
+
+		auto directory = fs::temp_directory_path() / "hecate_test_rotating_log";
+
+		fs::remove_all(directory);
+		fs::create_directories(directory);
+
+		RotatingLogFile::Config config;
+
+		config.m_Path        = directory / "test.log";
+		config.m_ChunkSize   = 4096;
+		config.m_MaxFileSize = 10000;
+		config.m_MaxFiles    = 2;
+
+		auto now  = std::chrono::system_clock::now();
+		auto info = LogMessage::MetaInfo{ e_LogCategory::info, __FILE__, 42, now };
+
+		REQUIRE(RotatingLogFile::get_rotated_path(config.m_Path, 3) == directory / "test.3.log");
+
+		SECTION("size") {
+			std::string message(80, 'x');
+			std::string line;
+
+			format_line(line, info, message);
+
+			size_t lines_per_file = config.m_MaxFileSize / line.size();
+
+			{
+				RotatingLogFile file(config);
+
+				for (size_t i = 0; i < lines_per_file * 4 + 1; ++i)
+					file.write(info, message);
+
+				REQUIRE(file.get_num_rotations() == 4);
+				REQUIRE(file.get_size()          == line.size());
+			}
+
+			// only the active file and the 2 most recent ones are kept, each truncated to what was written
+			REQUIRE(fs::file_size(config.m_Path) == line.size());
+			REQUIRE(fs::file_size(directory / "test.1.log") == lines_per_file * line.size());
+			REQUIRE(fs::file_size(directory / "test.2.log") == lines_per_file * line.size());
+			REQUIRE(!fs::exists(directory / "test.3.log"));
+		}
+
+		SECTION("age") {
+			config.m_MaxFileAge = std::chrono::hours(1);
+
+			RotatingLogFile file(config);
+
+			file.write(info, "first");
+
+			info.m_Time += std::chrono::minutes(30);
+			file.write(info, "second");
+
+			REQUIRE(file.get_num_rotations() == 0);
+
+			info.m_Time += std::chrono::minutes(31);
+			file.write(info, "third");
+
+			REQUIRE(file.get_num_rotations() == 1);
+			REQUIRE(read_file(directory / "test.1.log").find("second") != std::string::npos);
+		}
+
+		SECTION("resume") {
+			// as left behind by a crash: the written lines, followed by the rest of the pre-allocated chunk
+			{
+				std::ofstream out(config.m_Path, std::ios::binary);
+
+				out << "before the crash\n";
+				out << std::string(1000, '\0');
+			}
+
+			{
+				RotatingLogFile file(config);
+
+				REQUIRE(file.get_size() == 17);
+
+				file.write(info, "after the crash");
+				file.flush();
+			}
+
+			std::string text = read_file(config.m_Path);
+
+			REQUIRE(text.starts_with("before the crash\n"));
+			REQUIRE(text.find("after the crash") != std::string::npos);
+			REQUIRE(text.find('\0') == std::string::npos);
+		}
+
+		SECTION("resume_age") {
+			{
+				std::ofstream out(config.m_Path, std::ios::binary);
+				out << "previous run\n";
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+
+			// the file was created over a second ago, reopening it doesn't reset that
+			config.m_MaxFileAge = std::chrono::seconds(1);
+
+			RotatingLogFile file(config);
+
+			info.m_Time = std::chrono::system_clock::now();
+			file.write(info, "this run");
+
+			REQUIRE(file.get_num_rotations() == 1);
+			REQUIRE(read_file(directory / "test.1.log") == "previous run\n");
+		}
+
+		SECTION("configure") {
+			RotatingLogFile file(config);
+
+			file.write(info, "first");
+
+			auto changed = file.get_config();
+			changed.m_MaxFileSize = 1;
+			file.configure(changed);
+
+			file.write(info, "second");
+
+			REQUIRE(file.get_num_rotations() == 1);
+			REQUIRE(file.get_config().m_MaxFileSize == 1);
+		}
+
+		fs::remove_all(directory);
+	}
+}
@@ -0,0 +1,127 @@
+#include "../unittest.h"
+
+#include "core/scheduler.h"
+
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+namespace {
+	int fibonacci(hecate::Scheduler& s, int n) {
+		if (n < 12) {
+			// small enough to just do it serially
+			int a = 0;
+			int b = 1;
+
+			for (int i = 0; i < n; ++i) {
+				int c = a + b;
+				a = b;
+				b = c;
+			}
+
+			return a;
+		}
+
+		int x = 0;
+		int y = 0;
+
+		hecate::Scheduler::TaskGroup group(s);
+
+		group.run([&] { x = fibonacci(s, n - 1); });
+		y = fibonacci(s, n - 2);
+		group.wait();
+
+		return x + y;
+	}
+}
+
+namespace test {
+	TEST_CASE("scheduler_task_group", "[hecate::core]") {
+		hecate::Scheduler s(4);
+		hecate::Scheduler::TaskGroup group(s);
+
+		std::atomic<int> counter = 0;
+
+		for (int i = 0; i < 1000; ++i)
+			group.run([&counter] { ++counter; });
+
+		group.wait();
+
+		REQUIRE(counter == 1000);
+		REQUIRE(group.is_done());
+	}
+
+	TEST_CASE("scheduler_parallel_for", "[hecate::core]") {
+		hecate::Scheduler s(4);
+
+		std::vector<int> data(100'000, 0);
+
+		s.parallel_for(0, data.size(), [&data](size_t i) {
+			data[i] = static_cast<int>(i % 7);
+		});
+
+		int expected = 0;
+		for (size_t i = 0; i < data.size(); ++i)
+			expected += static_cast<int>(i % 7);
+
+		REQUIRE(std::accumulate(data.begin(), data.end(), 0) == expected);
+	}
+
+	TEST_CASE("scheduler_nested_fork_join", "[hecate::core]") {
+		hecate::Scheduler s(4);
+
+		int result = 0;
+
+		hecate::Scheduler::TaskGroup group(s);
+		group.run([&] { result = fibonacci(s, 25); });
+		group.wait();
+
+		REQUIRE(result == 75025);
+	}
+
+	TEST_CASE("scheduler_continuation", "[hecate::core]") {
+		hecate::Scheduler s(2);
+
+		std::atomic<int>  counter        = 0;
+		std::atomic<int>  seen_by_then   = -1;
+		std::atomic<bool> continuation_done = false;
+
+		{
+			hecate::Scheduler::TaskGroup group(s);
+
+			for (int i = 0; i < 100; ++i)
+				group.run([&counter] { ++counter; });
+
+			group.then([&] {
+				seen_by_then      = counter.load();
+				continuation_done = true;
+			});
+
+			group.wait();
+		}
+
+		while (!continuation_done)
+			s.try_execute_one();
+
+		REQUIRE(seen_by_then == 100);
+	}
+
+	TEST_CASE("scheduler_stats", "[hecate::core]") {
+		hecate::Scheduler s(2);
+
+		{
+			hecate::Scheduler::TaskGroup group(s);
+
+			for (int i = 0; i < 64; ++i)
+				group.run([] {});
+		}
+
+		auto stats = s.get_stats();
+
+		REQUIRE(stats.m_Workers.size() == 2);
+		REQUIRE(stats.get_total_executed() == 64);
+
+		s.reset_stats();
+		REQUIRE(s.get_stats().get_total_executed() == 0);
+	}
+}
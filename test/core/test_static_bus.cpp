@@ -0,0 +1,117 @@
+#include "../unittest.h"
+
+#include "core/static_bus.h"
+
+#include <stdexcept>
+
+namespace test {
+	namespace {
+		struct Tick   { int m_Value = 0; };
+		struct Resize { int m_Width = 0; };
+
+		struct Game {
+			void operator()(const Tick& t)   { m_Ticks += t.m_Value; }
+			void operator()(const Resize& r) { m_Width  = r.m_Width; }
+
+			int m_Ticks = 0;
+			int m_Width = 0;
+		};
+
+		struct Overlay {
+			void operator()(const Tick&) { ++m_Ticks; }
+
+			int m_Ticks = 0;
+		};
+
+		struct DynamicTick {
+			void operator()(const Tick&) { ++m_Ticks; }
+
+			int m_Ticks = 0;
+		};
+
+		using TestBus  = hecate::StaticBus<hecate::MessageList<Tick, Resize>, Game, Overlay>;
+		using OtherBus = hecate::StaticBus<hecate::MessageList<Tick>, Overlay>;
+		using LateBus  = hecate::StaticBus<hecate::MessageList<Resize, Tick>, Game>; // Tick conflicts with OtherBus
+	}
+
+	TEST_CASE("static_bus_dispatch", "[hecate::core]") {
+		Game        game;
+		Overlay     overlay;
+		DynamicTick dynamic;
+
+		// nothing is bound yet
+		hecate::broadcast(Tick{ 1 });
+		REQUIRE(game.m_Ticks == 0);
+
+		TestBus::bind(&game);
+		TestBus::bind(&overlay);
+		hecate::attach_handler<Tick>(&dynamic);
+
+		hecate::broadcast(Tick{ 2 });
+		hecate::broadcast(Resize{ 640 });
+
+		REQUIRE(game.m_Ticks    == 2);
+		REQUIRE(game.m_Width    == 640);
+		REQUIRE(overlay.m_Ticks == 1);
+		REQUIRE(dynamic.m_Ticks == 1); // runtime attachments still work
+
+		// posted messages are routed as well
+		hecate::post(Tick{ 3 });
+		hecate::dispatch_posted_messages();
+
+		REQUIRE(game.m_Ticks    == 5);
+		REQUIRE(overlay.m_Ticks == 2);
+		REQUIRE(dynamic.m_Ticks == 2);
+
+		// only one bus can route a message type, and only one receiver per type
+		Game second;
+		REQUIRE_THROWS_AS(TestBus::bind(&second),   std::logic_error);
+		REQUIRE_THROWS_AS(OtherBus::bind(&overlay), std::logic_error);
+
+		TestBus::unbind(&overlay);
+
+		hecate::broadcast(Tick{ 1 });
+		REQUIRE(game.m_Ticks    == 6);
+		REQUIRE(overlay.m_Ticks == 2);
+
+		TestBus::unbind(&game);
+		hecate::detach_handler<Tick>(&dynamic);
+
+		hecate::broadcast(Tick{ 1 });
+		REQUIRE(game.m_Ticks == 6);
+
+		// with the first bus unbound, the other one can take over
+		OtherBus::bind(&overlay);
+		hecate::broadcast(Tick{ 1 });
+		REQUIRE(overlay.m_Ticks == 3);
+		OtherBus::unbind(&overlay);
+	}
+
+	TEST_CASE("static_bus_partial_bind", "[hecate::core]") {
+		Game    game;
+		Overlay overlay;
+
+		OtherBus::bind(&overlay);
+
+		// Resize would be routed before Tick turns out to be taken; binding is all or nothing
+		REQUIRE_THROWS_AS(LateBus::bind(&game), std::logic_error);
+
+		hecate::broadcast(Resize{ 640 });
+		REQUIRE(game.m_Width == 0);
+
+		OtherBus::unbind(&overlay);
+
+		// without dynamic handlers, a routed broadcast doesn't go through the queue
+		LateBus::bind(&game);
+
+		REQUIRE(!hecate::core::detail::MediatorQueue<Tick>::has_handlers());
+
+		hecate::broadcast(Tick{ 1 });
+		hecate::broadcast(Resize{ 640 });
+
+		REQUIRE(game.m_Ticks == 1);
+		REQUIRE(game.m_Width == 640);
+
+		LateBus::unbind(&game);
+	}
+}
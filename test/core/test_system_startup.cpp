@@ -0,0 +1,205 @@
+#include "../unittest.h"
+
+#include "core/scheduler.h"
+#include "core/system.h"
+#include "core/system_startup.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+	struct Recorder {
+		std::mutex               m_Mutex;
+		std::vector<std::string> m_Started;
+		std::vector<std::string> m_Stopped;
+		std::atomic<int>         m_NumInitializing = 0;
+	};
+
+	class TestSystem:
+		public hecate::System
+	{
+	public:
+		TestSystem(const std::string& name, Recorder* rec):
+			System(name),
+			m_Recorder(rec)
+		{
+		}
+
+		bool init() override {
+			m_InitOn = std::this_thread::get_id();
+
+			if (m_WaitForOthers > 0) {
+				// wait (for a bit) until the others are initializing at the same time
+				++m_Recorder->m_NumInitializing;
+
+				auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+				while (
+					(m_Recorder->m_NumInitializing < m_WaitForOthers) &&
+					(std::chrono::steady_clock::now() < deadline)
+				)
+					std::this_thread::yield();
+
+				m_SawOthers = (m_Recorder->m_NumInitializing >= m_WaitForOthers);
+			}
+
+			if (m_Throw)
+				throw std::runtime_error("init failed");
+
+			if (m_Fail)
+				return false;
+
+			std::lock_guard guard(m_Recorder->m_Mutex);
+			m_Recorder->m_Started.push_back(get_name());
+
+			return true;
+		}
+
+		void shutdown() override {
+			std::lock_guard guard(m_Recorder->m_Mutex);
+			m_Recorder->m_Stopped.push_back(get_name());
+		}
+
+		using System::add_dependency;
+		using System::require_main_thread;
+
+		Recorder*       m_Recorder      = nullptr;
+		bool            m_Fail          = false;
+		bool            m_Throw         = false;
+		int             m_WaitForOthers = 0;
+		bool            m_SawOthers     = false;
+		std::thread::id m_InitOn;
+	};
+
+	size_t index_of(
+		const std::vector<std::string>& v,
+		const std::string&              name
+	) {
+		for (size_t i = 0; i < v.size(); ++i)
+			if (v[i] == name)
+				return i;
+
+		return v.size();
+	}
+}
+
+namespace test {
+	TEST_CASE("system_startup_order", "[hecate::core]") {
+		hecate::Scheduler     s(2);
+		hecate::SystemStartup startup;
+		Recorder              rec;
+
+		// diamond: A -> (B, C) -> D
+		TestSystem a("A", &rec);
+		TestSystem b("B", &rec);
+		TestSystem c("C", &rec);
+		TestSystem d("D", &rec);
+
+		b.add_dependency("A");
+		c.add_dependency("A");
+		d.add_dependency("B");
+		d.add_dependency("C");
+
+		startup.run({ &d, &c, &b, &a }, s);
+
+		REQUIRE(rec.m_Started.size() == 4);
+		REQUIRE(rec.m_Started.front() == "A");
+		REQUIRE(rec.m_Started.back()  == "D");
+		REQUIRE(rec.m_Stopped.empty());
+
+		const auto& order = startup.get_init_order();
+
+		REQUIRE(order.size() == 4);
+		REQUIRE(order.front() == &a);
+		REQUIRE(order.back()  == &d);
+	}
+
+	TEST_CASE("system_startup_parallel", "[hecate::core]") {
+		hecate::Scheduler     s(2);
+		hecate::SystemStartup startup;
+		Recorder              rec;
+
+		// B and C only depend on A, so they can be initialized at the same time
+		TestSystem a("A", &rec);
+		TestSystem b("B", &rec);
+		TestSystem c("C", &rec);
+		TestSystem m("Main", &rec);
+
+		b.add_dependency("A");
+		c.add_dependency("A");
+		m.add_dependency("A");
+		m.require_main_thread();
+
+		b.m_WaitForOthers = 2;
+		c.m_WaitForOthers = 2;
+
+		startup.run({ &a, &b, &c, &m }, s);
+
+		REQUIRE(rec.m_Started.size() == 4);
+		REQUIRE(b.m_SawOthers);
+		REQUIRE(c.m_SawOthers);
+		REQUIRE(m.m_InitOn == std::this_thread::get_id());
+
+		for (const auto& name : { "B", "C", "Main" })
+			REQUIRE(index_of(rec.m_Started, "A") < index_of(rec.m_Started, name));
+	}
+
+	TEST_CASE("system_startup_failure", "[hecate::core]") {
+		hecate::Scheduler     s(2);
+		hecate::SystemStartup startup;
+		Recorder              rec;
+
+		// A -> B -> C (fails) -> D
+		TestSystem a("A", &rec);
+		TestSystem b("B", &rec);
+		TestSystem c("C", &rec);
+		TestSystem d("D", &rec);
+
+		b.add_dependency("A");
+		c.add_dependency("B");
+		d.add_dependency("C");
+
+		SECTION("returns false") {
+			c.m_Fail = true;
+		}
+
+		SECTION("throws") {
+			c.m_Throw = true;
+		}
+
+		REQUIRE_THROWS(startup.run({ &a, &b, &c, &d }, s));
+
+		// whatever did start is shut down again, in reverse order
+		REQUIRE(rec.m_Started == std::vector<std::string>{ "A", "B" });
+		REQUIRE(rec.m_Stopped == std::vector<std::string>{ "B", "A" });
+		REQUIRE(startup.get_init_order().empty());
+	}
+
+	TEST_CASE("system_startup_invalid", "[hecate::core]") {
+		hecate::Scheduler     s(2);
+		hecate::SystemStartup startup;
+		Recorder              rec;
+
+		TestSystem a("A", &rec);
+		TestSystem b("B", &rec);
+
+		SECTION("missing dependency") {
+			b.add_dependency("C");
+		}
+
+		SECTION("cycle") {
+			a.add_dependency("B");
+			b.add_dependency("A");
+		}
+
+		// nothing is started when the dependencies are broken
+		REQUIRE_THROWS(startup.run({ &a, &b }, s));
+		REQUIRE(rec.m_Started.empty());
+		REQUIRE(rec.m_Stopped.empty());
+	}
+}
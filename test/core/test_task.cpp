@@ -0,0 +1,153 @@
+#include "../unittest.h"
+
+#include "core/scheduler.h"
+#include "core/task.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+	hecate::Task<int> make_value(int x) {
+		co_return x * 2;
+	}
+
+	hecate::Task<int> add_values(int a, int b) {
+		int x = co_await make_value(a);
+		int y = co_await make_value(b);
+
+		co_return x + y;
+	}
+
+	hecate::Task<> throw_something() {
+		throw std::runtime_error("oops");
+		co_return;
+	}
+
+	hecate::Task<bool> catch_something() {
+		try {
+			co_await throw_something();
+		}
+		catch (const std::runtime_error&) {
+			co_return true;
+		}
+
+		co_return false;
+	}
+
+	// main thread -> worker -> queue (main thread)
+	hecate::Task<int> hop(
+		hecate::Scheduler&   s,
+		hecate::ResumeQueue& q,
+		std::thread::id      main_id,
+		std::atomic<int>&    steps
+	) {
+		co_await hecate::resume_on(s);
+
+		if (std::this_thread::get_id() != main_id)
+			++steps;
+
+		co_await hecate::resume_on(q);
+
+		if (std::this_thread::get_id() == main_id)
+			++steps;
+
+		co_return 42;
+	}
+
+	hecate::Task<int> wait_for(hecate::Completion<int>& c) {
+		int x = co_await c;
+		co_return x + 1;
+	}
+
+	hecate::Task<> busy_work(hecate::Scheduler& s, std::atomic<int>& counter) {
+		co_await hecate::resume_on(s);
+
+		counter.fetch_add(1);
+	}
+
+	hecate::Task<int> gather(hecate::Scheduler& s, std::atomic<int>& counter) {
+		std::vector<hecate::Task<>> tasks;
+
+		for (int i = 0; i < 16; ++i)
+			tasks.push_back(busy_work(s, counter));
+
+		co_await hecate::when_all(tasks);
+
+		co_return counter.load();
+	}
+}
+
+namespace test {
+	TEST_CASE("task_basics", "[hecate::core]") {
+		auto t = add_values(1, 2);
+		REQUIRE(!t.is_ready()); // lazy
+
+		t.start();
+		REQUIRE(t.is_ready());
+		REQUIRE(t.get() == 6);
+
+		auto c = catch_something();
+		c.start();
+		REQUIRE(c.get());
+
+		auto e = throw_something();
+		e.start();
+		REQUIRE(e.is_ready());
+		REQUIRE_THROWS_AS(e.get(), std::runtime_error);
+	}
+
+	TEST_CASE("task_resume_on", "[hecate::core]") {
+		hecate::Scheduler   s(2);
+		hecate::ResumeQueue q;
+		std::atomic<int>    steps = 0;
+
+		auto t = hop(s, q, std::this_thread::get_id(), steps);
+		t.start();
+
+		// 'frame loop'
+		while (!t.is_ready()) {
+			q.resume_all();
+			std::this_thread::yield();
+		}
+
+		REQUIRE(t.get() == 42);
+		REQUIRE(steps == 2);
+	}
+
+	TEST_CASE("task_completion", "[hecate::core]") {
+		hecate::Completion<int> c;
+
+		auto t = wait_for(c);
+		t.start();
+		REQUIRE(!t.is_ready());
+
+		std::thread io([&c] { c.set_value(10); });
+		io.join();
+
+		REQUIRE(t.is_ready());
+		REQUIRE(t.get() == 11);
+
+		// already completed before being awaited
+		hecate::Completion<int> d;
+		d.set_value(1);
+
+		auto u = wait_for(d);
+		u.start();
+		REQUIRE(u.get() == 2);
+	}
+
+	TEST_CASE("task_when_all", "[hecate::core]") {
+		hecate::Scheduler s;
+		std::atomic<int>  counter = 0;
+
+		auto t = gather(s, counter);
+		t.start();
+
+		while (!t.is_ready())
+			std::this_thread::yield();
+
+		REQUIRE(t.get() == 16);
+	}
+}
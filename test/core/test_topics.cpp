@@ -0,0 +1,119 @@
+#include "../unittest.h"
+
+#include "core/mediator.h"
+
+#include <vector>
+
+namespace test {
+	namespace {
+		enum class e_Channel {
+			audio,
+			video,
+			input
+		};
+
+		struct Packet {
+			e_Channel m_Channel;
+			int       m_Size;
+			void*     m_Source;
+		};
+
+		void* get_source(const Packet& p) {
+			return p.m_Source;
+		}
+
+		constexpr auto is_large = [](const Packet& p) {
+			return p.m_Size > 100;
+		};
+
+		struct Receiver {
+			void operator()(const Packet& p) {
+				m_Sizes.push_back(p.m_Size);
+			}
+
+			std::vector<int> m_Sizes;
+		};
+	}
+
+	TEST_CASE("mediator_topics", "[hecate::core]") {
+		Receiver audio;
+		Receiver video;
+		Receiver from_a;
+		Receiver large;
+		Receiver everything;
+
+		int source_a = 0;
+		int source_b = 0;
+
+		hecate::subscribe<&Packet::m_Channel>(&audio, e_Channel::audio);
+		hecate::subscribe<&Packet::m_Channel>(&video, e_Channel::video);
+		hecate::subscribe<&get_source>       (&from_a, &source_a);
+		hecate::subscribe<is_large>          (&large, true);
+		hecate::attach_handler<Packet>       (&everything);
+
+		hecate::broadcast(Packet{ e_Channel::audio, 1,   &source_a });
+		hecate::broadcast(Packet{ e_Channel::video, 200, &source_b });
+		hecate::broadcast(Packet{ e_Channel::input, 3,   &source_b });
+
+		REQUIRE(audio.m_Sizes      == std::vector<int>{ 1 });
+		REQUIRE(video.m_Sizes      == std::vector<int>{ 200 });
+		REQUIRE(from_a.m_Sizes     == std::vector<int>{ 1 });
+		REQUIRE(large.m_Sizes      == std::vector<int>{ 200 });
+		REQUIRE(everything.m_Sizes == std::vector<int>{ 1, 200, 3 });
+
+		// multiple handlers per key
+		Receiver audio2;
+		hecate::subscribe<&Packet::m_Channel>(&audio2, e_Channel::audio);
+
+		hecate::broadcast(Packet{ e_Channel::audio, 4, nullptr });
+
+		REQUIRE(audio.m_Sizes  == std::vector<int>{ 1, 4 });
+		REQUIRE(audio2.m_Sizes == std::vector<int>{ 4 });
+
+		hecate::unsubscribe<&Packet::m_Channel>(&audio, e_Channel::audio);
+
+		hecate::broadcast(Packet{ e_Channel::audio, 5, nullptr });
+
+		REQUIRE(audio.m_Sizes  == std::vector<int>{ 1, 4 });
+		REQUIRE(audio2.m_Sizes == std::vector<int>{ 4, 5 });
+
+		hecate::unsubscribe<&Packet::m_Channel>(&audio2, e_Channel::audio);
+		hecate::unsubscribe<&Packet::m_Channel>(&video,  e_Channel::video);
+		hecate::unsubscribe<&get_source>       (&from_a, &source_a);
+		hecate::unsubscribe<is_large>          (&large,  true);
+		hecate::detach_handler<Packet>         (&everything);
+
+		REQUIRE(hecate::core::detail::TopicIndex<&Packet::m_Channel>::instance().get_num_subscriptions() == 0);
+		REQUIRE(hecate::core::detail::MediatorQueue<Packet>::instance().get_num_handlers() == 0);
+	}
+
+	TEST_CASE("mediator_topics_detach_all", "[hecate::core]") {
+		using Index = hecate::core::detail::TopicIndex<&Packet::m_Channel>;
+
+		Receiver audio;
+		Receiver video;
+
+		hecate::subscribe<&Packet::m_Channel>(&audio, e_Channel::audio);
+		hecate::subscribe<&Packet::m_Channel>(&video, e_Channel::video);
+
+		hecate::detach_all_handlers<Packet>();
+
+		REQUIRE(Index::instance().get_num_subscriptions() == 0);
+
+		hecate::broadcast(Packet{ e_Channel::audio, 1, nullptr });
+
+		REQUIRE(audio.m_Sizes.empty());
+
+		// the index is attached again with the next subscription
+		hecate::subscribe<&Packet::m_Channel>(&audio, e_Channel::audio);
+		hecate::broadcast(Packet{ e_Channel::audio, 2, nullptr });
+		hecate::broadcast(Packet{ e_Channel::video, 3, nullptr });
+
+		REQUIRE(audio.m_Sizes == std::vector<int>{ 2 });
+		REQUIRE(video.m_Sizes.empty());
+
+		hecate::unsubscribe<&Packet::m_Channel>(&audio, e_Channel::audio);
+
+		REQUIRE(hecate::core::detail::MediatorQueue<Packet>::instance().get_num_handlers() == 0);
+	}
+}
@@ -0,0 +1,71 @@
+#include "../unittest.h"
+
+#include "util/linear_allocator.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace test {
+	TEST_CASE("linear_allocator_basics", "[hecate::util]") {
+		using hecate::util::LinearAllocator;
+
+		LinearAllocator la(1024);
+
+		auto* a = la.create<int>(5);
+		auto* b = la.create<double>(2.5);
+
+		REQUIRE(*a == 5);
+		REQUIRE(*b == 2.5);
+		REQUIRE(reinterpret_cast<uintptr_t>(b) % alignof(double) == 0);
+
+		struct alignas(64) Aligned { char m_Data[64]; };
+
+		auto* c = la.create<Aligned>();
+		REQUIRE(reinterpret_cast<uintptr_t>(c) % 64 == 0);
+
+		auto arr = la.create_array<uint32_t>(10);
+		REQUIRE(arr.size() == 10);
+		REQUIRE(arr[9] == 0);
+
+		REQUIRE(la.get_num_chunks() == 1);
+		REQUIRE(la.get_bytes_allocated() == sizeof(int) + sizeof(double) + sizeof(Aligned) + 10 * sizeof(uint32_t));
+	}
+
+	TEST_CASE("linear_allocator_growth", "[hecate::util]") {
+		using hecate::util::LinearAllocator;
+
+		LinearAllocator la(256);
+
+		// larger than the initial chunk
+		auto big = la.create_array<std::byte>(1000);
+		REQUIRE(big.size() == 1000);
+		REQUIRE(la.get_num_chunks() == 2);
+
+		size_t capacity = la.get_capacity();
+
+		// after a reset everything fits in a single chunk
+		la.reset();
+		REQUIRE(la.get_num_chunks()      == 1);
+		REQUIRE(la.get_capacity()        == capacity);
+		REQUIRE(la.get_bytes_allocated() == 0);
+
+		la.create_array<std::byte>(1000);
+		REQUIRE(la.get_num_chunks() == 1);
+	}
+
+	TEST_CASE("linear_allocator_pmr", "[hecate::util]") {
+		using hecate::util::LinearAllocator;
+
+		LinearAllocator la(64);
+
+		std::pmr::vector<int> v(&la);
+
+		for (int i = 0; i < 1000; ++i)
+			v.push_back(i);
+
+		REQUIRE(v.size() == 1000);
+		REQUIRE(v[999]   == 999);
+		REQUIRE(la.get_bytes_allocated() >= 1000 * sizeof(int));
+	}
+}